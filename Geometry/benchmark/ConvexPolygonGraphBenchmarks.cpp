@@ -0,0 +1,45 @@
+/**
+ * Copyright 2019 Márton Gergó
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <benchmark/benchmark.h>
+#include <memory>
+#include "ConvexPolygonGraph.h"
+#include "MeshGenerator.h"
+
+using namespace TpaStarCpp::GeometryLibrary;
+
+// the argument is the side of the generated mesh, the counters compare the number of nodes a search has to expand
+static void BM_MergeConvexPolygons(benchmark::State& state)
+{
+    auto graph = std::make_shared<TriangleGraph>(MeshGenerator(1).randomDelaunay(state.range(0), state.range(0)));
+    for (auto _ : state) {
+        ConvexPolygonGraph polygons(graph);
+        state.counters["triangles"] = graph->triangleCount();
+        state.counters["polygons"] = polygons.polygonCount();
+    }
+}
+BENCHMARK(BM_MergeConvexPolygons)->Arg(70)->Arg(224)->Arg(707)->Unit(benchmark::kMillisecond);
+
+static void BM_MergeConvexPolygonsOfMaze(benchmark::State& state)
+{
+    auto graph = std::make_shared<TriangleGraph>(MeshGenerator(1).corridorMaze(state.range(0) / 2, state.range(0) / 2));
+    for (auto _ : state) {
+        ConvexPolygonGraph polygons(graph);
+        state.counters["triangles"] = graph->triangleCount();
+        state.counters["polygons"] = polygons.polygonCount();
+    }
+}
+BENCHMARK(BM_MergeConvexPolygonsOfMaze)->Arg(70)->Arg(224)->Arg(707)->Unit(benchmark::kMillisecond);
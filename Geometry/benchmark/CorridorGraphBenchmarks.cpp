@@ -0,0 +1,35 @@
+/**
+ * Copyright 2019 Márton Gergó
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <benchmark/benchmark.h>
+#include <memory>
+#include "CorridorGraph.h"
+#include "MeshGenerator.h"
+
+using namespace TpaStarCpp::GeometryLibrary;
+
+// the counters compare the number of triangles to the junctions and corridors a search would step through
+static void BM_ContractCorridors(benchmark::State& state)
+{
+    auto graph = std::make_shared<TriangleGraph>(MeshGenerator(1).gridWithHoles(state.range(0), state.range(0), 0.3));
+    for (auto _ : state) {
+        CorridorGraph corridors(graph);
+        state.counters["triangles"] = graph->triangleCount();
+        state.counters["junctions"] = corridors.junctionIds().size();
+        state.counters["corridors"] = corridors.corridorCount();
+    }
+}
+BENCHMARK(BM_ContractCorridors)->Arg(70)->Arg(224)->Arg(707)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,48 @@
+/**
+ * Copyright 2019 Márton Gergó
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <benchmark/benchmark.h>
+#include "MeshGenerator.h"
+
+using namespace TpaStarCpp::GeometryLibrary;
+
+// the argument is the side of the grid the meshes are generated on, giving about 2 * side * side triangles
+static void BM_GenerateGridWithHoles(benchmark::State& state)
+{
+    for (auto _ : state) {
+        auto mesh = MeshGenerator(1).gridWithHoles(state.range(0), state.range(0), 0.1);
+        state.counters["triangles"] = mesh.triangles.size();
+    }
+}
+BENCHMARK(BM_GenerateGridWithHoles)->Arg(70)->Arg(224)->Arg(707)->Unit(benchmark::kMillisecond);
+
+static void BM_GenerateRandomDelaunay(benchmark::State& state)
+{
+    for (auto _ : state) {
+        auto mesh = MeshGenerator(1).randomDelaunay(state.range(0), state.range(0));
+        state.counters["triangles"] = mesh.triangles.size();
+    }
+}
+BENCHMARK(BM_GenerateRandomDelaunay)->Arg(70)->Arg(224)->Arg(707)->Unit(benchmark::kMillisecond);
+
+static void BM_GenerateCorridorMaze(benchmark::State& state)
+{
+    for (auto _ : state) {
+        auto mesh = MeshGenerator(1).corridorMaze(state.range(0) / 2, state.range(0) / 2);
+        state.counters["triangles"] = mesh.triangles.size();
+    }
+}
+BENCHMARK(BM_GenerateCorridorMaze)->Arg(70)->Arg(224)->Arg(707)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,128 @@
+/**
+ * Copyright 2019 Márton Gergó
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <benchmark/benchmark.h>
+#include <random>
+#include <stdexcept>
+#include "BenchmarkMeshes.h"
+#include "MeshGenerator.h"
+#include "Triangle.h"
+#include "TriangleGraph.h"
+
+using namespace TpaStarCpp::GeometryLibrary;
+using namespace TpaStarCpp::GeometryLibrary::Benchmarks;
+
+// Query points of which nine out of ten fall outside of a side x side grid
+static std::vector<Vector> missHeavyQueries(long side, long count)
+{
+    std::mt19937 random(7);
+    std::uniform_real_distribution<double> inside(0.0, side);
+    std::uniform_real_distribution<double> outside(side + 1.0, 2.0 * side);
+    std::vector<Vector> queries;
+    for (long i = 0; i < count; i++) {
+        queries.emplace_back((i % 10 == 0) ? inside(random) : outside(random), inside(random));
+    }
+    return queries;
+}
+
+static void BM_GetTriangleUnderMissHeavy(benchmark::State& state)
+{
+    auto side = state.range(0);
+    auto graph = std::make_shared<TriangleGraph>(shuffledGrid(side, side), TriangleOrdering::HilbertCurve);
+    auto queries = missHeavyQueries(side, 1024);
+    long hits = 0;
+
+    for (auto _ : state) {
+        for (auto& query : queries) {
+            try {
+                hits += graph->getTriangleUnder(query).id() >= 0;
+            } catch (std::invalid_argument&) {
+            }
+        }
+    }
+    benchmark::DoNotOptimize(hits);
+    state.SetItemsProcessed(state.iterations() * queries.size());
+}
+BENCHMARK(BM_GetTriangleUnderMissHeavy)->Arg(64)->Arg(512);
+
+static void BM_TryGetTriangleUnderMissHeavy(benchmark::State& state)
+{
+    auto side = state.range(0);
+    auto graph = std::make_shared<TriangleGraph>(shuffledGrid(side, side), TriangleOrdering::HilbertCurve);
+    auto queries = missHeavyQueries(side, 1024);
+    long hits = 0;
+
+    for (auto _ : state) {
+        for (auto& query : queries) {
+            hits += graph->tryGetTriangleUnder(query).has_value();
+        }
+    }
+    benchmark::DoNotOptimize(hits);
+    state.SetItemsProcessed(state.iterations() * queries.size());
+}
+BENCHMARK(BM_TryGetTriangleUnderMissHeavy)->Arg(64)->Arg(512);
+
+static void BM_FindIdOfTriangleUnderMissHeavy(benchmark::State& state)
+{
+    auto side = state.range(0);
+    auto graph = std::make_shared<TriangleGraph>(shuffledGrid(side, side), TriangleOrdering::HilbertCurve);
+    auto queries = missHeavyQueries(side, 1024);
+    long hits = 0;
+
+    for (auto _ : state) {
+        for (auto& query : queries) {
+            hits += graph->findIdOfTriangleUnder(query) >= 0;
+        }
+    }
+    benchmark::DoNotOptimize(hits);
+    state.SetItemsProcessed(state.iterations() * queries.size());
+}
+BENCHMARK(BM_FindIdOfTriangleUnderMissHeavy)->Arg(64)->Arg(512);
+
+// the argument is the number of floors stacked above each other, 3 units apart, each a copy of the same grid
+static void BM_FindIdOfTriangleUnderWithHeight(benchmark::State& state)
+{
+    auto floor = MeshGenerator(1).gridWithHoles(256, 256, 0.0);
+    IndexedMesh mesh;
+    for (long layer = 0; layer < state.range(0); layer++) {
+        long firstVertex = mesh.xs.size();
+        mesh.xs.insert(mesh.xs.end(), floor.xs.begin(), floor.xs.end());
+        mesh.ys.insert(mesh.ys.end(), floor.ys.begin(), floor.ys.end());
+        mesh.heights.insert(mesh.heights.end(), floor.xs.size(), 3.0 * layer);
+        for (auto corners : floor.triangles) {
+            mesh.triangles.push_back({ corners[0] + firstVertex, corners[1] + firstVertex, corners[2] + firstVertex });
+            mesh.layers.push_back(layer);
+        }
+    }
+    auto graph = std::make_shared<TriangleGraph>(mesh, TriangleOrdering::HilbertCurve);
+    std::mt19937 random(7);
+    std::uniform_real_distribution<double> coordinate(0.0, 256.0);
+    std::uniform_real_distribution<double> height(0.0, 3.0 * state.range(0));
+    std::vector<std::pair<Vector, double>> queries;
+    for (long i = 0; i < 1024; i++) {
+        queries.emplace_back(Vector(coordinate(random), coordinate(random)), height(random));
+    }
+    long hits = 0;
+
+    for (auto _ : state) {
+        for (auto& query : queries) {
+            hits += graph->findIdOfTriangleUnder(query.first, query.second) >= 0;
+        }
+    }
+    benchmark::DoNotOptimize(hits);
+    state.SetItemsProcessed(state.iterations() * queries.size());
+}
+BENCHMARK(BM_FindIdOfTriangleUnderWithHeight)->Arg(1)->Arg(4)->Arg(16);
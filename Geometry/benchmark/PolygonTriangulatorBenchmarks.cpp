@@ -0,0 +1,58 @@
+/**
+ * Copyright 2019 Márton Gergó
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <benchmark/benchmark.h>
+#include <memory>
+#include "PolygonTriangulator.h"
+#include "TriangleGraph.h"
+#include "Vector.h"
+
+using namespace TpaStarCpp::GeometryLibrary;
+
+// a square outline of the given side with a small square hole in the middle of every unit cell
+static PolygonTriangulator squareWithHoles(long side)
+{
+    PolygonTriangulator triangulator;
+    triangulator.addOutline({ Vector(0.0, 0.0), Vector(side, 0.0), Vector(side, side), Vector(0.0, side) });
+    for (long x = 0; x < side; x++) {
+        for (long y = 0; y < side; y++) {
+            triangulator.addHole({ Vector(x + 0.3, y + 0.3), Vector(x + 0.7, y + 0.3),
+                                   Vector(x + 0.7, y + 0.7), Vector(x + 0.3, y + 0.7) });
+        }
+    }
+    return triangulator;
+}
+
+static void BM_TriangulatePolygonWithHoles(benchmark::State& state)
+{
+    auto triangulator = squareWithHoles(state.range(0));
+    for (auto _ : state) {
+        auto mesh = triangulator.triangulate();
+        state.counters["triangles"] = mesh.triangles.size();
+    }
+}
+BENCHMARK(BM_TriangulatePolygonWithHoles)->Arg(30)->Arg(100)->Arg(300)->Unit(benchmark::kMillisecond);
+
+// building the graph from the triangulation skips matching the edges of the triangles
+static void BM_BuildGraphOfPolygonWithHoles(benchmark::State& state)
+{
+    auto triangulator = squareWithHoles(state.range(0));
+    for (auto _ : state) {
+        auto graph = triangulator.buildGraph();
+        benchmark::DoNotOptimize(graph->triangleCount());
+    }
+}
+BENCHMARK(BM_BuildGraphOfPolygonWithHoles)->Arg(30)->Arg(100)->Arg(300)->Unit(benchmark::kMillisecond);
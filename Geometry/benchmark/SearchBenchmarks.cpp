@@ -0,0 +1,461 @@
+/**
+ * Copyright 2019 Márton Gergó
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <benchmark/benchmark.h>
+#include <map>
+#include <memory>
+#include <random>
+#include <sstream>
+#include "AnytimeSearch.h"
+#include "BenchmarkMeshes.h"
+#include "BidirectionalSearch.h"
+#include "ClearanceSearch.h"
+#include "DistanceField.h"
+#include "DistanceMatrix.h"
+#include "HierarchicalGraph.h"
+#include "IncrementalSearch.h"
+#include "LandmarkHeuristic.h"
+#include "MeshGenerator.h"
+#include "PathCache.h"
+#include "PathCorridor.h"
+#include "TiledSearch.h"
+#include "TriangleSearch.h"
+
+using namespace TpaStarCpp::GeometryLibrary;
+using namespace TpaStarCpp::GeometryLibrary::Benchmarks;
+
+// the argument is the side of the generated mesh, about 2 * side * side triangles with a quarter of the cells left out
+static std::shared_ptr<TriangleGraph> searchMesh(long side)
+{
+    return std::make_shared<TriangleGraph>(MeshGenerator(1).gridWithHoles(side, side, 0.25), TriangleOrdering::HilbertCurve);
+}
+
+static void BM_TriangleSearch(benchmark::State& state)
+{
+    auto graph = searchMesh(state.range(0));
+    auto queries = randomTrianglePairs(graph->triangleCount(), 16);
+    TriangleSearch search(graph);
+    long expandedCount = 0;
+
+    for (auto _ : state) {
+        for (auto [startId, goalId] : queries) {
+            auto start = graph->metadataOf(startId).centroid();
+            auto goal = graph->metadataOf(goalId).centroid();
+            expandedCount += search.findPath(startId, start, goalId, goal, [](long) { return true; }).expandedCount;
+        }
+    }
+    state.counters["expandedPerQuery"] = static_cast<double>(expandedCount) / (state.iterations() * queries.size());
+    state.SetItemsProcessed(state.iterations() * queries.size());
+}
+BENCHMARK(BM_TriangleSearch)->Arg(100)->Arg(500)->Unit(benchmark::kMillisecond);
+
+static void BM_BuildHierarchicalGraph(benchmark::State& state)
+{
+    auto graph = searchMesh(state.range(0));
+    for (auto _ : state) {
+        HierarchicalGraph hierarchy(graph);
+        state.counters["clusters"] = hierarchy.clusterCount();
+        state.counters["nodes"] = hierarchy.nodeCount();
+    }
+}
+BENCHMARK(BM_BuildHierarchicalGraph)->Arg(100)->Arg(500)->Unit(benchmark::kMillisecond);
+
+static void BM_HierarchicalSearch(benchmark::State& state)
+{
+    auto graph = searchMesh(state.range(0));
+    auto queries = randomTrianglePairs(graph->triangleCount(), 16);
+    HierarchicalGraph hierarchy(graph);
+    long expandedCount = 0;
+
+    for (auto _ : state) {
+        for (auto [startId, goalId] : queries) {
+            auto start = graph->metadataOf(startId).centroid();
+            auto goal = graph->metadataOf(goalId).centroid();
+            expandedCount += hierarchy.findPath(start, goal).expandedCount;
+        }
+    }
+    state.counters["expandedPerQuery"] = static_cast<double>(expandedCount) / (state.iterations() * queries.size());
+    state.SetItemsProcessed(state.iterations() * queries.size());
+}
+BENCHMARK(BM_HierarchicalSearch)->Arg(100)->Arg(500)->Unit(benchmark::kMillisecond);
+
+// mazes are where straight line distances mislead the search the most
+static void BM_BuildLandmarkHeuristic(benchmark::State& state)
+{
+    auto graph = std::make_shared<TriangleGraph>(MeshGenerator(1).corridorMaze(state.range(0) / 2, state.range(0) / 2));
+    for (auto _ : state) {
+        LandmarkHeuristic landmarks(graph);
+        benchmark::DoNotOptimize(landmarks.landmarkCount());
+    }
+}
+BENCHMARK(BM_BuildLandmarkHeuristic)->Arg(100)->Arg(500)->Unit(benchmark::kMillisecond);
+
+static void BM_TriangleSearchInMaze(benchmark::State& state)
+{
+    auto graph = std::make_shared<TriangleGraph>(MeshGenerator(1).corridorMaze(state.range(0) / 2, state.range(0) / 2));
+    auto queries = randomTrianglePairs(graph->triangleCount(), 16);
+    TriangleSearch search(graph);
+    long expandedCount = 0;
+
+    for (auto _ : state) {
+        for (auto [startId, goalId] : queries) {
+            expandedCount += search.findPath(graph->metadataOf(startId).centroid(), graph->metadataOf(goalId).centroid()).expandedCount;
+        }
+    }
+    state.counters["expandedPerQuery"] = static_cast<double>(expandedCount) / (state.iterations() * queries.size());
+    state.SetItemsProcessed(state.iterations() * queries.size());
+}
+BENCHMARK(BM_TriangleSearchInMaze)->Arg(100)->Arg(500)->Unit(benchmark::kMillisecond);
+
+static void BM_LandmarkSearchInMaze(benchmark::State& state)
+{
+    auto graph = std::make_shared<TriangleGraph>(MeshGenerator(1).corridorMaze(state.range(0) / 2, state.range(0) / 2));
+    auto queries = randomTrianglePairs(graph->triangleCount(), 16);
+    TriangleSearch search(graph);
+    LandmarkHeuristic landmarks(graph);
+    long expandedCount = 0;
+
+    for (auto _ : state) {
+        for (auto [startId, goalId] : queries) {
+            auto start = graph->metadataOf(startId).centroid();
+            auto goal = graph->metadataOf(goalId).centroid();
+            expandedCount += search.findPath(start, goal, landmarks).expandedCount;
+        }
+    }
+    state.counters["expandedPerQuery"] = static_cast<double>(expandedCount) / (state.iterations() * queries.size());
+    state.SetItemsProcessed(state.iterations() * queries.size());
+}
+BENCHMARK(BM_LandmarkSearchInMaze)->Arg(100)->Arg(500)->Unit(benchmark::kMillisecond);
+
+static void BM_BidirectionalSearch(benchmark::State& state)
+{
+    auto graph = searchMesh(state.range(0));
+    auto queries = randomTrianglePairs(graph->triangleCount(), 16);
+    BidirectionalSearch search(graph);
+    long expandedCount = 0;
+
+    for (auto _ : state) {
+        for (auto [startId, goalId] : queries) {
+            auto start = graph->metadataOf(startId).centroid();
+            auto goal = graph->metadataOf(goalId).centroid();
+            expandedCount += search.findPath(startId, start, goalId, goal).expandedCount;
+        }
+    }
+    state.counters["expandedPerQuery"] = static_cast<double>(expandedCount) / (state.iterations() * queries.size());
+    state.SetItemsProcessed(state.iterations() * queries.size());
+}
+BENCHMARK(BM_BidirectionalSearch)->Arg(100)->Arg(500)->Unit(benchmark::kMillisecond);
+
+static void BM_BidirectionalSearchInMaze(benchmark::State& state)
+{
+    auto graph = std::make_shared<TriangleGraph>(MeshGenerator(1).corridorMaze(state.range(0) / 2, state.range(0) / 2));
+    auto queries = randomTrianglePairs(graph->triangleCount(), 16);
+    BidirectionalSearch search(graph);
+    long expandedCount = 0;
+
+    for (auto _ : state) {
+        for (auto [startId, goalId] : queries) {
+            expandedCount += search.findPath(graph->metadataOf(startId).centroid(), graph->metadataOf(goalId).centroid()).expandedCount;
+        }
+    }
+    state.counters["expandedPerQuery"] = static_cast<double>(expandedCount) / (state.iterations() * queries.size());
+    state.SetItemsProcessed(state.iterations() * queries.size());
+}
+BENCHMARK(BM_BidirectionalSearchInMaze)->Arg(100)->Arg(500)->Unit(benchmark::kMillisecond);
+
+// the same pairs are asked again and again, as spawn points and objectives are
+static void BM_CachedSearch(benchmark::State& state)
+{
+    auto graph = searchMesh(state.range(0));
+    auto queries = randomTrianglePairs(graph->triangleCount(), 16);
+    TriangleSearch search(graph);
+    PathCache cache(graph, 1 << 20);
+    for (auto [startId, goalId] : queries) {
+        cache.findPath(graph->metadataOf(startId).centroid(), graph->metadataOf(goalId).centroid(), search);
+    }
+
+    for (auto _ : state) {
+        for (auto [startId, goalId] : queries) {
+            auto path = cache.findPath(graph->metadataOf(startId).centroid(), graph->metadataOf(goalId).centroid(), search);
+            benchmark::DoNotOptimize(path.has_value());
+        }
+    }
+    state.counters["hitRate"] = static_cast<double>(cache.hitCount()) / (cache.hitCount() + cache.missCount() - queries.size());
+    state.SetItemsProcessed(state.iterations() * queries.size());
+}
+BENCHMARK(BM_CachedSearch)->Arg(100)->Arg(500)->Unit(benchmark::kMillisecond);
+
+// the argument is the number of sources flooded at once
+static void BM_DistanceFields(benchmark::State& state)
+{
+    auto graph = searchMesh(500);
+    std::vector<Vector> sources;
+    for (auto [startId, goalId] : randomTrianglePairs(graph->triangleCount(), state.range(0), 11)) {
+        sources.push_back(graph->metadataOf(startId).centroid());
+    }
+
+    for (auto _ : state) {
+        auto fields = DistanceField::measureFrom(graph, sources);
+        benchmark::DoNotOptimize(fields.back().sourceId());
+    }
+    state.SetItemsProcessed(state.iterations() * sources.size());
+}
+BENCHMARK(BM_DistanceFields)->Arg(1)->Arg(8)->Unit(benchmark::kMillisecond);
+
+// the argument is the number of waypoints, compared with a search for every pair below
+static void BM_DistanceMatrix(benchmark::State& state)
+{
+    auto graph = searchMesh(200);
+    std::vector<Vector> waypoints;
+    for (auto [startId, goalId] : randomTrianglePairs(graph->triangleCount(), state.range(0), 11)) {
+        waypoints.push_back(graph->metadataOf(startId).centroid());
+    }
+
+    for (auto _ : state) {
+        DistanceMatrix matrix(graph, waypoints);
+        benchmark::DoNotOptimize(matrix.costBetween(0, 1));
+    }
+    state.SetItemsProcessed(state.iterations() * waypoints.size() * waypoints.size());
+}
+BENCHMARK(BM_DistanceMatrix)->Arg(50)->Arg(500)->Unit(benchmark::kMillisecond);
+
+static void BM_DistanceMatrixBySearches(benchmark::State& state)
+{
+    auto graph = searchMesh(200);
+    std::vector<long> triangleIds;
+    for (auto [startId, goalId] : randomTrianglePairs(graph->triangleCount(), state.range(0), 11)) {
+        triangleIds.push_back(startId);
+    }
+    TriangleSearch search(graph);
+
+    for (auto _ : state) {
+        for (auto fromId : triangleIds) {
+            for (auto toId : triangleIds) {
+                auto from = graph->metadataOf(fromId).centroid();
+                auto to = graph->metadataOf(toId).centroid();
+                benchmark::DoNotOptimize(search.findPath(fromId, from, toId, to, [](long) { return true; }).cost);
+            }
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * triangleIds.size() * triangleIds.size());
+}
+BENCHMARK(BM_DistanceMatrixBySearches)->Arg(50)->Unit(benchmark::kMillisecond);
+
+// the argument is the suboptimality bound in percent of the shortest path
+static void BM_WeightedSearch(benchmark::State& state)
+{
+    auto graph = searchMesh(500);
+    auto queries = randomTrianglePairs(graph->triangleCount(), 16);
+    TriangleSearch search(graph);
+    auto bound = state.range(0) / 100.0;
+    long expandedCount = 0;
+    double cost = 0.0;
+
+    for (auto _ : state) {
+        for (auto [startId, goalId] : queries) {
+            auto result = search.findBoundedPath(graph->metadataOf(startId).centroid(), graph->metadataOf(goalId).centroid(), bound);
+            expandedCount += result.expandedCount;
+            cost += result.cost;
+        }
+    }
+    double optimalCost = 0.0;
+    for (auto [startId, goalId] : queries) {
+        optimalCost += search.findPath(graph->metadataOf(startId).centroid(), graph->metadataOf(goalId).centroid()).cost;
+    }
+    state.counters["expandedPerQuery"] = static_cast<double>(expandedCount) / (state.iterations() * queries.size());
+    state.counters["costRatio"] = cost / (state.iterations() * optimalCost);
+    state.SetItemsProcessed(state.iterations() * queries.size());
+}
+BENCHMARK(BM_WeightedSearch)->Arg(100)->Arg(105)->Arg(120)->Arg(150)->Unit(benchmark::kMillisecond);
+
+// the argument is the weight of the first pass in percent, the first path is improved once
+static void BM_AnytimeSearch(benchmark::State& state)
+{
+    auto graph = searchMesh(500);
+    auto queries = randomTrianglePairs(graph->triangleCount(), 16);
+    AnytimeSearch search(graph, state.range(0) / 100.0, 0.5);
+    double bound = 0.0;
+    long expandedCount = 0;
+
+    for (auto _ : state) {
+        for (auto [startId, goalId] : queries) {
+            search.start(graph->metadataOf(startId).centroid(), graph->metadataOf(goalId).centroid());
+            search.improve();
+            bound += search.bound();
+            expandedCount += search.result().expandedCount;
+        }
+    }
+    state.counters["expandedPerQuery"] = static_cast<double>(expandedCount) / (state.iterations() * queries.size());
+    state.counters["bound"] = bound / (state.iterations() * queries.size());
+    state.SetItemsProcessed(state.iterations() * queries.size());
+}
+BENCHMARK(BM_AnytimeSearch)->Arg(150)->Arg(250)->Unit(benchmark::kMillisecond);
+
+// a triangle in the middle of the route is blocked and unblocked again, each followed by a repair
+static void BM_IncrementalReplan(benchmark::State& state)
+{
+    auto graph = searchMesh(state.range(0));
+    auto queries = randomTrianglePairs(graph->triangleCount(), 4);
+    IncrementalSearch search(graph);
+    long expandedCount = 0;
+    long replanCount = 0;
+
+    for (auto _ : state) {
+        for (auto [startId, goalId] : queries) {
+            state.PauseTiming();
+            auto route = search.findPath(graph->metadataOf(startId).centroid(), graph->metadataOf(goalId).centroid());
+            state.ResumeTiming();
+            if (route.triangleIds.size() < 3) {
+                continue;
+            }
+            auto blockedId = route.triangleIds[route.triangleIds.size() / 2];
+            graph->setBlocked(blockedId, true);
+            expandedCount += search.replan({ blockedId }).expandedCount;
+            graph->setBlocked(blockedId, false);
+            expandedCount += search.replan({ blockedId }).expandedCount;
+            replanCount += 2;
+        }
+    }
+    state.counters["expandedPerReplan"] = static_cast<double>(expandedCount) / replanCount;
+    state.SetItemsProcessed(replanCount);
+}
+BENCHMARK(BM_IncrementalReplan)->Arg(100)->Arg(500)->Unit(benchmark::kMillisecond);
+
+// one tick of an agent walking a long corridor: a small step towards the next corner and the corners after it
+static void BM_PathCorridorTick(benchmark::State& state)
+{
+    auto graph = searchMesh(state.range(0));
+    auto [startId, goalId] = randomTrianglePairs(graph->triangleCount(), 1).front();
+    auto start = graph->metadataOf(startId).centroid();
+    auto goal = graph->metadataOf(goalId).centroid();
+    auto route = TriangleSearch(graph).findPath(start, goal);
+    auto corridor = std::make_unique<PathCorridor>(graph, route.triangleIds, start, goal);
+
+    for (auto _ : state) {
+        auto corners = corridor->findCorners(2);
+        auto direction = corners[1] - corners[0];
+        if ((corners.size() == 2) && (direction.len() <= 0.05)) {
+            corridor = std::make_unique<PathCorridor>(graph, route.triangleIds, start, goal);
+            continue;
+        }
+        auto isLastStep = direction.len() <= 0.05;
+        benchmark::DoNotOptimize(corridor->movePosition(isLastStep ? corners[1] : corners[0] + direction * (0.05 / direction.len())));
+    }
+    state.counters["corridorLength"] = route.triangleIds.size();
+}
+BENCHMARK(BM_PathCorridorTick)->Arg(100)->Arg(500);
+
+// the argument is the radius of the agent in tenths, wider agents can pass fewer of the one unit wide gaps
+static void BM_ClearanceSearch(benchmark::State& state)
+{
+    auto graph = searchMesh(100);
+    auto queries = randomTrianglePairs(graph->triangleCount(), 16);
+    ClearanceSearch search(graph);
+    auto radius = state.range(0) / 10.0;
+    long expandedCount = 0;
+    long foundCount = 0;
+
+    for (auto _ : state) {
+        for (auto [startId, goalId] : queries) {
+            auto result = search.findPath(graph->metadataOf(startId).centroid(), graph->metadataOf(goalId).centroid(), radius);
+            expandedCount += result.expandedCount;
+            foundCount += result.isFound ? 1 : 0;
+        }
+    }
+    state.counters["expandedPerQuery"] = static_cast<double>(expandedCount) / (state.iterations() * queries.size());
+    state.counters["foundRatio"] = static_cast<double>(foundCount) / (state.iterations() * queries.size());
+    state.SetItemsProcessed(state.iterations() * queries.size());
+}
+BENCHMARK(BM_ClearanceSearch)->Arg(0)->Arg(3)->Arg(6)->Unit(benchmark::kMillisecond);
+
+// the argument is the percentage of triangles with three times the cost, like mud between roads
+static void BM_TriangleSearchOnTerrain(benchmark::State& state)
+{
+    auto graph = searchMesh(100);
+    std::mt19937 random(1);
+    std::uniform_int_distribution<int> percent(0, 99);
+    for (long id = 0; id < graph->triangleCount(); id++) {
+        graph->setCostMultiplier(id, (percent(random) < state.range(0)) ? 3.0 : 1.0);
+    }
+    auto queries = randomTrianglePairs(graph->triangleCount(), 16);
+    TriangleSearch search(graph);
+    long expandedCount = 0;
+
+    for (auto _ : state) {
+        for (auto [startId, goalId] : queries) {
+            expandedCount += search.findPath(graph->metadataOf(startId).centroid(), graph->metadataOf(goalId).centroid()).expandedCount;
+        }
+    }
+    state.counters["expandedPerQuery"] = static_cast<double>(expandedCount) / (state.iterations() * queries.size());
+    state.SetItemsProcessed(state.iterations() * queries.size());
+}
+BENCHMARK(BM_TriangleSearchOnTerrain)->Arg(0)->Arg(30)->Unit(benchmark::kMillisecond);
+
+// the argument is the number of jumps between random triangles, each as costly as the distance it bridges
+static void BM_TriangleSearchWithLinks(benchmark::State& state)
+{
+    auto graph = searchMesh(100);
+    for (auto [fromId, toId] : randomTrianglePairs(graph->triangleCount(), state.range(0), 11)) {
+        auto entry = graph->metadataOf(fromId).centroid();
+        auto exit = graph->metadataOf(toId).centroid();
+        graph->addOffMeshLink(entry, exit, entry.distanceFrom(exit));
+    }
+    auto queries = randomTrianglePairs(graph->triangleCount(), 16);
+    TriangleSearch search(graph);
+    long expandedCount = 0;
+
+    for (auto _ : state) {
+        for (auto [startId, goalId] : queries) {
+            expandedCount += search.findPath(graph->metadataOf(startId).centroid(), graph->metadataOf(goalId).centroid()).expandedCount;
+        }
+    }
+    state.counters["expandedPerQuery"] = static_cast<double>(expandedCount) / (state.iterations() * queries.size());
+    state.SetItemsProcessed(state.iterations() * queries.size());
+}
+BENCHMARK(BM_TriangleSearchWithLinks)->Arg(0)->Arg(1000)->Unit(benchmark::kMillisecond);
+
+// the argument is the side of the tiles, the whole mesh resident, to measure the cost of crossing between tiles
+static void BM_TiledSearch(benchmark::State& state)
+{
+    auto mesh = MeshGenerator(1).gridWithHoles(100, 100, 0.25);
+    auto whole = std::make_shared<TriangleGraph>(mesh);
+    auto data = std::make_shared<std::map<std::pair<long, long>, std::string>>();
+    for (auto& tile : MeshTile::split(mesh, state.range(0))) {
+        std::stringstream output;
+        tile.save(output);
+        (*data)[{ tile.coordinates.x, tile.coordinates.y }] = output.str();
+    }
+    auto graph = std::make_shared<TiledGraph>([data](long tileX, long tileY) -> std::unique_ptr<std::istream> {
+        auto found = data->find({ tileX, tileY });
+        return (found == data->end()) ? nullptr : std::make_unique<std::istringstream>(found->second);
+    }, state.range(0), whole->triangleCount());
+    for (auto& entry : *data) {
+        graph->requestTile({ entry.first.first, entry.first.second });
+    }
+    graph->waitUntilIdle();
+    auto queries = randomTrianglePairs(whole->triangleCount(), 16);
+    TiledSearch search(graph);
+    long expandedCount = 0;
+
+    for (auto _ : state) {
+        for (auto [startId, goalId] : queries) {
+            expandedCount += search.findPath(whole->metadataOf(startId).centroid(), whole->metadataOf(goalId).centroid()).expandedCount;
+        }
+    }
+    state.counters["expandedPerQuery"] = static_cast<double>(expandedCount) / (state.iterations() * queries.size());
+    state.SetItemsProcessed(state.iterations() * queries.size());
+}
+BENCHMARK(BM_TiledSearch)->Arg(25)->Arg(100)->Unit(benchmark::kMillisecond);
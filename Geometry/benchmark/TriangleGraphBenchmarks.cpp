@@ -0,0 +1,94 @@
+/**
+ * Copyright 2019 Márton Gergó
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <random>
+#include "BenchmarkMeshes.h"
+#include "Triangle.h"
+#include "TriangleGraph.h"
+
+using namespace TpaStarCpp::GeometryLibrary;
+using namespace TpaStarCpp::GeometryLibrary::Benchmarks;
+
+// the argument of these benchmarks is the approximate triangle count of a square grid
+static long sideOfGridWith(long triangleCount)
+{
+    return std::max(1L, std::lround(std::sqrt(triangleCount / 2.0)));
+}
+
+static void triangleCounts(benchmark::internal::Benchmark* benchmark)
+{
+    for (long count = 100; count <= 1000000; count *= 10) {
+        benchmark->Arg(count);
+    }
+}
+
+static void BM_TriangleGraphConstruction(benchmark::State& state)
+{
+    auto side = sideOfGridWith(state.range(0));
+    auto triangles = shuffledGrid(side, side);
+
+    for (auto _ : state) {
+        auto graph = std::make_shared<TriangleGraph>(triangles);
+        benchmark::DoNotOptimize(graph);
+    }
+    state.SetItemsProcessed(state.iterations() * triangles.size());
+    state.counters["triangles"] = triangles.size();
+}
+BENCHMARK(BM_TriangleGraphConstruction)->Apply(triangleCounts)->Unit(benchmark::kMillisecond);
+
+static void BM_TriangleGraphGetTriangleUnder(benchmark::State& state)
+{
+    auto side = sideOfGridWith(state.range(0));
+    auto graph = std::make_shared<TriangleGraph>(shuffledGrid(side, side));
+    std::mt19937 random(11);
+    std::uniform_real_distribution<double> coordinate(0.0, side);
+    std::vector<Vector> queries;
+    for (int i = 0; i < 1024; i++) {
+        queries.emplace_back(coordinate(random), coordinate(random));
+    }
+
+    for (auto _ : state) {
+        for (auto& query : queries) {
+            benchmark::DoNotOptimize(graph->getTriangleUnder(query).id());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * queries.size());
+    state.counters["triangles"] = graph->triangleCount();
+}
+BENCHMARK(BM_TriangleGraphGetTriangleUnder)->Apply(triangleCounts);
+
+static void BM_TriangleGraphGetNeighbours(benchmark::State& state)
+{
+    auto side = sideOfGridWith(state.range(0));
+    auto graph = std::make_shared<TriangleGraph>(shuffledGrid(side, side));
+    std::mt19937 random(13);
+    std::uniform_real_distribution<double> coordinate(0.0, side);
+    std::vector<Triangle> triangles;
+    for (int i = 0; i < 1024; i++) {
+        triangles.push_back(graph->getTriangleUnder(Vector(coordinate(random), coordinate(random))));
+    }
+
+    for (auto _ : state) {
+        for (auto& triangle : triangles) {
+            benchmark::DoNotOptimize(graph->getNeighbours(triangle));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * triangles.size());
+    state.counters["triangles"] = graph->triangleCount();
+}
+BENCHMARK(BM_TriangleGraphGetNeighbours)->Apply(triangleCounts);
@@ -0,0 +1,62 @@
+/**
+ * Copyright 2019 Márton Gergó
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include "BenchmarkMeshes.h"
+#include "TriangleGraph.h"
+
+using namespace TpaStarCpp::GeometryLibrary;
+using namespace TpaStarCpp::GeometryLibrary::Benchmarks;
+
+// Expands every triangle of a shuffled grid the way a search would: following neighbour ids
+// and reading the metadata of each neighbour. Run with --benchmark_perf_counters=CACHE-MISSES
+// on builds of Google Benchmark with libpfm support to see the cache misses behind the difference.
+static void BM_BreadthFirstExpansion(benchmark::State& state, TriangleOrdering ordering)
+{
+    auto side = state.range(0);
+    auto graph = std::make_shared<TriangleGraph>(shuffledGrid(side, side), ordering);
+    std::vector<long> visitedIn(graph->triangleCount(), -1);
+    std::vector<long> queue;
+    queue.reserve(graph->triangleCount());
+    long generation = 0;
+    double totalDistance = 0.0;
+
+    for (auto _ : state) {
+        generation++;
+        queue.clear();
+        queue.push_back(graph->internalIdOf(0));
+        visitedIn[queue.front()] = generation;
+        for (long head = 0; head < queue.size(); head++) {
+            auto& current = graph->metadataOf(queue[head]);
+            for (auto neighbour : graph->neighbourIdsOf(queue[head])) {
+                if (visitedIn[neighbour] != generation) {
+                    auto& next = graph->metadataOf(neighbour);
+                    totalDistance += std::hypot(next.centroidX - current.centroidX, next.centroidY - current.centroidY);
+                    visitedIn[neighbour] = generation;
+                    queue.push_back(neighbour);
+                }
+            }
+        }
+        benchmark::DoNotOptimize(totalDistance);
+    }
+    state.SetItemsProcessed(state.iterations() * graph->triangleCount());
+    state.counters["triangles"] = graph->triangleCount();
+}
+BENCHMARK_CAPTURE(BM_BreadthFirstExpansion, InputOrder, TriangleOrdering::InputOrder)
+    ->RangeMultiplier(4)->Range(64, 1024)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_BreadthFirstExpansion, HilbertCurve, TriangleOrdering::HilbertCurve)
+    ->RangeMultiplier(4)->Range(64, 1024)->Unit(benchmark::kMillisecond);
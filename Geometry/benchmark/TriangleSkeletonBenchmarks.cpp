@@ -0,0 +1,32 @@
+/**
+ * Copyright 2019 Márton Gergó
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <benchmark/benchmark.h>
+#include "TriangleSkeleton.h"
+
+using namespace TpaStarCpp::GeometryLibrary;
+
+static void BM_TriangleSkeletonContainsPoint(benchmark::State& state, double x, double y)
+{
+    TriangleSkeleton triangle(Vector(1.0, 2.0), Vector(3.0, 2.0), Vector(1.0, 4.0));
+    Vector point(x, y);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(triangle.containsPoint(point));
+    }
+}
+BENCHMARK_CAPTURE(BM_TriangleSkeletonContainsPoint, Inside, 1.5, 2.5);
+BENCHMARK_CAPTURE(BM_TriangleSkeletonContainsPoint, Outside, 0.0, 2.5);
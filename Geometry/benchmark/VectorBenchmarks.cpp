@@ -0,0 +1,67 @@
+/**
+ * Copyright 2019 Márton Gergó
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <benchmark/benchmark.h>
+#include "Edge.h"
+#include "Vector.h"
+
+using namespace TpaStarCpp::GeometryLibrary;
+
+static void BM_VectorArithmetic(benchmark::State& state)
+{
+    Vector u(1.5, 2.5);
+    Vector v(-0.5, 4.0);
+
+    for (auto _ : state) {
+        auto result = (u + v) * 0.5 - v;
+        benchmark::DoNotOptimize(result.x());
+        benchmark::DoNotOptimize(result.y());
+    }
+}
+BENCHMARK(BM_VectorArithmetic);
+
+static void BM_VectorDistance(benchmark::State& state)
+{
+    Vector u(1.5, 2.5);
+    Vector v(-0.5, 4.0);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(u.distanceFrom(v));
+    }
+}
+BENCHMARK(BM_VectorDistance);
+
+static void BM_VectorEquality(benchmark::State& state)
+{
+    Vector u(1.5, 2.5);
+    Vector v(1.5, 2.500001);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(u == v);
+    }
+}
+BENCHMARK(BM_VectorEquality);
+
+static void BM_EdgeDistanceFrom(benchmark::State& state)
+{
+    Edge edge(Vector(1.0, 1.0), Vector(3.0, 3.0));
+    Vector point(1.0, 3.0);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(edge.distanceFrom(point));
+    }
+}
+BENCHMARK(BM_EdgeDistanceFrom);
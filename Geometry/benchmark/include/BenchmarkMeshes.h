@@ -0,0 +1,52 @@
+/**
+ * Copyright 2019 Márton Gergó
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <utility>
+#include <vector>
+#include "MeshGenerator.h"
+#include "TriangleSkeleton.h"
+
+namespace TpaStarCpp::GeometryLibrary::Benchmarks {
+
+    /*
+     * A grid of unit squares, each split into two triangles, with the triangles listed in random order,
+     * the way exported meshes rarely keep spatially adjacent triangles next to each other.
+     */
+    inline std::vector<TriangleSkeleton> shuffledGrid(long columns, long rows, unsigned seed = 42)
+    {
+        auto mesh = MeshGenerator(seed).gridWithHoles(columns, rows, 0.0);
+        std::shuffle(begin(mesh.triangles), end(mesh.triangles), std::mt19937(seed));
+        return mesh.toTriangleSkeletons();
+    }
+
+    // start and goal triangles picked uniformly, the same ones for every run
+    inline std::vector<std::pair<long, long>> randomTrianglePairs(long triangleCount, long count, unsigned seed = 7)
+    {
+        std::mt19937 random(seed);
+        std::uniform_int_distribution<long> triangle(0, triangleCount - 1);
+        std::vector<std::pair<long, long>> pairs;
+        for (long i = 0; i < count; i++) {
+            pairs.emplace_back(triangle(random), triangle(random));
+        }
+        return pairs;
+    }
+
+}
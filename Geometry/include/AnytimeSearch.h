@@ -0,0 +1,87 @@
+/**
+ * Copyright 2019 Márton Gergó
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "SearchNodes.h"
+#include "SearchResult.h"
+#include "TriangleGraph.h"
+#include "Vector.h"
+
+namespace TpaStarCpp::GeometryLibrary {
+
+    /*
+     * Anytime repairing A* (ARA*): a weighted search finds a path quickly, then every improvement lowers the
+     * weight and continues from the costs found so far. Triangles improved after they were expanded in a pass
+     * wait for the next one instead of being expanded again. After each pass the cost of the path is at most
+     * bound() times the shortest one, proven by the lowest unweighted f among the triangles not finished yet.
+     */
+    class AnytimeSearch {
+
+    private:
+        struct OpenEntry {
+            double key;
+            long id;
+        };
+
+        std::shared_ptr<TriangleGraph> graph_;
+        double initialWeight_;
+        double weightStep_;
+        SearchNodes nodes_;
+        std::vector<uint32_t> closedPasses_;
+        std::vector<uint32_t> openPasses_;
+        std::vector<uint32_t> inconsistentPasses_;
+        uint32_t pass_ = 0;
+        std::vector<OpenEntry> open_;
+        std::vector<long> inconsistentIds_;
+        long startId_ = -1;
+        long goalId_ = -1;
+        double goalX_ = 0.0;
+        double goalY_ = 0.0;
+        double goalCost_ = 0.0;
+        // read when the search starts, so the estimates stay consistent while it runs
+        double minCostMultiplier_ = 1.0;
+        double weight_ = 1.0;
+        double bound_ = 1.0;
+        long expandedCount_ = 0;
+        SearchResult result_ = SearchResult::notFound(0);
+
+        double estimateOf(long id);
+        void push(long id);
+        void startPass();
+        void improvePath();
+        void updateBound();
+
+    public:
+        // the first path is searched with the initial weight, lowered by the step before each improvement
+        explicit AnytimeSearch(std::shared_ptr<TriangleGraph> graph, double initialWeight = 2.5, double weightStep = 0.5);
+        // searches the first path, throws if the start or the goal is not on the mesh
+        const SearchResult& start(Vector start, Vector goal);
+        // false if there is no path or it is already the shortest one
+        bool improve();
+        const SearchResult& result() { return result_; }
+        // the path costs at most this many times as much as the shortest one
+        double bound() { return bound_; }
+        // improves the path until it is within the target bound or the time is up, whichever comes first
+        SearchResult findPath(Vector start, Vector goal, double targetBound, std::chrono::microseconds budget);
+
+    };
+
+}
@@ -0,0 +1,51 @@
+/**
+ * Copyright 2019 Márton Gergó
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <memory>
+#include "SearchNodes.h"
+#include "SearchResult.h"
+#include "TriangleGraph.h"
+#include "Vector.h"
+
+namespace TpaStarCpp::GeometryLibrary {
+
+    /*
+     * A* running from the start and from the goal triangle at the same time. Both sides order their open lists by
+     * the same potential, half of the difference of the straight line distances to the goal and to the start,
+     * added by the forward side and subtracted by the backward one. Steps cost the same in both directions and
+     * the potential never changes more than a step costs, so this is a two sided Dijkstra search on shortened
+     * steps: a triangle reached by both sides joins the paths at the sum of their costs, and no path not found
+     * yet is shorter than the sum of the two lowest keys, where the search stops.
+     * The node arrays of both sides are reused by the following searches, one instance is meant for one thread.
+     */
+    class BidirectionalSearch {
+
+    private:
+        std::shared_ptr<TriangleGraph> graph_;
+        SearchNodes forward_;
+        SearchNodes backward_;
+
+    public:
+        explicit BidirectionalSearch(std::shared_ptr<TriangleGraph> graph);
+        // throws if the start or the goal is not on the mesh
+        SearchResult findPath(Vector start, Vector goal);
+        SearchResult findPath(long startId, Vector start, long goalId, Vector goal);
+
+    };
+
+}
@@ -0,0 +1,51 @@
+/**
+ * Copyright 2019 Márton Gergó
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include <memory>
+#include "SearchNodes.h"
+#include "SearchResult.h"
+#include "TriangleGraph.h"
+#include "Vector.h"
+
+namespace TpaStarCpp::GeometryLibrary {
+
+    /*
+     * The triangle search for agents of a given radius, on the same graph for every size. Passing through a
+     * triangle from one edge to another goes around the corner they share, so it is allowed only if the clearance
+     * of that corner fits the agent. The nodes are the triangles together with the edge they were entered through,
+     * as the edge decides which corner the agent goes around next.
+     * Only the way between the triangles is checked, the start and the goal are expected to be far enough from the
+     * walls already. The node arrays are reused, so an instance is meant to be used by one thread at a time.
+     */
+    class ClearanceSearch {
+
+    private:
+        std::shared_ptr<TriangleGraph> graph_;
+        SearchNodes nodes_;
+
+        bool canLeave(long id, int entryEdge, int exitEdge, double diameter);
+
+    public:
+        explicit ClearanceSearch(std::shared_ptr<TriangleGraph> graph);
+        // throws if the radius is negative or the start or the goal is not on the mesh
+        SearchResult findPath(Vector start, Vector goal, double radius);
+
+    };
+
+}
@@ -0,0 +1,86 @@
+/**
+ * Copyright 2019 Márton Gergó
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <memory>
+#include <vector>
+#include "Edge.h"
+#include "TriangleGraph.h"
+
+namespace TpaStarCpp::GeometryLibrary {
+
+    enum class ContractionLevel {
+        // part of a dead-end subtree, which a path only enters if the start or the goal lies inside
+        Tree,
+        // one of a chain of triangles with exactly two neighbours left after removing the trees
+        Corridor,
+        Junction
+    };
+
+    // a chain of corridor triangles between two junctions, possibly empty if the junctions are neighbours
+    struct Corridor {
+        long fromJunctionId;
+        long toJunctionId;
+        std::vector<long> triangleIds;
+        // the edges crossed on the way from the first junction to the second one
+        std::vector<Edge> portals;
+        // through the centroids and the midpoints of the portals
+        double length;
+    };
+
+    /*
+     * Contracts the triangle graph for searches. Dead-end subtrees are peeled off first, then every chain of
+     * triangles with two neighbours is collapsed into a corridor between the junctions at its ends, so a search
+     * only expands junctions and crosses each corridor in a single step. Rings without junctions get one of
+     * their triangles promoted to a junction, and so does every triangle an off-mesh link starts or ends in,
+     * which lets a search leave the corridors through the links of the triangle graph.
+     */
+    class CorridorGraph {
+
+    private:
+        std::shared_ptr<TriangleGraph> triangles_;
+        std::vector<ContractionLevel> levels_;
+        std::vector<long> treeParentIds_;
+        std::vector<long> treeRootIds_;
+        std::vector<long> corridorIds_;
+        std::vector<Corridor> corridors_;
+        std::vector<long> junctionIds_;
+        std::vector<std::vector<long>> junctionCorridorIds_;
+        std::vector<bool> isLinkEnd_;
+
+        void pruneTrees();
+        void collapseCorridors();
+        void walkCorridors(long junctionId);
+        Edge portalBetween(long id, long neighbourId);
+
+    public:
+        explicit CorridorGraph(std::shared_ptr<TriangleGraph> triangles);
+        ContractionLevel levelOf(long id) { return levels_[id]; }
+        // the neighbour one step closer to the rest of the graph, -1 for the last triangle of a detached tree
+        long treeParentOf(long id) { return treeParentIds_[id]; }
+        // the corridor or junction triangle the tree hangs off, -1 if the whole component is a tree
+        long treeRootOf(long id) { return treeRootIds_[id]; }
+        // -1 for triangles that are not part of a corridor
+        long corridorIdOf(long id) { return corridorIds_[id]; }
+        long corridorCount() { return corridors_.size(); }
+        const Corridor& corridor(long corridorId) { return corridors_[corridorId]; }
+        const std::vector<long>& junctionIds() { return junctionIds_; }
+        const std::vector<long>& corridorIdsAt(long junctionId) { return junctionCorridorIds_[junctionId]; }
+
+    };
+
+}
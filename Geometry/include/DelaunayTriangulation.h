@@ -0,0 +1,87 @@
+/**
+ * Copyright 2019 Márton Gergó
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <utility>
+#include <vector>
+#include "IndexedMesh.h"
+
+namespace TpaStarCpp::GeometryLibrary {
+
+    /*
+     * Incremental Delaunay triangulation of points inside a rectangle. The corners of the rectangle are the first
+     * four vertices, every further vertex is located by walking from the previously created triangle and inserted
+     * by splitting the triangle or edge under it, followed by flipping the edges that became illegal (Lawson).
+     * Inserting points in Hilbert order keeps the walks short, giving O(n log n) construction in practice.
+     * Constraint edges are forced into the triangulation by flipping the edges crossing them (Sloan), and are
+     * never flipped afterwards, so a constraint crossing an earlier one throws. Faces enclosed by an odd number of
+     * constraint rings form the inside of polygons.
+     */
+    class DelaunayTriangulation {
+
+    private:
+        struct Face {
+            long vertices[3];
+            // neighbour across the edge between vertex k and k+1, -1 on the border of the rectangle
+            long neighbours[3];
+            bool isConstrained[3];
+        };
+
+        std::vector<double> xs_;
+        std::vector<double> ys_;
+        std::vector<Face> faces_;
+        std::vector<long> vertexFaces_;
+        long lastFace_ = 0;
+
+        double orientation(long a, long b, long c);
+        double orientation(long a, long b, double x, double y);
+        bool isInCircumcircle(long face, long vertex);
+        long locate(double x, double y);
+        int edgeTowards(long face, long neighbour);
+        void replaceNeighbour(long face, long oldNeighbour, long newNeighbour);
+        void storeFace(long face, Face value);
+        std::pair<long, int> findEdge(long from, long to);
+        bool isConvexQuad(long face, int edge);
+        bool crossesProperly(long a, long b, long c, long d);
+        void markConstrained(long face, int edge);
+        std::vector<bool> findEnclosedFaces();
+        IndexedMesh toIndexedMesh(const std::vector<bool>& isKept);
+        void splitFace(long face, long vertex);
+        void splitEdge(long face, int edge, long vertex);
+        void flip(long face, int edge);
+        void legalize(std::vector<std::pair<long, long>>& facesWithNewVertex);
+
+    public:
+        DelaunayTriangulation(double minX, double minY, double maxX, double maxY);
+        // returns the id of the new vertex, or of the existing one equal to the point
+        long insertVertex(double x, double y);
+        /*
+         * Forces the edge between the two vertices into the triangulation. Throws if it crosses another constraint,
+         * the parts of the edge up to a vertex it runs through may already be inserted then.
+         */
+        void insertConstraint(long from, long to);
+        long vertexCount();
+        bool containsEdge(long from, long to);
+        IndexedMesh toIndexedMesh();
+        // keeps the faces that lie inside an odd number of closed constraint rings only
+        IndexedMesh toIndexedMeshOfEnclosedFaces();
+        // whether the face on the left of each edge is kept by the above, throws for an edge not in the triangulation
+        std::vector<bool> findEnclosedLeftSides(const std::vector<std::pair<long, long>>& edges);
+
+    };
+
+}
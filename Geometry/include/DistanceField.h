@@ -0,0 +1,64 @@
+/**
+ * Copyright 2019 Márton Gergó
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <limits>
+#include <memory>
+#include <vector>
+#include "TriangleGraph.h"
+#include "Vector.h"
+
+namespace TpaStarCpp::GeometryLibrary {
+
+    /*
+     * The cost from the centroid of every triangle to a source point, with the same steps through the edge
+     * midpoints as the searches, filled by a single Dijkstra flood running backwards over the steps. Following
+     * the parents from a triangle walks to the triangle of the source, like a flow field, taking off-mesh links
+     * only in their direction. Triangles farther than the radius are left unreached, so are the blocked ones.
+     * Fields of several sources are measured in parallel.
+     */
+    class DistanceField {
+
+    private:
+        std::shared_ptr<TriangleGraph> graph_;
+        double radius_;
+        long sourceId_;
+        std::vector<double> distances_;
+        std::vector<long> parentIds_;
+
+        DistanceField(std::shared_ptr<TriangleGraph> graph, double radius);
+        void flood(long sourceId, Vector source);
+
+    public:
+        // throws if the source is not on the mesh
+        DistanceField(std::shared_ptr<TriangleGraph> graph, Vector source,
+                double radius = std::numeric_limits<double>::infinity());
+        // one field for each source, in the order of the sources, throws if any of them is not on the mesh
+        static std::vector<DistanceField> measureFrom(std::shared_ptr<TriangleGraph> graph,
+                const std::vector<Vector>& sources, double radius = std::numeric_limits<double>::infinity());
+        long sourceId() { return sourceId_; }
+        bool isReached(long id) { return distances_[id] < std::numeric_limits<double>::infinity(); }
+        // infinite for unreached triangles
+        double distanceOf(long id) { return distances_[id]; }
+        // the next triangle towards the source, -1 for the triangle of the source and unreached triangles
+        long parentIdOf(long id) { return parentIds_[id]; }
+        // the triangles from the specified one to the triangle of the source, empty if it is not reached
+        std::vector<long> pathFrom(long id);
+
+    };
+
+}
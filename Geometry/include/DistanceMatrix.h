@@ -0,0 +1,61 @@
+/**
+ * Copyright 2019 Márton Gergó
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <memory>
+#include <vector>
+#include "SearchNodes.h"
+#include "TriangleGraph.h"
+#include "TriangleSearch.h"
+#include "Vector.h"
+
+namespace TpaStarCpp::GeometryLibrary {
+
+    /*
+     * The path costs between every pair of waypoints, measured by one Dijkstra search per waypoint instead of
+     * a search per pair. Without off-mesh links paths cost the same both ways, so the search of a waypoint only
+     * has to settle the triangles of the waypoints after it and stops as soon as it did. Links may lead one way
+     * only, on graphs that have them every search settles the waypoints of its whole row. The searches run in
+     * parallel, reusing the node arrays of their thread. Corridors are searched only when they are asked for.
+     */
+    class DistanceMatrix {
+
+    private:
+        std::shared_ptr<TriangleGraph> graph_;
+        std::vector<Vector> waypoints_;
+        std::vector<long> triangleIds_;
+        // waypoints in the same triangle are chained together, starting from the one with the highest index
+        std::vector<long> firstWaypointIds_;
+        std::vector<long> nextWaypointIds_;
+        // row by row, infinite between waypoints that cannot reach each other
+        std::vector<double> costs_;
+        TriangleSearch corridorSearch_;
+
+        void measureFrom(long waypointId, SearchNodes& nodes);
+
+    public:
+        // throws if a waypoint is not on the mesh
+        DistanceMatrix(std::shared_ptr<TriangleGraph> graph, std::vector<Vector> waypoints);
+        long size() { return waypoints_.size(); }
+        double costBetween(long fromId, long toId) { return costs_[fromId * size() + toId]; }
+        const std::vector<double>& costs() { return costs_; }
+        // the triangles of a shortest path between the two waypoints, empty if there is none
+        std::vector<long> corridorBetween(long fromId, long toId);
+
+    };
+
+}
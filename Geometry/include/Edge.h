@@ -26,12 +26,11 @@ namespace TpaStarCpp::GeometryLibrary {
         const Vector a_;
         const Vector b_;
 
-        Vector closestPointTo(Vector point);
-
     public:
         Edge(Vector a,Vector b);
         Vector a();
         Vector b() ;
+        Vector closestPointTo(Vector point);
         double distanceFrom(Vector point);
         bool pointLiesOnEdge(Vector point);
         bool operator==(Edge other);
@@ -0,0 +1,175 @@
+/**
+ * Copyright 2019 Márton Gergó
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+#include "TriangleGraph.h"
+#include "Vector.h"
+
+namespace TpaStarCpp::GeometryLibrary {
+
+    /*
+     * Pulls a string through the portals of a triangle corridor: the shortest polyline from the start to the goal
+     * that stays inside the corridor. The apex of a funnel is moved to its left or right side whenever the next
+     * portal would cross over it. Portals are taken from the graph as they are reached, so a string pulled only
+     * up to its first corners does not touch the rest of the corridor. The funnel keeps no state between calls,
+     * so it can be shared by threads.
+     * For agents with a radius the ends of the portals on obstacle corners are moved inwards by the radius, so the
+     * string turns around the corners at that distance, as found by a ClearanceSearch.
+     * Off-mesh links in the corridor appear as their entry and exit points in the string.
+     */
+    class Funnel {
+
+    private:
+        // an off-mesh link is a portal closed to its entry point, the string goes on from its exit point
+        struct Portal {
+            double leftX;
+            double leftY;
+            double rightX;
+            double rightY;
+            bool isLink;
+            double exitX;
+            double exitY;
+        };
+
+        std::shared_ptr<TriangleGraph> graph_;
+        double radius_;
+
+        // throws if the triangles are neither neighbours nor connected by a link
+        Portal portalBetween(long fromId, long toId);
+
+        // positive if c is on the left of the direction from a to b
+        static double crossOf(double ax, double ay, double bx, double by, double cx, double cy)
+        {
+            return (bx - ax) * (cy - ay) - (by - ay) * (cx - ax);
+        }
+
+        static bool isSame(double ax, double ay, double bx, double by)
+        {
+            return (ax - bx) * (ax - bx) + (ay - by) * (ay - by) < 1e-18;
+        }
+
+    public:
+        // throws if the radius is negative
+        explicit Funnel(std::shared_ptr<TriangleGraph> graph, double radius = 0.0);
+
+        // the corridor lists neighbouring triangles from the one of the start to the one of the goal,
+        // the result begins with the start and ends with the goal
+        std::vector<Vector> pullString(const std::vector<long>& triangleIds, Vector start, Vector goal)
+        {
+            return pullString(triangleIds, start, goal, std::numeric_limits<long>::max());
+        }
+
+        /*
+         * Stops after the specified number of corners following the start. The goal counts as a corner and is
+         * the last point only if it was reached. Any container with indexed access to the triangle ids will do.
+         */
+        template <typename TriangleIds>
+        std::vector<Vector> pullString(const TriangleIds& triangleIds, Vector start, Vector goal, long maxCornerCount)
+        {
+            if (triangleIds.empty()) {
+                throw std::invalid_argument("The corridor must contain at least one triangle");
+            }
+            long portalCount = triangleIds.size() + 1;
+            auto portalAt = [&](long i) {
+                if (i == portalCount - 1) {
+                    return Portal { goal.x(), goal.y(), goal.x(), goal.y(), false, 0.0, 0.0 };
+                }
+                return portalBetween(triangleIds[i - 1], triangleIds[i]);
+            };
+
+            std::vector<Vector> points { start };
+            auto apexX = start.x();
+            auto apexY = start.y();
+            auto leftX = apexX;
+            auto leftY = apexY;
+            auto rightX = apexX;
+            auto rightY = apexY;
+            long apexIndex = 0;
+            long leftIndex = 0;
+            long rightIndex = 0;
+            long linkIndex = -1;
+            double linkExitX = 0.0;
+            double linkExitY = 0.0;
+            // a corridor turning around a corner has that corner on several portals in a row, it is added once
+            auto moveApex = [&](double x, double y, long index) {
+                if (index == linkIndex) {
+                    // the entry of the link became the apex, the string goes on from its exit
+                    if (!isSame(points.back().x(), points.back().y(), x, y)) {
+                        points.emplace_back(x, y);
+                    }
+                    x = linkExitX;
+                    y = linkExitY;
+                }
+                if (!isSame(points.back().x(), points.back().y(), x, y)) {
+                    points.emplace_back(x, y);
+                }
+                apexX = leftX = rightX = x;
+                apexY = leftY = rightY = y;
+                apexIndex = leftIndex = rightIndex = index;
+            };
+            for (long i = 1; (i < portalCount) && (points.size() <= maxCornerCount); i++) {
+                auto portal = portalAt(i);
+                if (portal.isLink) {
+                    linkIndex = i;
+                    linkExitX = portal.exitX;
+                    linkExitY = portal.exitY;
+                }
+                if (crossOf(apexX, apexY, rightX, rightY, portal.rightX, portal.rightY) >= 0.0) {
+                    if (isSame(apexX, apexY, rightX, rightY) || (crossOf(apexX, apexY, leftX, leftY, portal.rightX, portal.rightY) < 0.0)) {
+                        rightX = portal.rightX;
+                        rightY = portal.rightY;
+                        rightIndex = i;
+                    } else {
+                        // the right side crossed over the left one, the funnel continues from the left corner
+                        moveApex(leftX, leftY, leftIndex);
+                        i = apexIndex;
+                        continue;
+                    }
+                }
+                if (crossOf(apexX, apexY, leftX, leftY, portal.leftX, portal.leftY) <= 0.0) {
+                    if (isSame(apexX, apexY, leftX, leftY) || (crossOf(apexX, apexY, rightX, rightY, portal.leftX, portal.leftY) > 0.0)) {
+                        leftX = portal.leftX;
+                        leftY = portal.leftY;
+                        leftIndex = i;
+                    } else {
+                        moveApex(rightX, rightY, rightIndex);
+                        i = apexIndex;
+                        continue;
+                    }
+                }
+                // both sides reached the entry of the link without crossing over, so it is a corner of the string
+                if (portal.isLink) {
+                    moveApex(portal.leftX, portal.leftY, i);
+                }
+            }
+            if (points.size() > maxCornerCount) {
+                return points;
+            }
+            // the goal itself may have become the apex when it was the last corner of a side
+            if (!isSame(apexX, apexY, goal.x(), goal.y()) || (points.size() == 1)) {
+                points.push_back(goal);
+            }
+            return points;
+        }
+
+    };
+
+}
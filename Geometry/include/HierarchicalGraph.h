@@ -0,0 +1,83 @@
+/**
+ * Copyright 2019 Márton Gergó
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+#include "SearchNodes.h"
+#include "SearchResult.h"
+#include "TriangleGraph.h"
+#include "TriangleSearch.h"
+
+namespace TpaStarCpp::GeometryLibrary {
+
+    class Vector;
+
+    /*
+     * Abstract layer over a triangle graph for long queries (HPA*). Triangles are partitioned into connected
+     * clusters along a coarse grid. Every run of edges between two clusters is represented by one entrance,
+     * the two triangles on its sides becoming nodes of the abstract graph, with the distances between the nodes of
+     * a cluster measured in advance. A query searches the abstract graph first, then refines the path with a
+     * search restricted to the clusters on the abstract route.
+     * The distances of a cluster only depend on its own triangles, so they are measured in parallel and refreshed
+     * cluster by cluster after triangles are blocked or unblocked. An instance answers one query at a time.
+     * Off-mesh links between two clusters are abstract edges of their own, the ones inside a cluster are only
+     * followed by the refinement.
+     */
+    class HierarchicalGraph {
+
+    private:
+        std::shared_ptr<TriangleGraph> graph_;
+        std::vector<long> clusterIds_;
+        std::vector<long> clusterStarts_;
+        std::vector<long> clusterTriangleIds_;
+        // position of every triangle among the triangles of its cluster
+        std::vector<long> localIds_;
+        std::vector<long> nodeTriangleIds_;
+        std::vector<long> nodeIds_;
+        std::vector<std::vector<long>> clusterNodeIds_;
+        // position of every node among the nodes of its cluster
+        std::vector<long> nodeLocalIds_;
+        std::vector<std::vector<std::pair<long, double>>> interEdges_;
+        // distances between the nodes of each cluster, row by row, infinite if not connected inside the cluster
+        std::vector<std::vector<double>> clusterDistances_;
+        TriangleSearch refinement_;
+        SearchNodes nodes_;
+        std::vector<uint8_t> isClusterOnRoute_;
+
+        void partition(long clusterSize);
+        void findEntrances();
+        long nodeOf(long triangleId);
+        void measureCluster(long clusterId);
+        long measureFrom(long sourceId, std::vector<double>& distances);
+        SearchResult refine(long startId, Vector start, long goalId, Vector goal, long expandedCount);
+
+    public:
+        explicit HierarchicalGraph(std::shared_ptr<TriangleGraph> graph, long clusterSize = 256);
+        long clusterCount() { return clusterStarts_.size() - 1; }
+        long clusterIdOf(long id) { return clusterIds_[id]; }
+        long nodeCount() { return nodeTriangleIds_.size(); }
+        // measures the distances inside the clusters of the triangles again, call it after blocking or unblocking them
+        void refresh(const std::vector<long>& triangleIds);
+        // throws if the start or the goal is not on the mesh
+        SearchResult findPath(Vector start, Vector goal);
+
+    };
+
+}
@@ -0,0 +1,39 @@
+/**
+ * Copyright 2019 Márton Gergó
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace TpaStarCpp::GeometryLibrary {
+
+    /*
+     * Maps points to their position along a Hilbert curve laid over their bounding box.
+     * Points that are close along the curve are close in the plane as well, which is what makes
+     * the resulting order useful for laying out spatially coherent data next to each other in memory.
+     */
+    class HilbertCurve {
+
+    public:
+        static constexpr uint32_t RESOLUTION = 1u << 16u;
+
+        static uint64_t indexOf(uint32_t x, uint32_t y);
+        static std::vector<long> sortedOrder(const std::vector<double>& xs, const std::vector<double>& ys);
+
+    };
+
+}
@@ -0,0 +1,84 @@
+/**
+ * Copyright 2019 Márton Gergó
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <memory>
+#include <vector>
+#include "SearchResult.h"
+#include "TriangleGraph.h"
+#include "Vector.h"
+
+namespace TpaStarCpp::GeometryLibrary {
+
+    /*
+     * D* Lite: the distances to the goal triangle are kept between queries of one agent, so after triangles
+     * are blocked or unblocked only the triangles whose distance changed are expanded again. The search runs
+     * from the goal towards the start, which lets the agent move its start without losing the distances;
+     * the estimates are kept valid by the offset of the start accumulated since the first search.
+     */
+    class IncrementalSearch {
+
+    private:
+        struct OpenEntry {
+            double primaryKey;
+            double secondaryKey;
+            long id;
+        };
+
+        std::shared_ptr<TriangleGraph> graph_;
+        std::vector<double> gScores_;
+        std::vector<double> rhsScores_;
+        // the primary key a triangle is queued with, NaN if it is not on the open list
+        std::vector<double> queuedKeys_;
+        std::vector<OpenEntry> open_;
+        long startId_ = -1;
+        long goalId_ = -1;
+        double startX_ = 0.0;
+        double startY_ = 0.0;
+        double goalX_ = 0.0;
+        double goalY_ = 0.0;
+        // read by the full search, replanning after a triangle got cheaper than that needs a full search again
+        double minCostMultiplier_ = 1.0;
+        double keyOffset_ = 0.0;
+        long expandedCount_ = 0;
+
+        double estimateOf(long id);
+        OpenEntry entryOf(long id);
+        void queue(long id);
+        void updateTriangle(long id);
+        void updatePredecessors(long id);
+        void computeShortestPath();
+        SearchResult buildResult();
+        long locate(Vector point, const char* message);
+        // searches between the current start and goal from scratch
+        SearchResult restart();
+
+    public:
+        explicit IncrementalSearch(std::shared_ptr<TriangleGraph> graph);
+        // a full search that keeps its state, throws if the start or the goal is not on the mesh
+        SearchResult findPath(Vector start, Vector goal);
+        // the agent moved to the specified point, the goal stays, throws if the point is not on the mesh
+        SearchResult moveStart(Vector start);
+        /*
+         * Repairs the distances after the listed triangles were blocked, unblocked or got a new cost multiplier.
+         * Falls back to a full search if a triangle or link got cheaper than any was at the last full search.
+         */
+        SearchResult replan(const std::vector<long>& changedTriangleIds);
+
+    };
+
+}
@@ -0,0 +1,48 @@
+/**
+ * Copyright 2019 Márton Gergó
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <array>
+#include <vector>
+#include "TriangleSkeleton.h"
+
+namespace TpaStarCpp::GeometryLibrary {
+
+    /*
+     * Triangles given by the indices of their corners in a shared vertex buffer, the form meshes are usually
+     * stored and generated in. The corners of every triangle are listed in counter-clockwise order.
+     * Builders that know the adjacency fill in the neighbours as well, otherwise they are left empty.
+     */
+    struct IndexedMesh {
+        std::vector<double> xs;
+        std::vector<double> ys;
+        std::vector<std::array<long, 3>> triangles;
+        // neighbour across the edge between corner k and k+1 of each triangle, -1 on the boundary
+        std::vector<std::array<long, 3>> neighbours;
+        // the height of each vertex, empty for a flat mesh
+        std::vector<double> heights;
+        /*
+         * The floor of each triangle, numbered from 0, empty if the mesh has one floor only. Triangles of the same
+         * layer must not overlap, the floors of a building above each other have to be on different layers.
+         */
+        std::vector<long> layers;
+
+        std::vector<TriangleSkeleton> toTriangleSkeletons() const;
+        void removeUnusedVertices();
+    };
+
+}
@@ -0,0 +1,65 @@
+/**
+ * Copyright 2019 Márton Gergó
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <vector>
+#include "TriangleGraph.h"
+
+namespace TpaStarCpp::GeometryLibrary {
+
+    /*
+     * ALT heuristic: the distances from a few landmark triangles to every triangle, through centroids and
+     * edge midpoints, bound the distance of any two triangles from below by the triangle inequality.
+     * Landmarks are picked one by one as the triangle farthest from the ones picked so far, counted in steps,
+     * and their distances are measured by Dijkstra in parallel. Distances are rounded to 16 bits per landmark,
+     * the rounding error is subtracted from the bound so it never overestimates.
+     * Blocking triangles only makes paths longer, so the bounds stay valid without measuring again.
+     */
+    class LandmarkHeuristic {
+
+    private:
+        std::shared_ptr<TriangleGraph> graph_;
+        std::vector<long> landmarkIds_;
+        // quantization steps per unit of distance, for each landmark
+        std::vector<double> scales_;
+        // the distances of a triangle from all of the landmarks are stored next to each other
+        std::vector<uint16_t> distances_;
+
+        LandmarkHeuristic(std::shared_ptr<TriangleGraph> graph, std::vector<long> landmarkIds);
+        void selectLandmarks(int landmarkCount);
+        void measureDistances();
+
+    public:
+        static constexpr uint16_t UNREACHABLE = 0xFFFF;
+
+        explicit LandmarkHeuristic(std::shared_ptr<TriangleGraph> graph, int landmarkCount = 8);
+        int landmarkCount() { return landmarkIds_.size(); }
+        const std::vector<long>& landmarkIds() { return landmarkIds_; }
+        // never more than the distance between the centroids of the two triangles
+        double estimate(long id, long goalId);
+        // writes the landmarks and their distances in little endian byte order
+        void save(std::ostream& output);
+        // throws if the data is malformed or was measured on a graph of a different size
+        static LandmarkHeuristic load(std::istream& input, std::shared_ptr<TriangleGraph> graph);
+
+    };
+
+}
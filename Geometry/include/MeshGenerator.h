@@ -0,0 +1,44 @@
+/**
+ * Copyright 2019 Márton Gergó
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <random>
+#include "IndexedMesh.h"
+
+namespace TpaStarCpp::GeometryLibrary {
+
+    /*
+     * Deterministic generator of valid triangle meshes for tests and benchmarks. The same seed always
+     * produces the same mesh, with any standard library. Every mesh lies in the [0, columns] x [0, rows] rectangle made up of unit cells.
+     */
+    class MeshGenerator {
+
+    private:
+        std::mt19937_64 random_;
+
+    public:
+        explicit MeshGenerator(unsigned long seed);
+        // unit squares split into two triangles each, with roughly holeRatio of the squares left out
+        IndexedMesh gridWithHoles(long columns, long rows, double holeRatio);
+        // Delaunay triangulation of one jittered point per grid corner, the border points jittered along the border only
+        IndexedMesh randomDelaunay(long columns, long rows);
+        // a perfect maze of one unit wide corridors carved into a (2 * columns + 1) x (2 * rows + 1) grid
+        IndexedMesh corridorMaze(long columns, long rows);
+
+    };
+
+}
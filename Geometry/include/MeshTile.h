@@ -0,0 +1,65 @@
+/**
+ * Copyright 2019 Márton Gergó
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include <istream>
+#include <ostream>
+#include <vector>
+#include "IndexedMesh.h"
+
+namespace TpaStarCpp::GeometryLibrary {
+
+    struct TileCoordinates {
+        long x;
+        long y;
+
+        bool operator==(const TileCoordinates& other) const { return (x == other.x) && (y == other.y); }
+    };
+
+    // an edge on the border of a tile together with the triangle across it in the neighbouring tile
+    struct TilePortal {
+        long id;
+        int edge;
+        TileCoordinates neighbourTile;
+        long neighbourId;
+        int neighbourEdge;
+    };
+
+    /*
+     * A square piece of a mesh too large to be kept in memory at once. Every triangle belongs to the tile its
+     * centroid falls into, so triangles may reach over the border of their tile. The neighbours across the
+     * border are not in the mesh of the tile, its portals name them by their ids in the neighbouring tile,
+     * which stitches two tiles together without matching their edges when both of them are loaded.
+     */
+    struct MeshTile {
+        TileCoordinates coordinates;
+        // the neighbours are known within the tile, -1 across the border of the tile
+        IndexedMesh mesh;
+        // sorted by the ids of the triangles
+        std::vector<TilePortal> portals;
+
+        // the neighbours of the mesh are matched by the corner indices if the mesh does not list them,
+        // throws if the tile size is not positive
+        static std::vector<MeshTile> split(IndexedMesh mesh, double tileSize);
+        // writes the tile in little endian byte order
+        void save(std::ostream& output) const;
+        // throws if the data is malformed
+        static MeshTile load(std::istream& input);
+    };
+
+}
@@ -0,0 +1,36 @@
+/**
+ * Copyright 2019 Márton Gergó
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+namespace TpaStarCpp::GeometryLibrary {
+
+    // a one way connection between two triangles that do not share an edge, like a jump, a ladder or a teleport
+    struct OffMeshLink {
+        long fromId;
+        long toId;
+        // where the link is taken, on the triangle it leaves
+        double entryX;
+        double entryY;
+        // where the link ends, on the triangle it leads to
+        double exitX;
+        double exitY;
+        // the cost of taking the link itself, on top of the walks to and from its ends
+        double cost;
+    };
+
+}
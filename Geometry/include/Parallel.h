@@ -0,0 +1,70 @@
+/**
+ * Copyright 2019 Márton Gergó
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace TpaStarCpp::GeometryLibrary {
+
+    // the number of threads parallelFor starts for the specified count, the calling thread included
+    inline long parallelThreadCount(long count)
+    {
+        return std::max(std::min<long>(std::max(1u, std::thread::hardware_concurrency()), count), 1L);
+    }
+
+    /*
+     * Calls the function for every index below count on all hardware threads. Indices are handed out one by one,
+     * so uneven work per index is balanced. The function must not throw and must only write data owned by its index.
+     * It also gets the number of the thread below parallelThreadCount, to reuse memory owned by the thread.
+     */
+    template <typename Function>
+    void parallelForWithThreadIds(long count, Function function)
+    {
+        auto threadCount = parallelThreadCount(count);
+        if (threadCount <= 1) {
+            for (long i = 0; i < count; i++) {
+                function(i, 0L);
+            }
+            return;
+        }
+        std::atomic<long> nextIndex(0);
+        auto work = [&](long threadId) {
+            for (auto i = nextIndex++; i < count; i = nextIndex++) {
+                function(i, threadId);
+            }
+        };
+        std::vector<std::thread> threads;
+        for (long i = 1; i < threadCount; i++) {
+            threads.emplace_back(work, i);
+        }
+        work(0);
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+
+    // like above, for functions that do not need the number of the thread
+    template <typename Function>
+    void parallelFor(long count, Function function)
+    {
+        parallelForWithThreadIds(count, [&](long i, long) { function(i); });
+    }
+
+}
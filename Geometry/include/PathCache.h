@@ -0,0 +1,97 @@
+/**
+ * Copyright 2019 Márton Gergó
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+#include "Funnel.h"
+#include "TriangleGraph.h"
+#include "TriangleSearch.h"
+#include "Vector.h"
+
+namespace TpaStarCpp::GeometryLibrary {
+
+    /*
+     * Remembers the triangle corridors found between pairs of start and goal triangles, so a repeated query
+     * only pulls the string through the corridor again for its exact endpoints. The pairs are spread over
+     * shards with a lock each, and every shard keeps its share of the capacity, counted in stored triangle ids,
+     * by evicting the entries the clock hand finds unused since its last round.
+     * An entry is dropped when one of its triangles gets blocked, and all entries stored before a triangle was
+     * unblocked or had its cost multiplier changed are dropped too, since a shorter path may have opened.
+     * Clear the cache after editing the mesh.
+     */
+    class PathCache {
+
+    private:
+        struct Entry {
+            long startId;
+            long goalId;
+            std::vector<long> triangleIds;
+            long unblockCount;
+            bool isReferenced;
+        };
+
+        struct Shard {
+            std::mutex mutex;
+            std::unordered_map<uint64_t, long> slotIds;
+            // slots of the clock, free ones have a negative start id
+            std::vector<Entry> entries;
+            std::vector<long> freeSlotIds;
+            long hand = 0;
+            long storedIdCount = 0;
+        };
+
+        std::shared_ptr<TriangleGraph> graph_;
+        Funnel funnel_;
+        long shardCapacity_;
+        std::vector<Shard> shards_;
+        std::atomic<long> hitCount_ { 0 };
+        std::atomic<long> missCount_ { 0 };
+
+        uint64_t keyOf(long startId, long goalId);
+        Shard& shardOf(uint64_t key);
+        bool isValid(const Entry& entry);
+        void remove(Shard& shard, long slotId);
+        void evict(Shard& shard, long idCount);
+        // the unblock count has to be read before the corridor was searched
+        void store(long startId, long goalId, std::vector<long> triangleIds, long unblockCount);
+
+    public:
+        // the capacity is the number of triangle ids the stored corridors may hold together
+        PathCache(std::shared_ptr<TriangleGraph> graph, long capacity, long shardCount = 16);
+        // counts a hit or a miss
+        std::optional<std::vector<long>> findCorridor(long startId, long goalId);
+        // corridors longer than the share of a shard are not stored
+        void store(long startId, long goalId, std::vector<long> triangleIds);
+        /*
+         * The corridor is searched by the specified search on a miss, which has to belong to the calling thread.
+         * Throws if the start or the goal is not on the mesh, returns nothing if the goal cannot be reached.
+         */
+        std::optional<std::vector<Vector>> findPath(Vector start, Vector goal, TriangleSearch& search);
+        void clear();
+        long hitCount() { return hitCount_; }
+        long missCount() { return missCount_; }
+        long storedTriangleIdCount();
+
+    };
+
+}
@@ -0,0 +1,69 @@
+/**
+ * Copyright 2019 Márton Gergó
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <deque>
+#include <memory>
+#include <vector>
+#include "Funnel.h"
+#include "TriangleGraph.h"
+#include "Vector.h"
+
+namespace TpaStarCpp::GeometryLibrary {
+
+    /*
+     * The triangles an agent still has to cross to its goal, kept up to date as the agent moves. A move walks
+     * from the first triangle towards the new position over neighbours, then joins the walk to the corridor
+     * within its first few triangles: moving ahead drops triangles from the front, drifting off the corridor
+     * puts the triangles walked through in front of it. Both are bounded, so a tick costs the same however long
+     * the corridor is, and only the visible corners are pulled through the funnel. The walks follow neighbours,
+     * so the corridor keeps to the layers of its triangles on a mesh of several floors.
+     */
+    class PathCorridor {
+
+    private:
+        std::shared_ptr<TriangleGraph> graph_;
+        Funnel funnel_;
+        std::deque<long> triangleIds_;
+        double positionX_;
+        double positionY_;
+        double goalX_;
+        double goalY_;
+
+        bool walkTowards(double x, double y, std::vector<long>& walkedIds);
+
+    public:
+        // the most triangles a single move may walk over, and look ahead in the corridor to join the walk
+        static constexpr long MAX_WALK_LENGTH = 16;
+        static constexpr long MAX_LOOKAHEAD = 32;
+
+        // throws if the corridor is empty or the position and the goal are not in its first and last triangles
+        PathCorridor(std::shared_ptr<TriangleGraph> graph, const std::vector<long>& triangleIds, Vector position, Vector goal);
+        Vector position() { return Vector(positionX_, positionY_); }
+        Vector goal() { return Vector(goalX_, goalY_); }
+        const std::deque<long>& triangleIds() { return triangleIds_; }
+        /*
+         * False if the position cannot be reached by a short walk over unblocked triangles or the walk does not
+         * meet the corridor, the corridor is left as it was then and the path should be searched again.
+         */
+        bool movePosition(Vector position);
+        // the position followed by at most the specified number of corners of the string, the goal included
+        std::vector<Vector> findCorners(long maxCornerCount);
+
+    };
+
+}
@@ -0,0 +1,53 @@
+/**
+ * Copyright 2019 Márton Gergó
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <memory>
+#include <vector>
+#include "IndexedMesh.h"
+#include "TriangleGraph.h"
+
+namespace TpaStarCpp::GeometryLibrary {
+
+    class Vector;
+
+    /*
+     * Triangulates polygons with holes by a constrained Delaunay triangulation of their boundary rings.
+     * Every ring is a closed chain of corners, the last corner connecting back to the first one. Holes may
+     * also contain further outlines, the inside is whatever is enclosed by an odd number of rings. That count
+     * would open up the overlap of two holes, so overlapping holes are rejected instead of merged: triangulating
+     * throws if two rings cross, a hole lies inside another hole or outside every outline, or an outline lies
+     * inside another outline without a hole between them. Rings may still touch at corners and share edges.
+     * The adjacency of the triangles is known from the triangulation, so the graph is built without matching edges.
+     */
+    class PolygonTriangulator {
+
+    private:
+        std::vector<std::vector<Vector>> rings_;
+        std::vector<bool> isHole_;
+
+        void addRing(std::vector<Vector> ring, bool isHole);
+
+    public:
+        void addOutline(std::vector<Vector> outline);
+        void addHole(std::vector<Vector> hole);
+        IndexedMesh triangulate();
+        std::shared_ptr<TriangleGraph> buildGraph(TriangleOrdering ordering = TriangleOrdering::InputOrder);
+
+    };
+
+}
@@ -0,0 +1,37 @@
+/**
+ * Copyright 2019 Márton Gergó
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <optional>
+#include "Edge.h"
+
+namespace TpaStarCpp::GeometryLibrary {
+
+    struct RaycastResult {
+        // true if the segment stays on the mesh all the way to its endpoint
+        bool reachedEnd;
+        // the triangle containing the endpoint, the one the segment left the mesh from,
+        // or the last one reached by a walk that could not follow the segment any further
+        long lastTriangleId;
+        // number of triangles touched by the segment including the first and the last one
+        long visitedTriangleCount;
+        // the boundary edge the segment left the mesh through, if it did
+        std::optional<Edge> hitEdge;
+        std::optional<Vector> hitPoint;
+    };
+
+}
@@ -0,0 +1,125 @@
+/**
+ * Copyright 2019 Márton Gergó
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace TpaStarCpp::GeometryLibrary {
+
+    /*
+     * The per node state of a best first search together with its open list. The arrays are allocated once and
+     * tagged with the number of the search that last wrote them, so starting a new search does not clear them.
+     * One instance belongs to one search running on one thread.
+     */
+    class SearchNodes {
+
+    private:
+        struct OpenEntry {
+            double f;
+            long id;
+        };
+
+        std::vector<double> gScores_;
+        std::vector<long> parentIds_;
+        std::vector<uint32_t> visitedSearches_;
+        std::vector<uint32_t> closedSearches_;
+        uint32_t search_ = 0;
+        std::vector<OpenEntry> open_;
+
+        static bool isLater(const OpenEntry& lhs, const OpenEntry& rhs) { return lhs.f > rhs.f; }
+
+    public:
+        explicit SearchNodes(long count = 0) :
+            gScores_(count),
+            parentIds_(count),
+            visitedSearches_(count, 0),
+            closedSearches_(count, 0)
+        {
+        }
+
+        void start()
+        {
+            open_.clear();
+            if (++search_ == 0) {
+                // the counter wrapped around, older tags could be mistaken for the current search
+                std::fill(begin(visitedSearches_), end(visitedSearches_), 0);
+                std::fill(begin(closedSearches_), end(closedSearches_), 0);
+                search_ = 1;
+            }
+        }
+
+        long size() { return gScores_.size(); }
+        bool isVisited(long id) { return visitedSearches_[id] == search_; }
+        bool isClosed(long id) { return closedSearches_[id] == search_; }
+        double gScoreOf(long id) { return gScores_[id]; }
+        long parentIdOf(long id) { return parentIds_[id]; }
+
+        // records a new best path to the node, opening it again if it was closed
+        void visit(long id, double g, long parentId)
+        {
+            visitedSearches_[id] = search_;
+            closedSearches_[id] = 0;
+            gScores_[id] = g;
+            parentIds_[id] = parentId;
+        }
+
+        void close(long id) { closedSearches_[id] = search_; }
+
+        void push(double f, long id)
+        {
+            open_.push_back({ f, id });
+            std::push_heap(begin(open_), end(open_), isLater);
+        }
+
+        // drops the entries of closed nodes from the top of the open list, true if an open node is left
+        bool hasOpen()
+        {
+            while (!open_.empty() && isClosed(open_.front().id)) {
+                std::pop_heap(begin(open_), end(open_), isLater);
+                open_.pop_back();
+            }
+            return !open_.empty();
+        }
+
+        // the lowest f on the open list, valid after hasOpen returned true
+        double minF() { return open_.front().f; }
+        long openSize() { return open_.size(); }
+
+        long pop()
+        {
+            std::pop_heap(begin(open_), end(open_), isLater);
+            auto id = open_.back().id;
+            open_.pop_back();
+            return id;
+        }
+
+        // the nodes from the first one of the search to the specified one
+        std::vector<long> pathTo(long id)
+        {
+            std::vector<long> ids;
+            for (; id >= 0; id = parentIds_[id]) {
+                ids.push_back(id);
+            }
+            std::reverse(begin(ids), end(ids));
+            return ids;
+        }
+
+    };
+
+}
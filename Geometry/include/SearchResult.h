@@ -0,0 +1,40 @@
+/**
+ * Copyright 2019 Márton Gergó
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <limits>
+#include <vector>
+
+namespace TpaStarCpp::GeometryLibrary {
+
+    struct SearchResult {
+        // false if the goal cannot be reached from the start
+        bool isFound;
+        // the triangles from the one under the start to the one under the goal
+        std::vector<long> triangleIds;
+        // from the start through the centroids of the triangles and the midpoints of the edges crossed to the goal
+        double cost;
+        // number of nodes taken off the open list, the work a search has done
+        long expandedCount;
+
+        static SearchResult notFound(long expandedCount)
+        {
+            return SearchResult { false, {}, std::numeric_limits<double>::infinity(), expandedCount };
+        }
+    };
+
+}
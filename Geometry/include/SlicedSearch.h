@@ -0,0 +1,80 @@
+/**
+ * Copyright 2019 Márton Gergó
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include "SearchNodes.h"
+#include "SearchResult.h"
+#include "TriangleGraph.h"
+#include "Vector.h"
+
+namespace TpaStarCpp::GeometryLibrary {
+
+    enum class SearchState {
+        Idle,
+        Running,
+        Found,
+        NotFound,
+        Cancelled
+    };
+
+    /*
+     * The triangle search as a state machine that can be run in slices of a number of expansions or of a time
+     * budget, so a long search can be spread over several ticks. The open list and the node arrays stay as
+     * they are between slices. Cancelling gives the path to the expanded triangle that got the closest to the
+     * goal. Blocking triangles while a search is running is not supported, start it again instead.
+     */
+    class SlicedSearch {
+
+    private:
+        std::shared_ptr<TriangleGraph> graph_;
+        SearchNodes nodes_;
+        SearchState state_ = SearchState::Idle;
+        long startId_ = -1;
+        long goalId_ = -1;
+        double goalX_ = 0.0;
+        double goalY_ = 0.0;
+        double goalCost_ = 0.0;
+        // read when the search starts, so the estimates stay consistent while it runs
+        double minCostMultiplier_ = 1.0;
+        long closestId_ = -1;
+        double closestDistance_ = 0.0;
+        long expandedCount_ = 0;
+        SearchResult result_ = SearchResult::notFound(0);
+
+        double estimateOf(long id);
+        void expandNext();
+
+    public:
+        explicit SlicedSearch(std::shared_ptr<TriangleGraph> graph);
+        // drops the search in progress, throws if the start or the goal is not on the mesh
+        void start(Vector start, Vector goal);
+        // expands at most the specified number of triangles
+        SearchState step(long maxExpandedCount);
+        // expands until the budget runs out, at least one triangle so every slice makes progress
+        SearchState stepFor(std::chrono::microseconds budget);
+        SearchState state() { return state_; }
+        long expandedCount() { return expandedCount_; }
+        // the path when the search has finished, the best partial path when it was cancelled
+        const SearchResult& result() { return result_; }
+        // stops a running search and returns the path to the triangle closest to the goal, not marked as found
+        const SearchResult& cancel();
+
+    };
+
+}
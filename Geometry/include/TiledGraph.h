@@ -0,0 +1,122 @@
+/**
+ * Copyright 2019 Márton Gergó
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <istream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "MeshTile.h"
+#include "TriangleGraph.h"
+#include "Vector.h"
+
+namespace TpaStarCpp::GeometryLibrary {
+
+    // opens the saved data of a tile, or returns nullptr if the map has no tile there
+    using TileSource = std::function<std::unique_ptr<std::istream>(long tileX, long tileY)>;
+
+    /*
+     * A map split into square tiles of which only some are kept in memory. Tiles are loaded from their source
+     * on a background thread and the least recently used ones are unloaded once the resident tiles hold more
+     * triangles than the budget allows, except for the tile loaded last. A search keeps the tiles it has found
+     * alive until it lets them go, so unloading never pulls a tile from under a running search.
+     * The graphs of the tiles hold the geometry only, cost multipliers and off-mesh links are not tiled.
+     */
+    class TiledGraph {
+
+    public:
+        struct Tile {
+            TileCoordinates coordinates;
+            std::shared_ptr<TriangleGraph> graph;
+            // the portals of triangle id are portals[firstPortalIndices[id]] up to portals[firstPortalIndices[id + 1]]
+            std::vector<TilePortal> portals;
+            std::vector<long> firstPortalIndices;
+        };
+
+    private:
+        struct ResidentTile {
+            std::shared_ptr<const Tile> tile;
+            long lastUse;
+        };
+
+        TileSource source_;
+        double tileSize_;
+        long maxResidentTriangleCount_;
+        std::mutex mutex_;
+        std::condition_variable hasRequest_;
+        std::condition_variable isIdle_;
+        std::unordered_map<uint64_t, ResidentTile> tiles_;
+        // requested tiles stay pending until they are loaded or found unavailable
+        std::deque<TileCoordinates> requests_;
+        std::unordered_set<uint64_t> pendingTiles_;
+        // the source had no tile there, it is never asked again
+        std::unordered_set<uint64_t> unavailableTiles_;
+        // reading the tile threw, it is read again when it is requested the next time
+        std::unordered_set<uint64_t> failedTiles_;
+        long residentTriangleCount_ = 0;
+        long useCount_ = 0;
+        bool isStopping_ = false;
+        // started last, once everything it uses is initialized
+        std::thread loader_;
+
+        static uint64_t keyOf(TileCoordinates coordinates);
+        static std::shared_ptr<const Tile> buildTile(MeshTile meshTile);
+        void runLoader();
+        std::shared_ptr<const Tile> readTile(TileCoordinates coordinates);
+        void insert(std::shared_ptr<const Tile> tile);
+        void evictLeastRecent();
+
+    public:
+        // throws if the tile size is not positive or the budget is negative
+        TiledGraph(TileSource source, double tileSize, long maxResidentTriangleCount);
+        // waits for the tile being loaded, the remaining requests are dropped
+        ~TiledGraph();
+        TiledGraph(const TiledGraph&) = delete;
+        TiledGraph& operator=(const TiledGraph&) = delete;
+
+        double tileSize() { return tileSize_; }
+        TileCoordinates tileOf(Vector point);
+        // queues the tile for the background thread unless it is resident, pending or unavailable, failed tiles are retried
+        void requestTile(TileCoordinates coordinates);
+        // loads the tile on the calling thread, returns false if the source has no tile there, throws if its data is malformed
+        bool loadTile(TileCoordinates coordinates);
+        // blocks until the background thread has handled every request
+        void waitUntilIdle();
+        void unloadTile(TileCoordinates coordinates);
+        // unloads the least recently used tiles until the rest holds at most the specified number of triangles
+        void releaseMemory(long maxTriangleCount);
+        // returns nullptr if the tile is not resident, otherwise marks it as used
+        std::shared_ptr<const Tile> findTile(TileCoordinates coordinates);
+        bool isResident(TileCoordinates coordinates);
+        // true for tiles the source does not have
+        bool isUnavailable(TileCoordinates coordinates);
+        // true for tiles whose last read threw, until they are loaded
+        bool hasFailed(TileCoordinates coordinates);
+        long residentTileCount();
+        long residentTriangleCount();
+
+    };
+
+}
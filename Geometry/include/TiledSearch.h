@@ -0,0 +1,84 @@
+/**
+ * Copyright 2019 Márton Gergó
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include "MeshTile.h"
+#include "TiledGraph.h"
+#include "Vector.h"
+
+namespace TpaStarCpp::GeometryLibrary {
+
+    struct TileTriangle {
+        TileCoordinates tile;
+        long id;
+    };
+
+    struct TiledSearchResult {
+        // false if the goal cannot be reached through the resident tiles
+        bool isFound;
+        // the triangles from the one under the start to the one under the goal
+        std::vector<TileTriangle> triangles;
+        // measured the same way as by the triangle search, across the borders of the tiles as well
+        double cost;
+        long expandedCount;
+        /*
+         * The tiles the search reached but found not resident, the path may lead through them even if one was found.
+         * Request them and search again once they are loaded.
+         */
+        std::vector<TileCoordinates> missingTiles;
+    };
+
+    /*
+     * A* over the triangles of the resident tiles of a tiled graph, crossing from one tile to the next through
+     * the portals. The tiles are looked up once per search and held until it returns. The node storage is reused,
+     * so an instance is meant to be used by one thread at a time.
+     */
+    class TiledSearch {
+
+    private:
+        struct Node {
+            double gScore;
+            uint64_t parentKey;
+            bool isClosed;
+        };
+
+        std::shared_ptr<TiledGraph> graph_;
+        std::vector<std::shared_ptr<const TiledGraph::Tile>> tiles_;
+        // the slots of the tiles in tiles_, -1 for those not resident
+        std::unordered_map<uint64_t, long> tileSlots_;
+        std::vector<TileCoordinates> missingTiles_;
+        std::unordered_map<uint64_t, Node> nodes_;
+
+        long slotOf(TileCoordinates coordinates);
+        // the node key of the triangle under the point, -1 if there is none in the resident tiles around it
+        int64_t locate(Vector point);
+        void release();
+
+    public:
+        explicit TiledSearch(std::shared_ptr<TiledGraph> graph);
+        // throws if the start or the goal is not on a resident tile and none of the tiles around it is missing
+        TiledSearchResult findPath(Vector start, Vector goal);
+
+    };
+
+}
@@ -16,8 +16,19 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
 #include <vector>
 #include <memory>
+#include <optional>
+#include "TriangleMetadata.h"
+#include "RaycastResult.h"
+#include "NearestPoint.h"
+#include "TriangleGrid.h"
+#include "IndexedMesh.h"
+#include "OffMeshLink.h"
 
 namespace TpaStarCpp::GeometryLibrary {
 
@@ -25,20 +36,187 @@ namespace TpaStarCpp::GeometryLibrary {
     class Triangle;
     class Vector;
 
+    enum class TriangleOrdering {
+        InputOrder,
+        HilbertCurve
+    };
+
     class TriangleGraph : public std::enable_shared_from_this<TriangleGraph> {
 
     private:
         std::vector<TriangleSkeleton> triangles_;
         std::vector<std::vector<long>> neighbourIds_;
+        std::vector<std::array<long, 3>> edgeNeighbourIds_;
+        std::vector<float> costMultipliers_;
+        double minCostMultiplier_ = 1.0;
+        // the links leaving and entering each triangle are chained through the ids of the next ones, -1 at the end
+        std::vector<OffMeshLink> links_;
+        std::vector<double> linkCosts_;
+        std::vector<long> firstOutgoingLinkIds_;
+        std::vector<long> nextOutgoingLinkIds_;
+        std::vector<long> firstIncomingLinkIds_;
+        std::vector<long> nextIncomingLinkIds_;
+        double minLinkCostRatio_ = std::numeric_limits<double>::infinity();
+        std::vector<TriangleMetadata> metadata_;
+        std::vector<std::array<long, 3>> vertexIds_;
+        std::vector<long> externalIds_;
+        std::vector<long> internalIds_;
+        TriangleGrid grid_;
+        // the height of each vertex and the layer of each triangle, empty for flat meshes of one layer
+        std::vector<double> heights_;
+        std::vector<long> layers_;
+        long layerCount_ = 1;
+        // a grid of its own for each layer, listing the graph ids of its triangles, empty for a single layer
+        std::vector<TriangleGrid> layerGrids_;
+        std::vector<std::vector<long>> layerTriangleIds_;
+        std::vector<std::array<double, 3>> crossingCosts_;
+        std::vector<uint8_t> isBlocked_;
+        long unblockCount_ = 0;
+        std::vector<uint8_t> isObstacleVertex_;
+        std::vector<std::array<float, 3>> clearances_;
 
-        long determineIdOfTriangleUnderPoint(Vector point);
+        void weldVertices();
+        void findNeighbours();
+        void takeNeighbours(std::vector<std::array<long, 3>> edgeNeighbourIds);
+        void buildIndices(TriangleOrdering ordering);
+        void buildLayerIndices();
+        void sortAlongHilbertCurve();
+        void measureCrossingCosts();
+        double measureCrossingCost(long id, int edge);
+        double measureLinkCost(long linkId);
+        void measureClearances();
+        double searchWidth(Vector corner, long id, int edge, double width, int depth);
+        int edgeTowards(long id, long neighbourId);
         Triangle buildTriangleFromId(long id);
+        std::optional<NearestPoint> findNearestPointOnLayer(Vector point, double maxRadius, long layer);
 
     public:
-        explicit TriangleGraph(std::vector<TriangleSkeleton> triangles);
+        explicit TriangleGraph(std::vector<TriangleSkeleton> triangles,
+                TriangleOrdering ordering = TriangleOrdering::InputOrder);
+        /*
+         * Takes the adjacency from the mesh when it is known, otherwise the corners are matched by their indices.
+         * Throws if the heights or the layers are given but not for every vertex or triangle, or a layer is negative.
+         */
+        explicit TriangleGraph(IndexedMesh mesh, TriangleOrdering ordering = TriangleOrdering::InputOrder);
         bool containsPoint(Vector point);
         Triangle getTriangleUnder(Vector point);
         std::vector<Triangle> getNeighbours(Triangle triangle);
+        /*
+         * Return nothing instead of throwing for points off the mesh and unknown triangles. The triangles built
+         * still need the graph owned by a shared_ptr, and the neighbours are allocated, so they are not noexcept.
+         */
+        std::optional<Triangle> tryGetTriangleUnder(Vector point);
+        std::optional<std::vector<Triangle>> tryGetNeighbours(Triangle triangle);
+        // returns -1 for points not contained by any triangle, any of the triangles above each other on several layers
+        long findIdOfTriangleUnder(Vector point) noexcept;
+        // the triangle under the point whose surface is vertically the nearest to the height, -1 if there is none
+        long findIdOfTriangleUnder(Vector point, double height) noexcept;
+        // returns -1 if no triangle of the layer contains the point
+        long findIdOfTriangleUnderOnLayer(Vector point, long layer) noexcept;
+        long layerOf(long id) { return layers_.empty() ? 0 : layers_[id]; }
+        long layerCount() { return layerCount_; }
+        // the height of the plane of the triangle above the point, interpolated between the heights of its corners
+        double heightAt(long id, Vector point);
+        // the point location test of a single triangle, for walks over neighbours
+        bool triangleContains(long id, Vector point);
+        long triangleCount();
+        const TriangleMetadata& metadataOf(long id) { return metadata_[id]; }
+        const std::vector<long>& neighbourIdsOf(long id) { return neighbourIds_[id]; }
+        // the neighbour sharing the edge between corner `edge` and the next corner, or -1 on the boundary
+        long neighbourIdAcross(long id, int edge) { return edgeNeighbourIds_[id][edge]; }
+        Vector cornerOf(long id, int corner);
+        // the distance from the centroid through the midpoint of the edge to the centroid of the neighbour across it,
+        // each half weighted by the cost multiplier of its triangle
+        double crossingCostOf(long id, int edge) { return crossingCosts_[id][edge]; }
+        // the cost of a straight step between two points of the triangle
+        double costWithin(long id, Vector from, Vector to);
+        // the cost of moving through the triangle relative to the distance covered, 1 unless set otherwise
+        double costMultiplierOf(long id) { return costMultipliers_[id]; }
+        /*
+         * Throws if the multiplier is not positive and finite. Landmarks and hierarchies measure the costs when they
+         * are built, they have to be built again once a triangle got cheaper.
+         */
+        void setCostMultiplier(long id, double multiplier);
+        // straight line distances scaled by the lowest multiplier never overestimate a cost,
+        // links cheaper than the distance they bridge lower it further
+        double minCostMultiplier() { return std::min(minCostMultiplier_, minLinkCostRatio_); }
+        /*
+         * Connects the triangle under the entry point to the one under the exit point in that direction only,
+         * the way back is another link. Throws if either point is off the mesh or the cost is negative.
+         * On a mesh of several layers any of the triangles above each other may be taken, use the other overload.
+         */
+        long addOffMeshLink(Vector entry, Vector exit, double cost);
+        // throws if the triangles do not contain the entry and the exit point or the cost is negative
+        long addOffMeshLink(long fromId, Vector entry, long toId, Vector exit, double cost);
+        long offMeshLinkCount() { return links_.size(); }
+        const OffMeshLink& offMeshLinkOf(long linkId) { return links_[linkId]; }
+        // from the centroid of the triangle it leaves through the link to the centroid of the one it leads to
+        double linkCostOf(long linkId) { return linkCosts_[linkId]; }
+        // the cheapest link from one triangle to the other, -1 if there is none
+        long findOffMeshLink(long fromId, long toId);
+
+        // visits the triangles one step away with the cost of the step, across the edges first and then the links
+        template <typename Visitor>
+        void forEachStepFrom(long id, Visitor visit)
+        {
+            for (int edge = 0; edge < 3; edge++) {
+                auto neighbour = edgeNeighbourIds_[id][edge];
+                if (neighbour >= 0) {
+                    visit(neighbour, crossingCosts_[id][edge]);
+                }
+            }
+            forEachLinkFrom(id, visit);
+        }
+
+        // visits the triangles the links of the specified one lead to, with the costs of the links
+        template <typename Visitor>
+        void forEachLinkFrom(long id, Visitor visit)
+        {
+            for (auto link = firstOutgoingLinkIds_[id]; link >= 0; link = nextOutgoingLinkIds_[link]) {
+                visit(links_[link].toId, linkCosts_[link]);
+            }
+        }
+
+        // visits the triangles the specified one is one step away from, for searches running backwards
+        template <typename Visitor>
+        void forEachStepTo(long id, Visitor visit)
+        {
+            for (int edge = 0; edge < 3; edge++) {
+                auto neighbour = edgeNeighbourIds_[id][edge];
+                if (neighbour >= 0) {
+                    visit(neighbour, crossingCosts_[id][edge]);
+                }
+            }
+            for (auto link = firstIncomingLinkIds_[id]; link >= 0; link = nextIncomingLinkIds_[link]) {
+                visit(links_[link].fromId, linkCosts_[link]);
+            }
+        }
+        // blocked triangles stay in the graph for point location but are never entered by searches
+        bool isBlocked(long id) { return isBlocked_[id] != 0; }
+        void setBlocked(long id, bool isBlocked);
+        // true if the corner lies on the boundary of the mesh, agents have to keep their distance from it
+        bool isObstacleCorner(long id, int corner) { return isObstacleVertex_[vertexIds_[id][corner]] != 0; }
+        /*
+         * The widest agent that can pass through the triangle between the two edges meeting at the corner, the
+         * distance from the corner to the nearest obstacle on the other side of the triangle. Infinite for corners
+         * that are not obstacles. Measured once at build time, blocked triangles do not narrow it.
+         */
+        double clearanceOf(long id, int corner) { return clearances_[id][corner]; }
+        // grows whenever a blocked triangle is unblocked or the cost multiplier of a triangle changes,
+        // paths found before may no longer be the shortest ones
+        long unblockCount() { return unblockCount_; }
+        // starts from any of the triangles under the start point, the ray then stays on the layer of that triangle
+        RaycastResult raycast(Vector start, Vector end);
+        // throws if the triangle does not contain the start point
+        RaycastResult raycast(long startId, Vector start, Vector end);
+        /*
+         * Returns nothing if no triangle is within the radius, the triangle found needs the graph owned by a shared_ptr.
+         * Every layer is searched, the second overload throws if the layer does not exist and keeps to that one.
+         */
+        std::optional<NearestPoint> findNearestPoint(Vector point, double maxRadius);
+        std::optional<NearestPoint> findNearestPoint(Vector point, double maxRadius, long layer);
+        long externalIdOf(long id);
+        long internalIdOf(long externalId);
 
     };
 
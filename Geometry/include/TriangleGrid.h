@@ -0,0 +1,84 @@
+/**
+ * Copyright 2019 Márton Gergó
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <vector>
+#include "TriangleMetadata.h"
+
+namespace TpaStarCpp::GeometryLibrary {
+
+    /*
+     * Uniform grid over the bounding boxes of triangles. Each cell lists the triangles whose bounding box
+     * overlaps it, stored back to back in a single array, so a lookup touches one cell range only.
+     * The cell size is chosen to hold about two triangles of average size.
+     */
+    class TriangleGrid {
+
+    private:
+        double minX_ = 0.0;
+        double minY_ = 0.0;
+        double cellSize_ = 1.0;
+        long columns_ = 0;
+        long rows_ = 0;
+        std::vector<long> cellStarts_;
+        std::vector<long> triangleIds_;
+
+        long columnOf(double x) const;
+        long rowOf(double y) const;
+
+    public:
+        TriangleGrid() = default;
+        explicit TriangleGrid(const std::vector<TriangleMetadata>& metadata);
+
+        // returns the first triangle in the cell of the point accepted by the predicate, or -1
+        template <typename Predicate>
+        long findTriangleAt(double x, double y, Predicate accepts) const
+        {
+            if (columns_ == 0) {
+                return -1;
+            }
+            auto cell = rowOf(y) * columns_ + columnOf(x);
+            for (auto i = cellStarts_[cell]; i < cellStarts_[cell + 1]; i++) {
+                if (accepts(triangleIds_[i])) {
+                    return triangleIds_[i];
+                }
+            }
+            return -1;
+        }
+
+        // visits the triangles of every cell overlapping the box, triangles spanning several cells more than once
+        template <typename Visitor>
+        void forEachTriangleOverlapping(double minX, double minY, double maxX, double maxY, Visitor visit) const
+        {
+            if (columns_ == 0) {
+                return;
+            }
+            auto lastColumn = columnOf(maxX);
+            auto lastRow = rowOf(maxY);
+            for (auto row = rowOf(minY); row <= lastRow; row++) {
+                for (auto column = columnOf(minX); column <= lastColumn; column++) {
+                    auto cell = row * columns_ + column;
+                    for (auto i = cellStarts_[cell]; i < cellStarts_[cell + 1]; i++) {
+                        visit(triangleIds_[i]);
+                    }
+                }
+            }
+        }
+
+    };
+
+}
@@ -0,0 +1,46 @@
+/**
+ * Copyright 2019 Márton Gergó
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "TriangleSkeleton.h"
+
+namespace TpaStarCpp::GeometryLibrary {
+
+    /*
+     * Geometric properties of a triangle that are derived from its corners only once, when the graph is built.
+     * Edge k lies between corner k and corner k+1, that is a-b, b-c and c-a in that order.
+     * The record is exactly two cache lines long, so reading it is a single indexed load.
+     */
+    struct alignas(64) TriangleMetadata {
+        double centroidX;
+        double centroidY;
+        double minX;
+        double minY;
+        double maxX;
+        double maxY;
+        double area;
+        double edgeLengths[3];
+        double edgeMidpointsX[3];
+        double edgeMidpointsY[3];
+
+        static TriangleMetadata of(TriangleSkeleton triangle);
+        Vector centroid() const;
+        Vector edgeMidpoint(int edge) const;
+        bool boundingBoxContains(Vector point) const;
+    };
+
+}
@@ -0,0 +1,126 @@
+/**
+ * Copyright 2019 Márton Gergó
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "SearchNodes.h"
+#include "SearchResult.h"
+#include "TriangleGraph.h"
+#include "Vector.h"
+
+namespace TpaStarCpp::GeometryLibrary {
+
+    class LandmarkHeuristic;
+
+    /*
+     * A* over the triangles of a graph, stepping from centroid to centroid through the midpoints of the edges.
+     * The straight line distance from the centroid to the goal, scaled by the lowest cost multiplier of the graph,
+     * never overestimates such steps, so the first time the goal triangle is taken off the open list its path is
+     * the shortest one. Off-mesh links are followed like the edges.
+     * The node arrays are reused by the following searches, so an instance is meant to be used by one thread at a time.
+     */
+    class TriangleSearch {
+
+    private:
+        std::shared_ptr<TriangleGraph> graph_;
+        SearchNodes nodes_;
+
+        long locate(Vector point, const char* message);
+
+    public:
+        explicit TriangleSearch(std::shared_ptr<TriangleGraph> graph);
+        /*
+         * Throws if the start or the goal is not on the mesh. On a mesh of several layers any of the triangles above
+         * each other may be taken, locate them by their heights and search between their ids instead.
+         */
+        SearchResult findPath(Vector start, Vector goal);
+
+        // throws if the start or the goal is not on the mesh
+        SearchResult findPath(Vector start, Vector goal, LandmarkHeuristic& landmarks);
+
+        /*
+         * Weighted A*: the straight line estimate is multiplied by the bound, so the search heads for the goal
+         * more greedily and the path may cost up to bound times the shortest one. Throws if the bound is below 1
+         * or the start or the goal is not on the mesh.
+         */
+        SearchResult findBoundedPath(Vector start, Vector goal, double bound);
+
+        // searches only the triangles accepted by the filter, the triangles of the start and the goal included
+        template <typename Filter>
+        SearchResult findPath(long startId, Vector start, long goalId, Vector goal, Filter isAllowed)
+        {
+            auto goalX = goal.x();
+            auto goalY = goal.y();
+            auto minMultiplier = graph_->minCostMultiplier();
+            return findPath(startId, start, goalId, goal, isAllowed, [&](long id) {
+                auto& metadata = graph_->metadataOf(id);
+                return minMultiplier * std::hypot(metadata.centroidX - goalX, metadata.centroidY - goalY);
+            });
+        }
+
+        /*
+         * The heuristic estimates the cost from the centroid of a triangle to the goal point and must not overestimate it.
+         * Triangles reached again on a shorter path are reopened, so heuristics that are admissible but not
+         * consistent, like rounded landmark distances, still give the shortest path.
+         */
+        template <typename Filter, typename Heuristic>
+        SearchResult findPath(long startId, Vector start, long goalId, Vector goal, Filter isAllowed, Heuristic heuristicOf)
+        {
+            if (graph_->isBlocked(startId) || graph_->isBlocked(goalId) || !isAllowed(startId) || !isAllowed(goalId)) {
+                return SearchResult::notFound(0);
+            }
+            if (startId == goalId) {
+                return SearchResult { true, { startId }, graph_->costWithin(startId, start, goal), 1 };
+            }
+            nodes_.start();
+            // the goal triangle is estimated by its exact remaining cost, so it is only taken off the open list
+            // when no other path can be shorter
+            auto goalCost = graph_->costWithin(goalId, graph_->metadataOf(goalId).centroid(), goal);
+            auto estimateOf = [&](long id) { return (id == goalId) ? goalCost : heuristicOf(id); };
+            auto startCost = graph_->costWithin(startId, start, graph_->metadataOf(startId).centroid());
+            nodes_.visit(startId, startCost, -1);
+            nodes_.push(startCost + estimateOf(startId), startId);
+
+            long expandedCount = 0;
+            while (nodes_.hasOpen()) {
+                auto id = nodes_.pop();
+                nodes_.close(id);
+                expandedCount++;
+                if (id == goalId) {
+                    return SearchResult { true, nodes_.pathTo(goalId), nodes_.gScoreOf(goalId) + goalCost, expandedCount };
+                }
+                graph_->forEachStepFrom(id, [&](long neighbour, double cost) {
+                    if (graph_->isBlocked(neighbour) || !isAllowed(neighbour)) {
+                        return;
+                    }
+                    auto g = nodes_.gScoreOf(id) + cost;
+                    if (!nodes_.isVisited(neighbour) || (g < nodes_.gScoreOf(neighbour))) {
+                        nodes_.visit(neighbour, g, id);
+                        nodes_.push(g + estimateOf(neighbour), neighbour);
+                    }
+                });
+            }
+            return SearchResult::notFound(expandedCount);
+        }
+
+    };
+
+}
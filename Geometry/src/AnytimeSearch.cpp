@@ -0,0 +1,209 @@
+/**
+ * Copyright 2019 Márton Gergó
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <AnytimeSearch.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+using namespace TpaStarCpp::GeometryLibrary;
+
+namespace {
+
+    template <typename Entry>
+    bool isLater(const Entry& lhs, const Entry& rhs) { return lhs.key > rhs.key; }
+
+}
+
+AnytimeSearch::AnytimeSearch(std::shared_ptr<TriangleGraph> graph, double initialWeight, double weightStep) :
+    graph_(std::move(graph)),
+    initialWeight_(initialWeight),
+    weightStep_(weightStep),
+    nodes_(graph_->triangleCount()),
+    closedPasses_(graph_->triangleCount(), 0),
+    openPasses_(graph_->triangleCount(), 0),
+    inconsistentPasses_(graph_->triangleCount(), 0)
+{
+    if (!(initialWeight >= 1.0)) {
+        throw std::invalid_argument("The initial weight must be at least 1");
+    }
+    if (!(weightStep > 0.0)) {
+        throw std::invalid_argument("The weight step must be positive");
+    }
+}
+
+double AnytimeSearch::estimateOf(long id)
+{
+    auto& metadata = graph_->metadataOf(id);
+    return minCostMultiplier_ * std::hypot(metadata.centroidX - goalX_, metadata.centroidY - goalY_);
+}
+
+void AnytimeSearch::push(long id)
+{
+    openPasses_[id] = pass_;
+    open_.push_back({ nodes_.gScoreOf(id) + weight_ * estimateOf(id), id });
+    std::push_heap(begin(open_), end(open_), isLater<OpenEntry>);
+}
+
+// Moves the triangles waiting for the next pass to the open list and orders all of them by the new weight
+void AnytimeSearch::startPass()
+{
+    std::vector<long> openIds;
+    auto previousPass = pass_;
+    for (auto& entry : open_) {
+        if ((openPasses_[entry.id] == previousPass) && (closedPasses_[entry.id] != previousPass)) {
+            openIds.push_back(entry.id);
+        }
+    }
+    for (auto id : inconsistentIds_) {
+        openIds.push_back(id);
+    }
+    inconsistentIds_.clear();
+    if (++pass_ == 0) {
+        std::fill(begin(closedPasses_), end(closedPasses_), 0);
+        std::fill(begin(openPasses_), end(openPasses_), 0);
+        std::fill(begin(inconsistentPasses_), end(inconsistentPasses_), 0);
+        pass_ = 1;
+    }
+    open_.clear();
+    for (auto id : openIds) {
+        if (openPasses_[id] != pass_) {
+            push(id);
+        }
+    }
+}
+
+// Expands until no triangle on the open list could lead to a path cheaper than the current one
+void AnytimeSearch::improvePath()
+{
+    auto pathCost = result_.isFound ? result_.cost : std::numeric_limits<double>::infinity();
+    while (!open_.empty()) {
+        auto entry = open_.front();
+        auto id = entry.id;
+        if ((closedPasses_[id] == pass_) || (openPasses_[id] != pass_)) {
+            std::pop_heap(begin(open_), end(open_), isLater<OpenEntry>);
+            open_.pop_back();
+            continue;
+        }
+        if (entry.key >= pathCost) {
+            break;
+        }
+        std::pop_heap(begin(open_), end(open_), isLater<OpenEntry>);
+        open_.pop_back();
+        closedPasses_[id] = pass_;
+        openPasses_[id] = 0;
+        expandedCount_++;
+        auto g = nodes_.gScoreOf(id);
+        if ((id == goalId_) && (g + goalCost_ < pathCost)) {
+            pathCost = g + goalCost_;
+            result_ = SearchResult { true, nodes_.pathTo(id), pathCost, expandedCount_ };
+        }
+        graph_->forEachStepFrom(id, [&](long neighbour, double cost) {
+            auto neighbourG = g + cost;
+            if (graph_->isBlocked(neighbour) || (nodes_.isVisited(neighbour) && (neighbourG >= nodes_.gScoreOf(neighbour)))) {
+                return;
+            }
+            nodes_.visit(neighbour, neighbourG, id);
+            if (closedPasses_[neighbour] != pass_) {
+                push(neighbour);
+            } else if (inconsistentPasses_[neighbour] != pass_) {
+                inconsistentPasses_[neighbour] = pass_;
+                inconsistentIds_.push_back(neighbour);
+            }
+        });
+    }
+    result_.expandedCount = expandedCount_;
+}
+
+// The lowest unweighted f of the unfinished triangles bounds the shortest path from below
+void AnytimeSearch::updateBound()
+{
+    if (!result_.isFound) {
+        bound_ = std::numeric_limits<double>::infinity();
+        return;
+    }
+    auto lowestF = result_.cost;
+    for (auto& entry : open_) {
+        if ((openPasses_[entry.id] == pass_) && (closedPasses_[entry.id] != pass_)) {
+            lowestF = std::min(lowestF, nodes_.gScoreOf(entry.id) + estimateOf(entry.id));
+        }
+    }
+    for (auto id : inconsistentIds_) {
+        lowestF = std::min(lowestF, nodes_.gScoreOf(id) + estimateOf(id));
+    }
+    bound_ = std::min(weight_, result_.cost / lowestF);
+}
+
+const SearchResult& AnytimeSearch::start(Vector start, Vector goal)
+{
+    auto startId = graph_->findIdOfTriangleUnder(start);
+    if (startId < 0) {
+        throw std::invalid_argument("The specified start point is not contained by any triangle in this graph");
+    }
+    auto goalId = graph_->findIdOfTriangleUnder(goal);
+    if (goalId < 0) {
+        throw std::invalid_argument("The specified goal point is not contained by any triangle in this graph");
+    }
+    startId_ = startId;
+    goalId_ = goalId;
+    goalX_ = goal.x();
+    goalY_ = goal.y();
+    goalCost_ = graph_->costWithin(goalId, graph_->metadataOf(goalId).centroid(), goal);
+    minCostMultiplier_ = graph_->minCostMultiplier();
+    weight_ = initialWeight_;
+    expandedCount_ = 0;
+    open_.clear();
+    inconsistentIds_.clear();
+    result_ = SearchResult::notFound(0);
+    bound_ = std::numeric_limits<double>::infinity();
+    if (graph_->isBlocked(startId) || graph_->isBlocked(goalId)) {
+        return result_;
+    }
+    if (startId == goalId) {
+        result_ = SearchResult { true, { startId }, graph_->costWithin(startId, start, goal), 1 };
+        bound_ = 1.0;
+        return result_;
+    }
+    nodes_.start();
+    startPass();
+    nodes_.visit(startId, graph_->costWithin(startId, start, graph_->metadataOf(startId).centroid()), -1);
+    push(startId);
+    improvePath();
+    updateBound();
+    return result_;
+}
+
+bool AnytimeSearch::improve()
+{
+    if (!result_.isFound || (bound_ <= 1.0) || (startId_ == goalId_)) {
+        return false;
+    }
+    weight_ = std::max(1.0, std::min(weight_, bound_) - weightStep_);
+    startPass();
+    improvePath();
+    updateBound();
+    return true;
+}
+
+SearchResult AnytimeSearch::findPath(Vector start, Vector goal, double targetBound, std::chrono::microseconds budget)
+{
+    auto deadline = std::chrono::steady_clock::now() + budget;
+    this->start(start, goal);
+    while ((bound_ > targetBound) && (std::chrono::steady_clock::now() < deadline) && improve()) {
+    }
+    return result_;
+}
@@ -0,0 +1,111 @@
+/**
+ * Copyright 2019 Márton Gergó
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <BidirectionalSearch.h>
+#include <cmath>
+#include <limits>
+
+using namespace TpaStarCpp::GeometryLibrary;
+
+BidirectionalSearch::BidirectionalSearch(std::shared_ptr<TriangleGraph> graph) :
+    graph_(std::move(graph)),
+    forward_(graph_->triangleCount()),
+    backward_(graph_->triangleCount())
+{
+}
+
+SearchResult BidirectionalSearch::findPath(Vector start, Vector goal)
+{
+    auto startId = graph_->getTriangleUnder(start).id();
+    auto goalId = graph_->getTriangleUnder(goal).id();
+    return findPath(startId, start, goalId, goal);
+}
+
+SearchResult BidirectionalSearch::findPath(long startId, Vector start, long goalId, Vector goal)
+{
+    if (graph_->isBlocked(startId) || graph_->isBlocked(goalId)) {
+        return SearchResult::notFound(0);
+    }
+    if (startId == goalId) {
+        return SearchResult { true, { startId }, graph_->costWithin(startId, start, goal), 1 };
+    }
+    auto startCost = graph_->costWithin(startId, start, graph_->metadataOf(startId).centroid());
+    auto goalCost = graph_->costWithin(goalId, graph_->metadataOf(goalId).centroid(), goal);
+    auto minMultiplier = graph_->minCostMultiplier();
+    // half of the difference of the straight line distances to the two ends, consistent for both sides
+    auto potentialOf = [&](long id) {
+        auto& metadata = graph_->metadataOf(id);
+        auto toGoal = std::hypot(metadata.centroidX - goal.x(), metadata.centroidY - goal.y());
+        auto toStart = std::hypot(metadata.centroidX - start.x(), metadata.centroidY - start.y());
+        return 0.5 * minMultiplier * (toGoal - toStart);
+    };
+
+    auto bestCost = std::numeric_limits<double>::infinity();
+    long meetingId = -1;
+    auto expand = [&](SearchNodes& nodes, SearchNodes& opposite, double sign) {
+        auto id = nodes.pop();
+        nodes.close(id);
+        auto relax = [&](long neighbour, double cost) {
+            if (graph_->isBlocked(neighbour)) {
+                return;
+            }
+            auto g = nodes.gScoreOf(id) + cost;
+            if (!nodes.isVisited(neighbour) || (g < nodes.gScoreOf(neighbour))) {
+                nodes.visit(neighbour, g, id);
+                nodes.push(g + sign * potentialOf(neighbour), neighbour);
+                if (opposite.isVisited(neighbour) && (g + opposite.gScoreOf(neighbour) < bestCost)) {
+                    bestCost = g + opposite.gScoreOf(neighbour);
+                    meetingId = neighbour;
+                }
+            }
+        };
+        // links are one way, the backward side follows them against their direction
+        if (sign > 0.0) {
+            graph_->forEachStepFrom(id, relax);
+        } else {
+            graph_->forEachStepTo(id, relax);
+        }
+    };
+
+    forward_.start();
+    backward_.start();
+    forward_.visit(startId, startCost, -1);
+    forward_.push(startCost + potentialOf(startId), startId);
+    backward_.visit(goalId, goalCost, -1);
+    backward_.push(goalCost - potentialOf(goalId), goalId);
+    long expandedCount = 0;
+    while (forward_.hasOpen() && backward_.hasOpen()) {
+        if (forward_.minF() + backward_.minF() >= bestCost) {
+            break;
+        }
+        // the side with the shorter open list is the cheaper one to grow
+        if (forward_.openSize() <= backward_.openSize()) {
+            expand(forward_, backward_, 1.0);
+        } else {
+            expand(backward_, forward_, -1.0);
+        }
+        expandedCount++;
+    }
+    if (meetingId < 0) {
+        return SearchResult::notFound(expandedCount);
+    }
+
+    auto triangleIds = forward_.pathTo(meetingId);
+    for (auto id = backward_.parentIdOf(meetingId); id >= 0; id = backward_.parentIdOf(id)) {
+        triangleIds.push_back(id);
+    }
+    return SearchResult { true, std::move(triangleIds), bestCost, expandedCount };
+}
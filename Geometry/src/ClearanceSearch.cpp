@@ -0,0 +1,131 @@
+/**
+ * Copyright 2019 Márton Gergó
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <ClearanceSearch.h>
+#include <cmath>
+#include <stdexcept>
+
+using namespace TpaStarCpp::GeometryLibrary;
+
+namespace {
+
+    // the node of a triangle entered through one of its edges, the fourth one is entered at a point,
+    // the start or the end of a link
+    constexpr int NODES_PER_TRIANGLE = 4;
+    constexpr int START_EDGE = 3;
+
+}
+
+ClearanceSearch::ClearanceSearch(std::shared_ptr<TriangleGraph> graph) :
+    graph_(std::move(graph)),
+    nodes_(NODES_PER_TRIANGLE * graph_->triangleCount())
+{
+}
+
+/*
+ * Edge k runs from corner k to corner k + 1, so the edges following each other around the triangle share the
+ * corner between them. A point may be anywhere in its triangle, from there only the edge itself has to be wide enough.
+ */
+bool ClearanceSearch::canLeave(long id, int entryEdge, int exitEdge, double diameter)
+{
+    if (entryEdge == START_EDGE) {
+        auto first = exitEdge;
+        auto second = (exitEdge + 1) % 3;
+        return !graph_->isObstacleCorner(id, first) || !graph_->isObstacleCorner(id, second) ||
+               (graph_->cornerOf(id, first).distanceFrom(graph_->cornerOf(id, second)) >= diameter);
+    }
+    auto sharedCorner = (exitEdge == (entryEdge + 1) % 3) ? exitEdge : entryEdge;
+    return graph_->clearanceOf(id, sharedCorner) >= diameter;
+}
+
+SearchResult ClearanceSearch::findPath(Vector start, Vector goal, double radius)
+{
+    if (!(radius >= 0.0)) {
+        throw std::invalid_argument("The radius of the agent must not be negative");
+    }
+    auto startId = graph_->findIdOfTriangleUnder(start);
+    if (startId < 0) {
+        throw std::invalid_argument("The specified start point is not contained by any triangle in this graph");
+    }
+    auto goalId = graph_->findIdOfTriangleUnder(goal);
+    if (goalId < 0) {
+        throw std::invalid_argument("The specified goal point is not contained by any triangle in this graph");
+    }
+    if (graph_->isBlocked(startId) || graph_->isBlocked(goalId)) {
+        return SearchResult::notFound(0);
+    }
+    if (startId == goalId) {
+        return SearchResult { true, { startId }, graph_->costWithin(startId, start, goal), 1 };
+    }
+
+    auto diameter = 2.0 * radius;
+    auto goalX = goal.x();
+    auto goalY = goal.y();
+    auto goalCost = graph_->costWithin(goalId, graph_->metadataOf(goalId).centroid(), goal);
+    auto minMultiplier = graph_->minCostMultiplier();
+    auto estimateOf = [&](long id) {
+        auto& metadata = graph_->metadataOf(id);
+        return (id == goalId) ? goalCost : minMultiplier * std::hypot(metadata.centroidX - goalX, metadata.centroidY - goalY);
+    };
+    nodes_.start();
+    auto startNode = NODES_PER_TRIANGLE * startId + START_EDGE;
+    auto startCost = graph_->costWithin(startId, start, graph_->metadataOf(startId).centroid());
+    nodes_.visit(startNode, startCost, -1);
+    nodes_.push(startCost + estimateOf(startId), startNode);
+
+    auto relax = [&](long node, long neighbourNode, double g) {
+        if (!nodes_.isVisited(neighbourNode) || (g < nodes_.gScoreOf(neighbourNode))) {
+            nodes_.visit(neighbourNode, g, node);
+            nodes_.push(g + estimateOf(neighbourNode / NODES_PER_TRIANGLE), neighbourNode);
+        }
+    };
+    long expandedCount = 0;
+    while (nodes_.hasOpen()) {
+        auto node = nodes_.pop();
+        nodes_.close(node);
+        expandedCount++;
+        auto id = node / NODES_PER_TRIANGLE;
+        auto entryEdge = static_cast<int>(node % NODES_PER_TRIANGLE);
+        if (id == goalId) {
+            auto path = nodes_.pathTo(node);
+            for (auto& pathNode : path) {
+                pathNode /= NODES_PER_TRIANGLE;
+            }
+            return SearchResult { true, std::move(path), nodes_.gScoreOf(node) + goalCost, expandedCount };
+        }
+        for (int edge = 0; edge < 3; edge++) {
+            auto neighbour = graph_->neighbourIdAcross(id, edge);
+            if ((edge == entryEdge) || (neighbour < 0) || graph_->isBlocked(neighbour) ||
+                !canLeave(id, entryEdge, edge, diameter)) {
+                continue;
+            }
+            int neighbourEdge = 0;
+            while (graph_->neighbourIdAcross(neighbour, neighbourEdge) != id) {
+                neighbourEdge++;
+            }
+            auto neighbourNode = NODES_PER_TRIANGLE * neighbour + neighbourEdge;
+            relax(node, neighbourNode, nodes_.gScoreOf(node) + graph_->crossingCostOf(id, edge));
+        }
+        // a link ends at a point, the agent leaves its end like it leaves the start
+        graph_->forEachLinkFrom(id, [&](long neighbour, double cost) {
+            if (!graph_->isBlocked(neighbour)) {
+                relax(node, NODES_PER_TRIANGLE * neighbour + START_EDGE, nodes_.gScoreOf(node) + cost);
+            }
+        });
+    }
+    return SearchResult::notFound(expandedCount);
+}
@@ -0,0 +1,232 @@
+/**
+ * Copyright 2019 Márton Gergó
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <ConvexPolygonGraph.h>
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+#include "Vector.h"
+#include "Edge.h"
+
+using namespace TpaStarCpp::GeometryLibrary;
+
+namespace {
+
+    long rootOf(std::vector<long>& parents, long id)
+    {
+        while (parents[id] != id) {
+            parents[id] = parents[parents[id]];
+            id = parents[id];
+        }
+        return id;
+    }
+
+}
+
+ConvexPolygonGraph::ConvexPolygonGraph(std::shared_ptr<TriangleGraph> triangles) :
+    triangles_(std::move(triangles))
+{
+    mergeTriangles();
+}
+
+/*
+ * The edges of the triangles are kept as half-edges linked into counter-clockwise loops, 3 * id + edge being the one
+ * along the edge between corner `edge` and the next corner. Removing an edge joins the loops on its two sides.
+ */
+void ConvexPolygonGraph::mergeTriangles()
+{
+    long triangleCount = triangles_->triangleCount();
+    long halfEdgeCount = 3 * triangleCount;
+    std::vector<double> originXs(halfEdgeCount);
+    std::vector<double> originYs(halfEdgeCount);
+    std::vector<long> nexts(halfEdgeCount);
+    std::vector<long> previouses(halfEdgeCount);
+    std::vector<long> twins(halfEdgeCount, -1);
+    for (long id = 0; id < triangleCount; id++) {
+        Vector corners[3] = { triangles_->cornerOf(id, 0), triangles_->cornerOf(id, 1), triangles_->cornerOf(id, 2) };
+        auto ab = corners[1] - corners[0];
+        auto ac = corners[2] - corners[0];
+        bool isCounterClockwise = ab.x() * ac.y() - ab.y() * ac.x() > 0.0;
+        for (int edge = 0; edge < 3; edge++) {
+            // clockwise triangles are walked the other way around, so their edges start at the next corner
+            auto& origin = corners[isCounterClockwise ? edge : (edge + 1) % 3];
+            originXs[3 * id + edge] = origin.x();
+            originYs[3 * id + edge] = origin.y();
+            nexts[3 * id + edge] = 3 * id + (isCounterClockwise ? (edge + 1) % 3 : (edge + 2) % 3);
+            previouses[nexts[3 * id + edge]] = 3 * id + edge;
+            auto neighbour = triangles_->neighbourIdAcross(id, edge);
+            for (int neighbourEdge = 0; (neighbour >= 0) && (neighbourEdge < 3); neighbourEdge++) {
+                if (triangles_->neighbourIdAcross(neighbour, neighbourEdge) == id) {
+                    twins[3 * id + edge] = 3 * neighbour + neighbourEdge;
+                }
+            }
+        }
+    }
+
+    auto isConvexCorner = [&](long incoming, long outgoing) {
+        auto corner = outgoing;
+        auto next = nexts[outgoing];
+        auto inX = originXs[corner] - originXs[incoming];
+        auto inY = originYs[corner] - originYs[incoming];
+        auto outX = originXs[next] - originXs[corner];
+        auto outY = originYs[next] - originYs[corner];
+        // collinear corners are accepted, rounding errors are not allowed to make them reflex,
+        // but a corner turning back on itself is a U-turn and not a straight continuation
+        auto cross = inX * outY - inY * outX;
+        auto tolerance = 1e-12 * std::hypot(inX, inY) * std::hypot(outX, outY);
+        return (cross > tolerance) || ((cross >= -tolerance) && (inX * outX + inY * outY > 0.0));
+    };
+    std::vector<bool> isRemoved(halfEdgeCount, false);
+    std::vector<long> parents(triangleCount);
+    std::iota(begin(parents), end(parents), 0);
+    for (long halfEdge = 0; halfEdge < halfEdgeCount; halfEdge++) {
+        auto twin = twins[halfEdge];
+        if ((twin < halfEdge) || (twins[twin] != halfEdge)) {
+            continue;
+        }
+        // around a hole the two sides of an edge may already belong to the same polygon, removing it would split the loop
+        if (rootOf(parents, halfEdge / 3) == rootOf(parents, twin / 3)) {
+            continue;
+        }
+        // the corners at both ends of the edge join the edges before and after it on the two sides
+        if (isConvexCorner(previouses[halfEdge], nexts[twin]) && isConvexCorner(previouses[twin], nexts[halfEdge])) {
+            nexts[previouses[halfEdge]] = nexts[twin];
+            previouses[nexts[twin]] = previouses[halfEdge];
+            nexts[previouses[twin]] = nexts[halfEdge];
+            previouses[nexts[halfEdge]] = previouses[twin];
+            isRemoved[halfEdge] = true;
+            isRemoved[twin] = true;
+            parents[rootOf(parents, halfEdge / 3)] = rootOf(parents, twin / 3);
+        }
+    }
+
+    std::vector<long> halfEdgePolygonIds(halfEdgeCount, -1);
+    std::vector<long> rootPolygonIds(triangleCount, -1);
+    cornerStarts_.push_back(0);
+    for (long halfEdge = 0; halfEdge < halfEdgeCount; halfEdge++) {
+        if (isRemoved[halfEdge] || (halfEdgePolygonIds[halfEdge] >= 0)) {
+            continue;
+        }
+        long id = cornerStarts_.size() - 1;
+        rootPolygonIds[rootOf(parents, halfEdge / 3)] = id;
+        auto current = halfEdge;
+        do {
+            halfEdgePolygonIds[current] = id;
+            cornerXs_.push_back(originXs[current]);
+            cornerYs_.push_back(originYs[current]);
+            current = nexts[current];
+        } while (current != halfEdge);
+        cornerStarts_.push_back(cornerXs_.size());
+    }
+    for (long halfEdge = 0; halfEdge < halfEdgeCount; halfEdge++) {
+        auto current = halfEdge;
+        if (isRemoved[halfEdge] || (edgeNeighbourIds_.size() > cornerStarts_[halfEdgePolygonIds[halfEdge]])) {
+            continue;
+        }
+        do {
+            edgeNeighbourIds_.push_back((twins[current] < 0) ? -1 : halfEdgePolygonIds[twins[current]]);
+            current = nexts[current];
+        } while (current != halfEdge);
+    }
+
+    neighbourIds_.resize(polygonCount());
+    for (long id = 0; id < polygonCount(); id++) {
+        auto& neighbours = neighbourIds_[id];
+        for (auto corner = cornerStarts_[id]; corner < cornerStarts_[id + 1]; corner++) {
+            if (edgeNeighbourIds_[corner] >= 0) {
+                neighbours.push_back(edgeNeighbourIds_[corner]);
+            }
+        }
+        std::sort(begin(neighbours), end(neighbours));
+        neighbours.erase(std::unique(begin(neighbours), end(neighbours)), end(neighbours));
+    }
+
+    polygonIds_.resize(triangleCount);
+    triangleStarts_.assign(polygonCount() + 1, 0);
+    for (long id = 0; id < triangleCount; id++) {
+        polygonIds_[id] = rootPolygonIds[rootOf(parents, id)];
+        triangleStarts_[polygonIds_[id] + 1]++;
+    }
+    std::partial_sum(begin(triangleStarts_), end(triangleStarts_), begin(triangleStarts_));
+    triangleIds_.resize(triangleCount);
+    auto positions = triangleStarts_;
+    for (long id = 0; id < triangleCount; id++) {
+        triangleIds_[positions[polygonIds_[id]]++] = id;
+    }
+}
+
+long ConvexPolygonGraph::polygonCount() { return cornerStarts_.size() - 1; }
+
+long ConvexPolygonGraph::findIdOfPolygonUnder(Vector point) noexcept
+{
+    auto triangleId = triangles_->findIdOfTriangleUnder(point);
+    return (triangleId < 0) ? -1 : polygonIds_[triangleId];
+}
+
+Vector ConvexPolygonGraph::cornerOf(long id, int corner)
+{
+    auto index = cornerStarts_[id] + corner;
+    return Vector(cornerXs_[index], cornerYs_[index]);
+}
+
+// Two convex polygons can only share collinear edges, so the portal spans all of them
+Edge ConvexPolygonGraph::portalBetween(long id, long neighbourId)
+{
+    std::vector<Vector> endpoints;
+    for (int edge = 0; edge < cornerCountOf(id); edge++) {
+        if (neighbourIdAcross(id, edge) == neighbourId) {
+            endpoints.push_back(cornerOf(id, edge));
+            endpoints.push_back(cornerOf(id, (edge + 1) % cornerCountOf(id)));
+        }
+    }
+    if (endpoints.empty()) {
+        throw std::invalid_argument("The specified polygons are not neighbours");
+    }
+    long first = 0;
+    long second = 1;
+    for (long i = 0; i < endpoints.size(); i++) {
+        for (long j = i + 1; j < endpoints.size(); j++) {
+            if (endpoints[i].distanceFrom(endpoints[j]) > endpoints[first].distanceFrom(endpoints[second])) {
+                first = i;
+                second = j;
+            }
+        }
+    }
+    return Edge(endpoints[first], endpoints[second]);
+}
+
+Vector ConvexPolygonGraph::centroidOf(long id)
+{
+    double area = 0.0;
+    double x = 0.0;
+    double y = 0.0;
+    auto origin = cornerOf(id, 0);
+    for (int corner = 1; corner + 1 < cornerCountOf(id); corner++) {
+        auto b = cornerOf(id, corner) - origin;
+        auto c = cornerOf(id, corner + 1) - origin;
+        auto fanArea = (b.x() * c.y() - b.y() * c.x()) / 2.0;
+        area += fanArea;
+        x += fanArea * (b.x() + c.x()) / 3.0;
+        y += fanArea * (b.y() + c.y()) / 3.0;
+    }
+    return Vector(origin.x() + x / area, origin.y() + y / area);
+}
+
+std::vector<long> ConvexPolygonGraph::triangleIdsOf(long id)
+{
+    return std::vector<long>(begin(triangleIds_) + triangleStarts_[id], begin(triangleIds_) + triangleStarts_[id + 1]);
+}
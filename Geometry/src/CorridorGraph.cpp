@@ -0,0 +1,160 @@
+/**
+ * Copyright 2019 Márton Gergó
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <CorridorGraph.h>
+#include <stdexcept>
+#include "Vector.h"
+
+using namespace TpaStarCpp::GeometryLibrary;
+
+CorridorGraph::CorridorGraph(std::shared_ptr<TriangleGraph> triangles) :
+    triangles_(std::move(triangles)),
+    levels_(triangles_->triangleCount(), ContractionLevel::Corridor),
+    treeParentIds_(triangles_->triangleCount(), -1),
+    treeRootIds_(triangles_->triangleCount(), -1),
+    corridorIds_(triangles_->triangleCount(), -1),
+    junctionCorridorIds_(triangles_->triangleCount()),
+    isLinkEnd_(triangles_->triangleCount(), false)
+{
+    for (long link = 0; link < triangles_->offMeshLinkCount(); link++) {
+        isLinkEnd_[triangles_->offMeshLinkOf(link).fromId] = true;
+        isLinkEnd_[triangles_->offMeshLinkOf(link).toId] = true;
+    }
+    pruneTrees();
+    collapseCorridors();
+}
+
+// Peels off triangles with at most one remaining neighbour until only rings and the chains between them remain,
+// the ends of links are kept since the rest of the graph may lie behind them
+void CorridorGraph::pruneTrees()
+{
+    long count = triangles_->triangleCount();
+    std::vector<long> degrees(count);
+    std::vector<long> peeled;
+    for (long id = 0; id < count; id++) {
+        degrees[id] = triangles_->neighbourIdsOf(id).size();
+        if ((degrees[id] <= 1) && !isLinkEnd_[id]) {
+            levels_[id] = ContractionLevel::Tree;
+            peeled.push_back(id);
+        }
+    }
+    // the only neighbour not peeled yet is the parent, every other neighbour hangs off this triangle
+    std::vector<bool> isPeeled(count, false);
+    for (long i = 0; i < peeled.size(); i++) {
+        auto id = peeled[i];
+        isPeeled[id] = true;
+        for (auto neighbour : triangles_->neighbourIdsOf(id)) {
+            if (isPeeled[neighbour]) {
+                continue;
+            }
+            treeParentIds_[id] = neighbour;
+            if ((--degrees[neighbour] <= 1) && (levels_[neighbour] != ContractionLevel::Tree) && !isLinkEnd_[neighbour]) {
+                levels_[neighbour] = ContractionLevel::Tree;
+                peeled.push_back(neighbour);
+            }
+        }
+    }
+    // parents are peeled later than their children, so walking backwards meets them first
+    for (auto i = static_cast<long>(peeled.size()) - 1; i >= 0; i--) {
+        auto id = peeled[i];
+        auto parent = treeParentIds_[id];
+        treeRootIds_[id] = (parent < 0) ? -1 : ((levels_[parent] == ContractionLevel::Tree) ? treeRootIds_[parent] : parent);
+    }
+}
+
+void CorridorGraph::collapseCorridors()
+{
+    long count = triangles_->triangleCount();
+    auto coreDegreeOf = [&](long id) {
+        long degree = 0;
+        for (auto neighbour : triangles_->neighbourIdsOf(id)) {
+            degree += (levels_[neighbour] != ContractionLevel::Tree) ? 1 : 0;
+        }
+        return degree;
+    };
+    for (long id = 0; id < count; id++) {
+        if ((levels_[id] != ContractionLevel::Tree) && (isLinkEnd_[id] || (coreDegreeOf(id) >= 3))) {
+            levels_[id] = ContractionLevel::Junction;
+            junctionIds_.push_back(id);
+        }
+    }
+    for (long i = 0; i < junctionIds_.size(); i++) {
+        walkCorridors(junctionIds_[i]);
+    }
+    for (long id = 0; id < count; id++) {
+        if ((levels_[id] == ContractionLevel::Corridor) && (corridorIds_[id] < 0)) {
+            // a ring without junctions, one of its triangles takes their place
+            levels_[id] = ContractionLevel::Junction;
+            junctionIds_.push_back(id);
+            walkCorridors(id);
+        }
+    }
+}
+
+// Follows every corridor leaving the junction that has not been walked from its other end yet
+void CorridorGraph::walkCorridors(long junctionId)
+{
+    for (auto neighbour : triangles_->neighbourIdsOf(junctionId)) {
+        bool isWalked = (levels_[neighbour] == ContractionLevel::Tree) ||
+                        ((levels_[neighbour] == ContractionLevel::Corridor) && (corridorIds_[neighbour] >= 0)) ||
+                        ((levels_[neighbour] == ContractionLevel::Junction) && (neighbour < junctionId));
+        if (isWalked) {
+            continue;
+        }
+        long corridorId = corridors_.size();
+        Corridor corridor { junctionId, -1, {}, { portalBetween(junctionId, neighbour) }, 0.0 };
+        auto previous = junctionId;
+        auto current = neighbour;
+        while (levels_[current] == ContractionLevel::Corridor) {
+            corridor.triangleIds.push_back(current);
+            corridorIds_[current] = corridorId;
+            long next = -1;
+            for (auto candidate : triangles_->neighbourIdsOf(current)) {
+                if ((levels_[candidate] != ContractionLevel::Tree) && (candidate != previous)) {
+                    next = candidate;
+                }
+            }
+            corridor.portals.push_back(portalBetween(current, next));
+            previous = current;
+            current = next;
+        }
+        corridor.toJunctionId = current;
+
+        auto previousId = junctionId;
+        for (long i = 0; i < corridor.portals.size(); i++) {
+            auto midpoint = (corridor.portals[i].a() + corridor.portals[i].b()) * 0.5;
+            auto nextId = (i < corridor.triangleIds.size()) ? corridor.triangleIds[i] : current;
+            corridor.length += triangles_->metadataOf(previousId).centroid().distanceFrom(midpoint) +
+                               midpoint.distanceFrom(triangles_->metadataOf(nextId).centroid());
+            previousId = nextId;
+        }
+        junctionCorridorIds_[junctionId].push_back(corridorId);
+        if (current != junctionId) {
+            junctionCorridorIds_[current].push_back(corridorId);
+        }
+        corridors_.push_back(std::move(corridor));
+    }
+}
+
+Edge CorridorGraph::portalBetween(long id, long neighbourId)
+{
+    for (int edge = 0; edge < 3; edge++) {
+        if (triangles_->neighbourIdAcross(id, edge) == neighbourId) {
+            return Edge(triangles_->cornerOf(id, edge), triangles_->cornerOf(id, (edge + 1) % 3));
+        }
+    }
+    throw std::logic_error("The specified triangles do not share an edge");
+}
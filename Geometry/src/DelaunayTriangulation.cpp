@@ -0,0 +1,513 @@
+/**
+ * Copyright 2019 Márton Gergó
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <DelaunayTriangulation.h>
+#include <cmath>
+#include <deque>
+#include <stdexcept>
+#include "Vector.h"
+
+using namespace TpaStarCpp::GeometryLibrary;
+
+DelaunayTriangulation::DelaunayTriangulation(double minX, double minY, double maxX, double maxY) :
+    xs_ { minX, maxX, maxX, minX },
+    ys_ { minY, minY, maxY, maxY },
+    vertexFaces_(4)
+{
+    if ((maxX - minX < Vector::EQUALITY_CHECK_TOLERANCE) || (maxY - minY < Vector::EQUALITY_CHECK_TOLERANCE)) {
+        throw std::invalid_argument("The specified rectangle is distorted");
+    }
+    storeFace(0, Face { { 0, 1, 2 }, { -1, -1, 1 }, { false, false, false } });
+    storeFace(1, Face { { 0, 2, 3 }, { 0, -1, -1 }, { false, false, false } });
+}
+
+long DelaunayTriangulation::vertexCount() { return xs_.size(); }
+
+double DelaunayTriangulation::orientation(long a, long b, long c) { return orientation(a, b, xs_[c], ys_[c]); }
+
+// positive if the point lies to the left of the directed line from a to b
+double DelaunayTriangulation::orientation(long a, long b, double x, double y)
+{
+    return (xs_[b] - xs_[a]) * (y - ys_[a]) - (ys_[b] - ys_[a]) * (x - xs_[a]);
+}
+
+bool DelaunayTriangulation::isInCircumcircle(long face, long vertex)
+{
+    auto& corners = faces_[face].vertices;
+    double px = xs_[vertex];
+    double py = ys_[vertex];
+    double ax = xs_[corners[0]] - px;
+    double ay = ys_[corners[0]] - py;
+    double bx = xs_[corners[1]] - px;
+    double by = ys_[corners[1]] - py;
+    double cx = xs_[corners[2]] - px;
+    double cy = ys_[corners[2]] - py;
+    double determinant = (ax * ax + ay * ay) * (bx * cy - cx * by)
+                       - (bx * bx + by * by) * (ax * cy - cx * ay)
+                       + (cx * cx + cy * cy) * (ax * by - bx * ay);
+    return determinant > 0.0;
+}
+
+// Visibility walk towards the point, starting from the previously touched face
+long DelaunayTriangulation::locate(double x, double y)
+{
+    auto face = lastFace_;
+    int firstEdge = 0;
+    for (long steps = 0; steps <= faces_.size(); steps++) {
+        bool moved = false;
+        for (int i = 0; (i < 3) && !moved; i++) {
+            int edge = (firstEdge + i) % 3;
+            auto& current = faces_[face];
+            if (orientation(current.vertices[edge], current.vertices[(edge + 1) % 3], x, y) < 0.0) {
+                if (current.neighbours[edge] < 0) {
+                    throw std::invalid_argument("The specified point lies outside of the triangulated rectangle");
+                }
+                face = current.neighbours[edge];
+                moved = true;
+            }
+        }
+        if (!moved) {
+            return face;
+        }
+        // rotating the first edge checked prevents walks from cycling
+        firstEdge = (firstEdge + 1) % 3;
+    }
+    throw std::logic_error("Point location did not converge");
+}
+
+long DelaunayTriangulation::insertVertex(double x, double y)
+{
+    auto face = locate(x, y);
+    Vector point(x, y);
+    for (auto corner : faces_[face].vertices) {
+        if (Vector(xs_[corner], ys_[corner]) == point) {
+            return corner;
+        }
+    }
+
+    long vertex = xs_.size();
+    xs_.push_back(x);
+    ys_.push_back(y);
+    vertexFaces_.push_back(face);
+    for (int edge = 0; edge < 3; edge++) {
+        auto& corners = faces_[face].vertices;
+        auto length = std::hypot(xs_[corners[(edge + 1) % 3]] - xs_[corners[edge]],
+                                 ys_[corners[(edge + 1) % 3]] - ys_[corners[edge]]);
+        if (orientation(corners[edge], corners[(edge + 1) % 3], x, y) / length < Vector::EQUALITY_CHECK_TOLERANCE) {
+            splitEdge(face, edge, vertex);
+            return vertex;
+        }
+    }
+    splitFace(face, vertex);
+    return vertex;
+}
+
+int DelaunayTriangulation::edgeTowards(long face, long neighbour)
+{
+    auto& neighbours = faces_[face].neighbours;
+    for (int edge = 0; edge < 3; edge++) {
+        if (neighbours[edge] == neighbour) {
+            return edge;
+        }
+    }
+    throw std::logic_error("The specified faces are not neighbours");
+}
+
+void DelaunayTriangulation::replaceNeighbour(long face, long oldNeighbour, long newNeighbour)
+{
+    if (face >= 0) {
+        faces_[face].neighbours[edgeTowards(face, oldNeighbour)] = newNeighbour;
+    }
+}
+
+void DelaunayTriangulation::storeFace(long face, Face value)
+{
+    if (face == faces_.size()) {
+        faces_.push_back(value);
+    } else {
+        faces_[face] = value;
+    }
+    for (auto vertex : value.vertices) {
+        vertexFaces_[vertex] = face;
+    }
+}
+
+void DelaunayTriangulation::splitFace(long face, long vertex)
+{
+    auto old = faces_[face];
+    long second = faces_.size();
+    long third = second + 1;
+    auto [a, b, c] = old.vertices;
+    auto [ab, bc, ca] = old.isConstrained;
+    storeFace(face, Face { { a, b, vertex }, { old.neighbours[0], second, third }, { ab, false, false } });
+    storeFace(second, Face { { b, c, vertex }, { old.neighbours[1], third, face }, { bc, false, false } });
+    storeFace(third, Face { { c, a, vertex }, { old.neighbours[2], face, second }, { ca, false, false } });
+    replaceNeighbour(old.neighbours[1], face, second);
+    replaceNeighbour(old.neighbours[2], face, third);
+
+    std::vector<std::pair<long, long>> facesWithNewVertex { { face, vertex }, { second, vertex }, { third, vertex } };
+    legalize(facesWithNewVertex);
+}
+
+void DelaunayTriangulation::splitEdge(long face, int edge, long vertex)
+{
+    // face is (a, b, c) with the vertex on the edge a-b, the neighbour across it is (b, a, d)
+    auto old = faces_[face];
+    long a = old.vertices[edge];
+    long b = old.vertices[(edge + 1) % 3];
+    long c = old.vertices[(edge + 2) % 3];
+    bool isSplitEdgeConstrained = old.isConstrained[edge];
+    bool bc = old.isConstrained[(edge + 1) % 3];
+    bool ca = old.isConstrained[(edge + 2) % 3];
+    long other = old.neighbours[edge];
+    long secondOfFace = faces_.size();
+    storeFace(face, Face { { a, vertex, c }, { other, secondOfFace, old.neighbours[(edge + 2) % 3] },
+                           { isSplitEdgeConstrained, false, ca } });
+    storeFace(secondOfFace, Face { { vertex, b, c }, { -1, old.neighbours[(edge + 1) % 3], face },
+                                   { isSplitEdgeConstrained, bc, false } });
+    replaceNeighbour(old.neighbours[(edge + 1) % 3], face, secondOfFace);
+    std::vector<std::pair<long, long>> facesWithNewVertex { { face, vertex }, { secondOfFace, vertex } };
+
+    if (other >= 0) {
+        auto otherOld = faces_[other];
+        int otherEdge = edgeTowards(other, face);
+        long d = otherOld.vertices[(otherEdge + 2) % 3];
+        bool ad = otherOld.isConstrained[(otherEdge + 1) % 3];
+        bool db = otherOld.isConstrained[(otherEdge + 2) % 3];
+        long secondOfOther = faces_.size();
+        storeFace(other, Face { { b, vertex, d }, { secondOfFace, secondOfOther, otherOld.neighbours[(otherEdge + 2) % 3] },
+                                { isSplitEdgeConstrained, false, db } });
+        storeFace(secondOfOther, Face { { vertex, a, d }, { face, otherOld.neighbours[(otherEdge + 1) % 3], other },
+                                        { isSplitEdgeConstrained, ad, false } });
+        replaceNeighbour(otherOld.neighbours[(otherEdge + 1) % 3], other, secondOfOther);
+        faces_[face].neighbours[0] = secondOfOther;
+        faces_[secondOfFace].neighbours[0] = other;
+        facesWithNewVertex.emplace_back(other, vertex);
+        facesWithNewVertex.emplace_back(secondOfOther, vertex);
+    }
+    legalize(facesWithNewVertex);
+}
+
+// Flips the edge between vertex `edge` and the next vertex of the face, turning (a, b, c) + (b, a, d) into (c, a, d) + (d, b, c)
+void DelaunayTriangulation::flip(long face, int edge)
+{
+    long other = faces_[face].neighbours[edge];
+    int otherEdge = edgeTowards(other, face);
+    auto old = faces_[face];
+    auto otherOld = faces_[other];
+    long a = old.vertices[edge];
+    long b = old.vertices[(edge + 1) % 3];
+    long c = old.vertices[(edge + 2) % 3];
+    long d = otherOld.vertices[(otherEdge + 2) % 3];
+    long bc = old.neighbours[(edge + 1) % 3];
+    long ca = old.neighbours[(edge + 2) % 3];
+    long ad = otherOld.neighbours[(otherEdge + 1) % 3];
+    long db = otherOld.neighbours[(otherEdge + 2) % 3];
+
+    storeFace(face, Face { { c, a, d }, { ca, ad, other },
+                           { old.isConstrained[(edge + 2) % 3], otherOld.isConstrained[(otherEdge + 1) % 3], false } });
+    storeFace(other, Face { { d, b, c }, { db, bc, face },
+                            { otherOld.isConstrained[(otherEdge + 2) % 3], old.isConstrained[(edge + 1) % 3], false } });
+    replaceNeighbour(ad, other, face);
+    replaceNeighbour(bc, face, other);
+}
+
+void DelaunayTriangulation::legalize(std::vector<std::pair<long, long>>& facesWithNewVertex)
+{
+    while (!facesWithNewVertex.empty()) {
+        auto [face, vertex] = facesWithNewVertex.back();
+        facesWithNewVertex.pop_back();
+        lastFace_ = face;
+
+        auto& corners = faces_[face].vertices;
+        int vertexIndex = (corners[0] == vertex) ? 0 : ((corners[1] == vertex) ? 1 : 2);
+        int oppositeEdge = (vertexIndex + 1) % 3;
+        long other = faces_[face].neighbours[oppositeEdge];
+        if ((other < 0) || faces_[face].isConstrained[oppositeEdge]) {
+            continue;
+        }
+        auto& otherCorners = faces_[other].vertices;
+        long opposite = otherCorners[(edgeTowards(other, face) + 2) % 3];
+        if (isInCircumcircle(face, opposite)) {
+            flip(face, oppositeEdge);
+            // both faces keep the new vertex, each with a new edge opposite to it
+            facesWithNewVertex.emplace_back(face, vertex);
+            facesWithNewVertex.emplace_back(other, vertex);
+        }
+    }
+}
+
+// Rotates around the first vertex until a face with an edge towards the second one is found
+std::pair<long, int> DelaunayTriangulation::findEdge(long from, long to)
+{
+    for (int direction = 0; direction < 2; direction++) {
+        auto start = vertexFaces_[from];
+        auto face = start;
+        do {
+            auto& corners = faces_[face].vertices;
+            int index = (corners[0] == from) ? 0 : ((corners[1] == from) ? 1 : 2);
+            if (corners[(index + 1) % 3] == to) {
+                return { face, index };
+            }
+            if (corners[(index + 2) % 3] == to) {
+                return { face, (index + 2) % 3 };
+            }
+            face = faces_[face].neighbours[(direction == 0) ? index : (index + 2) % 3];
+        } while ((face >= 0) && (face != start));
+        if (face == start) {
+            break;
+        }
+    }
+    return { -1, -1 };
+}
+
+// true if the segments a-b and c-d cross each other at a point other than their endpoints
+bool DelaunayTriangulation::crossesProperly(long a, long b, long c, long d)
+{
+    if ((a == c) || (a == d) || (b == c) || (b == d)) {
+        return false;
+    }
+    return (orientation(a, b, c) * orientation(a, b, d) < 0.0) && (orientation(c, d, a) * orientation(c, d, b) < 0.0);
+}
+
+// true if the two faces sharing the edge form a strictly convex quadrilateral, so the edge can be flipped
+bool DelaunayTriangulation::isConvexQuad(long face, int edge)
+{
+    long other = faces_[face].neighbours[edge];
+    long a = faces_[face].vertices[edge];
+    long b = faces_[face].vertices[(edge + 1) % 3];
+    long c = faces_[face].vertices[(edge + 2) % 3];
+    long d = faces_[other].vertices[(edgeTowards(other, face) + 2) % 3];
+    return crossesProperly(a, b, c, d);
+}
+
+void DelaunayTriangulation::markConstrained(long face, int edge)
+{
+    faces_[face].isConstrained[edge] = true;
+    long other = faces_[face].neighbours[edge];
+    if (other >= 0) {
+        faces_[other].isConstrained[edgeTowards(other, face)] = true;
+    }
+}
+
+void DelaunayTriangulation::insertConstraint(long from, long to)
+{
+    if (from == to) {
+        return;
+    }
+    auto [existingFace, existingEdge] = findEdge(from, to);
+    if (existingFace >= 0) {
+        markConstrained(existingFace, existingEdge);
+        return;
+    }
+
+    // walk along the segment collecting the crossed edges as (left, right) vertex pairs
+    std::deque<std::pair<long, long>> crossedEdges;
+    long face = vertexFaces_[from];
+    long left = -1;
+    long right = -1;
+    int direction = 0;
+    for (long steps = 0; (left < 0) && (steps <= faces_.size()); steps++) {
+        auto& corners = faces_[face].vertices;
+        int index = (corners[0] == from) ? 0 : ((corners[1] == from) ? 1 : 2);
+        long next = corners[(index + 1) % 3];
+        long previous = corners[(index + 2) % 3];
+        if ((orientation(from, to, next) < 0.0) && (orientation(from, to, previous) > 0.0)) {
+            left = previous;
+            right = next;
+        } else {
+            face = faces_[face].neighbours[(direction == 0) ? index : (index + 2) % 3];
+        }
+        for (auto vertex : { next, previous }) {
+            auto length = std::hypot(xs_[to] - xs_[from], ys_[to] - ys_[from]);
+            bool isAhead = (xs_[vertex] - xs_[from]) * (xs_[to] - xs_[from]) + (ys_[vertex] - ys_[from]) * (ys_[to] - ys_[from]) > 0.0;
+            if (isAhead && (std::abs(orientation(from, to, vertex)) / length < Vector::EQUALITY_CHECK_TOLERANCE)) {
+                // the segment runs through a vertex, so it is split there
+                insertConstraint(from, vertex);
+                insertConstraint(vertex, to);
+                return;
+            }
+        }
+        if ((face < 0) && (direction == 0)) {
+            // the rotation reached the border of the rectangle, continue in the other direction
+            face = vertexFaces_[from];
+            direction = 1;
+        } else if (face < 0) {
+            throw std::logic_error("The constraint leaves the triangulated rectangle");
+        }
+    }
+    // the face is always the one before the crossed edge, where the edge runs from the right to the left vertex
+    while (true) {
+        auto& corners = faces_[face].vertices;
+        int edge = (corners[0] == right) ? 0 : ((corners[1] == right) ? 1 : 2);
+        if (faces_[face].isConstrained[edge]) {
+            // flipping it away would drop the other constraint, splitting both at the crossing is not supported
+            throw std::invalid_argument("Constraints must not cross each other");
+        }
+        crossedEdges.emplace_back(left, right);
+        long other = faces_[face].neighbours[edge];
+        long opposite = faces_[other].vertices[(edgeTowards(other, face) + 2) % 3];
+        if (opposite == to) {
+            break;
+        }
+        auto side = orientation(from, to, opposite);
+        auto length = std::hypot(xs_[to] - xs_[from], ys_[to] - ys_[from]);
+        if (std::abs(side) / length < Vector::EQUALITY_CHECK_TOLERANCE) {
+            insertConstraint(from, opposite);
+            insertConstraint(opposite, to);
+            return;
+        }
+        if (side > 0.0) {
+            left = opposite;
+        } else {
+            right = opposite;
+        }
+        face = other;
+    }
+
+    // flip the crossed edges away, keeping the ones that cannot be flipped yet for later
+    std::vector<std::pair<long, long>> newEdges;
+    while (!crossedEdges.empty()) {
+        auto [u, w] = crossedEdges.front();
+        crossedEdges.pop_front();
+        auto [edgeFace, edge] = findEdge(u, w);
+        if (!isConvexQuad(edgeFace, edge)) {
+            crossedEdges.emplace_back(u, w);
+            continue;
+        }
+        flip(edgeFace, edge);
+        // the new diagonal is the edge between the first and the last vertex of the flipped face
+        long c = faces_[edgeFace].vertices[0];
+        long d = faces_[edgeFace].vertices[2];
+        if (crossesProperly(from, to, c, d)) {
+            crossedEdges.emplace_back(c, d);
+        } else {
+            newEdges.emplace_back(c, d);
+        }
+    }
+
+    // restore the Delaunay property around the new edges
+    for (bool isFlipped = true; isFlipped;) {
+        isFlipped = false;
+        for (auto& [c, d] : newEdges) {
+            if (((c == from) && (d == to)) || ((c == to) && (d == from))) {
+                continue;
+            }
+            auto [edgeFace, edge] = findEdge(c, d);
+            long other = faces_[edgeFace].neighbours[edge];
+            long opposite = faces_[other].vertices[(edgeTowards(other, edgeFace) + 2) % 3];
+            if (!faces_[edgeFace].isConstrained[edge] && isInCircumcircle(edgeFace, opposite)) {
+                flip(edgeFace, edge);
+                c = faces_[edgeFace].vertices[0];
+                d = faces_[edgeFace].vertices[2];
+                isFlipped = true;
+            }
+        }
+    }
+
+    auto [constraintFace, constraintEdge] = findEdge(from, to);
+    markConstrained(constraintFace, constraintEdge);
+}
+
+// Faces touching the rectangle border are outside; every constraint crossed toggles between outside and inside
+std::vector<bool> DelaunayTriangulation::findEnclosedFaces()
+{
+    std::vector<long> depths(faces_.size(), -1);
+    std::deque<long> queue;
+    for (long face = 0; face < faces_.size(); face++) {
+        auto& neighbours = faces_[face].neighbours;
+        if ((neighbours[0] < 0) || (neighbours[1] < 0) || (neighbours[2] < 0)) {
+            depths[face] = 0;
+            queue.push_back(face);
+        }
+    }
+    // 0-1 breadth first search, crossing a constraint costs one
+    while (!queue.empty()) {
+        auto face = queue.front();
+        queue.pop_front();
+        for (int edge = 0; edge < 3; edge++) {
+            auto neighbour = faces_[face].neighbours[edge];
+            if (neighbour < 0) {
+                continue;
+            }
+            auto depth = depths[face] + (faces_[face].isConstrained[edge] ? 1 : 0);
+            if ((depths[neighbour] < 0) || (depth < depths[neighbour])) {
+                depths[neighbour] = depth;
+                if (depth == depths[face]) {
+                    queue.push_front(neighbour);
+                } else {
+                    queue.push_back(neighbour);
+                }
+            }
+        }
+    }
+    std::vector<bool> isEnclosed(faces_.size());
+    for (long face = 0; face < faces_.size(); face++) {
+        isEnclosed[face] = (depths[face] % 2) == 1;
+    }
+    return isEnclosed;
+}
+
+IndexedMesh DelaunayTriangulation::toIndexedMesh() { return toIndexedMesh(std::vector<bool>(faces_.size(), true)); }
+
+IndexedMesh DelaunayTriangulation::toIndexedMeshOfEnclosedFaces() { return toIndexedMesh(findEnclosedFaces()); }
+
+bool DelaunayTriangulation::containsEdge(long from, long to) { return findEdge(from, to).first >= 0; }
+
+std::vector<bool> DelaunayTriangulation::findEnclosedLeftSides(const std::vector<std::pair<long, long>>& edges)
+{
+    auto isEnclosed = findEnclosedFaces();
+    std::vector<bool> isLeftEnclosed;
+    for (auto [from, to] : edges) {
+        auto [face, edge] = findEdge(from, to);
+        if (face < 0) {
+            throw std::invalid_argument("The edge is not part of the triangulation");
+        }
+        // the faces are counter-clockwise, so the face holding the edge in its direction lies on its left
+        auto leftFace = (faces_[face].vertices[edge] == from) ? face : faces_[face].neighbours[edge];
+        isLeftEnclosed.push_back((leftFace >= 0) && isEnclosed[leftFace]);
+    }
+    return isLeftEnclosed;
+}
+
+IndexedMesh DelaunayTriangulation::toIndexedMesh(const std::vector<bool>& isKept)
+{
+    std::vector<long> newIds(faces_.size(), -1);
+    long keptCount = 0;
+    for (long face = 0; face < faces_.size(); face++) {
+        if (isKept[face]) {
+            newIds[face] = keptCount++;
+        }
+    }
+
+    IndexedMesh mesh;
+    mesh.xs = xs_;
+    mesh.ys = ys_;
+    for (long face = 0; face < faces_.size(); face++) {
+        if (!isKept[face]) {
+            continue;
+        }
+        auto& value = faces_[face];
+        mesh.triangles.push_back({ value.vertices[0], value.vertices[1], value.vertices[2] });
+        std::array<long, 3> neighbours {};
+        for (int edge = 0; edge < 3; edge++) {
+            neighbours[edge] = (value.neighbours[edge] < 0) ? -1 : newIds[value.neighbours[edge]];
+        }
+        mesh.neighbours.push_back(neighbours);
+    }
+    mesh.removeUnusedVertices();
+    return mesh;
+}
@@ -0,0 +1,97 @@
+/**
+ * Copyright 2019 Márton Gergó
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <DistanceField.h>
+#include <functional>
+#include <queue>
+#include <stdexcept>
+#include <utility>
+#include "Parallel.h"
+#include "Triangle.h"
+
+using namespace TpaStarCpp::GeometryLibrary;
+
+DistanceField::DistanceField(std::shared_ptr<TriangleGraph> graph, double radius) :
+    graph_(std::move(graph)),
+    radius_(radius),
+    sourceId_(-1)
+{
+    if (!(radius >= 0.0)) {
+        throw std::invalid_argument("The radius must not be negative");
+    }
+}
+
+DistanceField::DistanceField(std::shared_ptr<TriangleGraph> graph, Vector source, double radius) :
+    DistanceField(std::move(graph), radius)
+{
+    flood(graph_->getTriangleUnder(source).id(), source);
+}
+
+std::vector<DistanceField> DistanceField::measureFrom(std::shared_ptr<TriangleGraph> graph,
+        const std::vector<Vector>& sources, double radius)
+{
+    std::vector<DistanceField> fields;
+    std::vector<long> sourceIds;
+    for (auto source : sources) {
+        sourceIds.push_back(graph->getTriangleUnder(source).id());
+        fields.push_back(DistanceField(graph, radius));
+    }
+    parallelFor(sources.size(), [&](long i) { fields[i].flood(sourceIds[i], sources[i]); });
+    return fields;
+}
+
+void DistanceField::flood(long sourceId, Vector source)
+{
+    sourceId_ = sourceId;
+    distances_.assign(graph_->triangleCount(), std::numeric_limits<double>::infinity());
+    parentIds_.assign(graph_->triangleCount(), -1);
+    auto sourceDistance = graph_->costWithin(sourceId, graph_->metadataOf(sourceId).centroid(), source);
+    if (graph_->isBlocked(sourceId) || (sourceDistance > radius_)) {
+        return;
+    }
+    std::priority_queue<std::pair<double, long>, std::vector<std::pair<double, long>>, std::greater<>> open;
+    distances_[sourceId] = sourceDistance;
+    open.emplace(sourceDistance, sourceId);
+    while (!open.empty()) {
+        auto distance = open.top().first;
+        auto id = open.top().second;
+        open.pop();
+        if (distance > distances_[id]) {
+            continue;
+        }
+        // the neighbours that can step into the triangle, with the cost of that step
+        graph_->forEachStepTo(id, [&](long neighbour, double cost) {
+            auto neighbourDistance = distance + cost;
+            if (!graph_->isBlocked(neighbour) && (neighbourDistance < distances_[neighbour]) && (neighbourDistance <= radius_)) {
+                distances_[neighbour] = neighbourDistance;
+                parentIds_[neighbour] = id;
+                open.emplace(neighbourDistance, neighbour);
+            }
+        });
+    }
+}
+
+std::vector<long> DistanceField::pathFrom(long id)
+{
+    std::vector<long> triangleIds;
+    if (!isReached(id)) {
+        return triangleIds;
+    }
+    for (; id >= 0; id = parentIds_[id]) {
+        triangleIds.push_back(id);
+    }
+    return triangleIds;
+}
@@ -0,0 +1,104 @@
+/**
+ * Copyright 2019 Márton Gergó
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <DistanceMatrix.h>
+#include <limits>
+#include "Parallel.h"
+#include "Triangle.h"
+
+using namespace TpaStarCpp::GeometryLibrary;
+
+DistanceMatrix::DistanceMatrix(std::shared_ptr<TriangleGraph> graph, std::vector<Vector> waypoints) :
+    graph_(std::move(graph)),
+    waypoints_(std::move(waypoints)),
+    firstWaypointIds_(graph_->triangleCount(), -1),
+    nextWaypointIds_(waypoints_.size(), -1),
+    costs_(waypoints_.size() * waypoints_.size(), std::numeric_limits<double>::infinity()),
+    corridorSearch_(graph_)
+{
+    for (long i = 0; i < size(); i++) {
+        auto id = graph_->getTriangleUnder(waypoints_[i]).id();
+        triangleIds_.push_back(id);
+        nextWaypointIds_[i] = firstWaypointIds_[id];
+        firstWaypointIds_[id] = i;
+    }
+    std::vector<SearchNodes> threadNodes;
+    for (long i = 0; i < parallelThreadCount(size()); i++) {
+        threadNodes.emplace_back(graph_->triangleCount());
+    }
+    parallelForWithThreadIds(size(), [&](long i, long threadId) { measureFrom(i, threadNodes[threadId]); });
+}
+
+/*
+ * Without links, fills the costs towards the waypoints after the specified one, in both directions. The chain of a
+ * triangle lists the higher indices first, so it can be left as soon as the index is not above the source.
+ * Links may lead one way only, then the search fills the whole row of the source and nothing else.
+ */
+void DistanceMatrix::measureFrom(long waypointId, SearchNodes& nodes)
+{
+    auto count = size();
+    auto isSymmetric = graph_->offMeshLinkCount() == 0;
+    auto firstTarget = isSymmetric ? waypointId + 1 : 0;
+    costs_[waypointId * count + waypointId] = 0.0;
+    auto sourceId = triangleIds_[waypointId];
+    if (graph_->isBlocked(sourceId)) {
+        return;
+    }
+    auto source = waypoints_[waypointId];
+    // waypoints on blocked triangles are never reached, they must not keep the search going
+    long remaining = 0;
+    for (auto target = firstTarget; target < count; target++) {
+        remaining += ((target == waypointId) || graph_->isBlocked(triangleIds_[target])) ? 0 : 1;
+    }
+    auto setCost = [&](long targetId, double cost) {
+        costs_[waypointId * count + targetId] = cost;
+        if (isSymmetric) {
+            costs_[targetId * count + waypointId] = cost;
+        }
+        remaining--;
+    };
+
+    nodes.start();
+    nodes.visit(sourceId, graph_->costWithin(sourceId, source, graph_->metadataOf(sourceId).centroid()), -1);
+    nodes.push(nodes.gScoreOf(sourceId), sourceId);
+    while ((remaining > 0) && nodes.hasOpen()) {
+        auto id = nodes.pop();
+        nodes.close(id);
+        auto g = nodes.gScoreOf(id);
+        for (auto target = firstWaypointIds_[id]; target >= firstTarget; target = nextWaypointIds_[target]) {
+            if (target == waypointId) {
+                continue;
+            }
+            // waypoints sharing the triangle of the source are connected directly, like in the searches
+            setCost(target, (id == sourceId) ? graph_->costWithin(id, source, waypoints_[target])
+                    : g + graph_->costWithin(id, graph_->metadataOf(id).centroid(), waypoints_[target]));
+        }
+        graph_->forEachStepFrom(id, [&](long neighbour, double cost) {
+            auto neighbourG = g + cost;
+            if (!graph_->isBlocked(neighbour) && (!nodes.isVisited(neighbour) || (neighbourG < nodes.gScoreOf(neighbour)))) {
+                nodes.visit(neighbour, neighbourG, id);
+                nodes.push(neighbourG, neighbour);
+            }
+        });
+    }
+}
+
+std::vector<long> DistanceMatrix::corridorBetween(long fromId, long toId)
+{
+    auto result = corridorSearch_.findPath(triangleIds_[fromId], waypoints_[fromId], triangleIds_[toId], waypoints_[toId],
+            [](long) { return true; });
+    return result.triangleIds;
+}
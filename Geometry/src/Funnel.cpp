@@ -0,0 +1,67 @@
+/**
+ * Copyright 2019 Márton Gergó
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <Funnel.h>
+#include <algorithm>
+#include <stdexcept>
+
+using namespace TpaStarCpp::GeometryLibrary;
+
+Funnel::Funnel(std::shared_ptr<TriangleGraph> graph, double radius) :
+    graph_(std::move(graph)),
+    radius_(radius)
+{
+    if (!(radius_ >= 0.0)) {
+        throw std::invalid_argument("The radius of the agent must not be negative");
+    }
+}
+
+Funnel::Portal Funnel::portalBetween(long fromId, long toId)
+{
+    int edge = 0;
+    while ((edge < 3) && (graph_->neighbourIdAcross(fromId, edge) != toId)) {
+        edge++;
+    }
+    if (edge == 3) {
+        auto linkId = graph_->findOffMeshLink(fromId, toId);
+        if (linkId < 0) {
+            throw std::invalid_argument("The triangles of the corridor must be neighbours of each other");
+        }
+        auto& link = graph_->offMeshLinkOf(linkId);
+        return { link.entryX, link.entryY, link.entryX, link.entryY, true, link.exitX, link.exitY };
+    }
+    auto a = graph_->cornerOf(fromId, 0);
+    auto b = graph_->cornerOf(fromId, 1);
+    auto c = graph_->cornerOf(fromId, 2);
+    auto isCounterClockwise = crossOf(a.x(), a.y(), b.x(), b.y(), c.x(), c.y()) > 0.0;
+    // leaving a counterclockwise triangle, the next corner of the edge is on the left
+    auto leftCorner = isCounterClockwise ? (edge + 1) % 3 : edge;
+    auto rightCorner = isCounterClockwise ? edge : (edge + 1) % 3;
+    auto left = graph_->cornerOf(fromId, leftCorner);
+    auto right = graph_->cornerOf(fromId, rightCorner);
+    if (radius_ == 0.0) {
+        return { left.x(), left.y(), right.x(), right.y(), false, 0.0, 0.0 };
+    }
+    // no further than the middle of the portal, where an agent too wide for it would be squeezed through
+    auto length = left.distanceFrom(right);
+    auto offset = (length > 0.0) ? std::min(radius_, 0.5 * length) / length : 0.0;
+    auto leftOffset = graph_->isObstacleCorner(fromId, leftCorner) ? offset : 0.0;
+    auto rightOffset = graph_->isObstacleCorner(fromId, rightCorner) ? offset : 0.0;
+    auto dx = right.x() - left.x();
+    auto dy = right.y() - left.y();
+    return { left.x() + leftOffset * dx, left.y() + leftOffset * dy,
+             right.x() - rightOffset * dx, right.y() - rightOffset * dy, false, 0.0, 0.0 };
+}
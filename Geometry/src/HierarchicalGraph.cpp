@@ -0,0 +1,403 @@
+/**
+ * Copyright 2019 Márton Gergó
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <HierarchicalGraph.h>
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <queue>
+#include <stdexcept>
+#include <tuple>
+#include "Parallel.h"
+#include "Vector.h"
+
+using namespace TpaStarCpp::GeometryLibrary;
+
+namespace {
+
+    constexpr double INFINITE_DISTANCE = std::numeric_limits<double>::infinity();
+
+    struct Crossing {
+        long fromClusterId;
+        long toClusterId;
+        long fromId;
+        long toId;
+        int edge;
+    };
+
+    long rootOf(std::vector<long>& parents, long id)
+    {
+        while (parents[id] != id) {
+            parents[id] = parents[parents[id]];
+            id = parents[id];
+        }
+        return id;
+    }
+
+}
+
+HierarchicalGraph::HierarchicalGraph(std::shared_ptr<TriangleGraph> graph, long clusterSize) :
+    graph_(std::move(graph)),
+    refinement_(graph_)
+{
+    if (clusterSize < 1) {
+        throw std::invalid_argument("The cluster size must be positive");
+    }
+    partition(clusterSize);
+    findEntrances();
+    clusterDistances_.resize(clusterCount());
+    parallelFor(clusterCount(), [this](long clusterId) { measureCluster(clusterId); });
+    nodes_ = SearchNodes(nodeCount() + 2);
+    isClusterOnRoute_.assign(clusterCount(), 0);
+}
+
+// Cells of a grid holding about clusterSize triangles each, split further into their connected parts
+void HierarchicalGraph::partition(long clusterSize)
+{
+    long count = graph_->triangleCount();
+    double minX = INFINITE_DISTANCE;
+    double minY = INFINITE_DISTANCE;
+    double maxX = -INFINITE_DISTANCE;
+    double maxY = -INFINITE_DISTANCE;
+    for (long id = 0; id < count; id++) {
+        auto& metadata = graph_->metadataOf(id);
+        minX = std::min(minX, metadata.centroidX);
+        minY = std::min(minY, metadata.centroidY);
+        maxX = std::max(maxX, metadata.centroidX);
+        maxY = std::max(maxY, metadata.centroidY);
+    }
+    auto width = std::max(maxX - minX, Vector::EQUALITY_CHECK_TOLERANCE);
+    auto height = std::max(maxY - minY, Vector::EQUALITY_CHECK_TOLERANCE);
+    auto cellCount = std::max(1.0, static_cast<double>(count) / clusterSize);
+    auto columns = std::max(1L, std::lround(std::sqrt(cellCount * width / height)));
+    auto rows = std::max(1L, static_cast<long>(std::ceil(cellCount / columns)));
+    std::vector<long> cells(count);
+    for (long id = 0; id < count; id++) {
+        auto& metadata = graph_->metadataOf(id);
+        auto column = std::min(columns - 1, static_cast<long>((metadata.centroidX - minX) / width * columns));
+        auto row = std::min(rows - 1, static_cast<long>((metadata.centroidY - minY) / height * rows));
+        cells[id] = row * columns + column;
+    }
+
+    clusterIds_.assign(count, -1);
+    long clusterCount = 0;
+    std::vector<long> stack;
+    for (long id = 0; id < count; id++) {
+        if (clusterIds_[id] >= 0) {
+            continue;
+        }
+        clusterIds_[id] = clusterCount;
+        stack.push_back(id);
+        while (!stack.empty()) {
+            auto current = stack.back();
+            stack.pop_back();
+            for (auto neighbour : graph_->neighbourIdsOf(current)) {
+                if ((clusterIds_[neighbour] < 0) && (cells[neighbour] == cells[id])) {
+                    clusterIds_[neighbour] = clusterCount;
+                    stack.push_back(neighbour);
+                }
+            }
+        }
+        clusterCount++;
+    }
+
+    clusterStarts_.assign(clusterCount + 1, 0);
+    for (auto clusterId : clusterIds_) {
+        clusterStarts_[clusterId + 1]++;
+    }
+    std::partial_sum(begin(clusterStarts_), end(clusterStarts_), begin(clusterStarts_));
+    clusterTriangleIds_.resize(count);
+    localIds_.resize(count);
+    auto positions = clusterStarts_;
+    for (long id = 0; id < count; id++) {
+        auto clusterId = clusterIds_[id];
+        localIds_[id] = positions[clusterId] - clusterStarts_[clusterId];
+        clusterTriangleIds_[positions[clusterId]++] = id;
+    }
+}
+
+/*
+ * The edges between two clusters are grouped into runs of edges whose triangles touch each other,
+ * and the edge of each run closest to its middle becomes the entrance. Every link between two clusters
+ * is an entrance of its own, leading one way only.
+ */
+void HierarchicalGraph::findEntrances()
+{
+    std::vector<Crossing> crossings;
+    for (long id = 0; id < graph_->triangleCount(); id++) {
+        for (int edge = 0; edge < 3; edge++) {
+            auto neighbour = graph_->neighbourIdAcross(id, edge);
+            if ((neighbour >= 0) && (clusterIds_[id] < clusterIds_[neighbour])) {
+                crossings.push_back({ clusterIds_[id], clusterIds_[neighbour], id, neighbour, edge });
+            }
+        }
+    }
+    std::sort(begin(crossings), end(crossings), [](const Crossing& lhs, const Crossing& rhs) {
+        return std::tie(lhs.fromClusterId, lhs.toClusterId, lhs.fromId) < std::tie(rhs.fromClusterId, rhs.toClusterId, rhs.fromId);
+    });
+
+    nodeIds_.assign(graph_->triangleCount(), -1);
+    clusterNodeIds_.resize(clusterCount());
+    auto touches = [this](long id, long otherId) {
+        auto& neighbours = graph_->neighbourIdsOf(id);
+        return (id == otherId) || std::binary_search(begin(neighbours), end(neighbours), otherId);
+    };
+    for (long groupStart = 0, groupEnd = 0; groupStart < crossings.size(); groupStart = groupEnd) {
+        while ((groupEnd < crossings.size()) &&
+               (crossings[groupEnd].fromClusterId == crossings[groupStart].fromClusterId) &&
+               (crossings[groupEnd].toClusterId == crossings[groupStart].toClusterId)) {
+            groupEnd++;
+        }
+        std::vector<long> parents(groupEnd - groupStart);
+        std::iota(begin(parents), end(parents), 0);
+        for (long i = groupStart; i < groupEnd; i++) {
+            for (long j = i + 1; j < groupEnd; j++) {
+                if (touches(crossings[i].fromId, crossings[j].fromId) || touches(crossings[i].toId, crossings[j].toId)) {
+                    parents[rootOf(parents, i - groupStart)] = rootOf(parents, j - groupStart);
+                }
+            }
+        }
+        for (long root = 0; root < parents.size(); root++) {
+            if (rootOf(parents, root) != root) {
+                continue;
+            }
+            double sumX = 0.0;
+            double sumY = 0.0;
+            long runLength = 0;
+            for (long i = groupStart; i < groupEnd; i++) {
+                if (rootOf(parents, i - groupStart) == root) {
+                    auto& metadata = graph_->metadataOf(crossings[i].fromId);
+                    sumX += metadata.edgeMidpointsX[crossings[i].edge];
+                    sumY += metadata.edgeMidpointsY[crossings[i].edge];
+                    runLength++;
+                }
+            }
+            long entrance = -1;
+            double entranceDistance = INFINITE_DISTANCE;
+            for (long i = groupStart; i < groupEnd; i++) {
+                if (rootOf(parents, i - groupStart) == root) {
+                    auto& metadata = graph_->metadataOf(crossings[i].fromId);
+                    auto distance = std::hypot(metadata.edgeMidpointsX[crossings[i].edge] - sumX / runLength,
+                                               metadata.edgeMidpointsY[crossings[i].edge] - sumY / runLength);
+                    if (distance < entranceDistance) {
+                        entrance = i;
+                        entranceDistance = distance;
+                    }
+                }
+            }
+            auto& crossing = crossings[entrance];
+            auto fromNode = nodeOf(crossing.fromId);
+            auto toNode = nodeOf(crossing.toId);
+            auto cost = graph_->crossingCostOf(crossing.fromId, crossing.edge);
+            interEdges_[fromNode].emplace_back(toNode, cost);
+            interEdges_[toNode].emplace_back(fromNode, cost);
+        }
+    }
+    for (long link = 0; link < graph_->offMeshLinkCount(); link++) {
+        auto& offMeshLink = graph_->offMeshLinkOf(link);
+        if (clusterIds_[offMeshLink.fromId] != clusterIds_[offMeshLink.toId]) {
+            interEdges_[nodeOf(offMeshLink.fromId)].emplace_back(nodeOf(offMeshLink.toId), graph_->linkCostOf(link));
+        }
+    }
+}
+
+long HierarchicalGraph::nodeOf(long triangleId)
+{
+    if (nodeIds_[triangleId] < 0) {
+        auto& nodes = clusterNodeIds_[clusterIds_[triangleId]];
+        nodeIds_[triangleId] = nodeTriangleIds_.size();
+        nodeTriangleIds_.push_back(triangleId);
+        nodeLocalIds_.push_back(nodes.size());
+        interEdges_.emplace_back();
+        nodes.push_back(nodeIds_[triangleId]);
+    }
+    return nodeIds_[triangleId];
+}
+
+void HierarchicalGraph::measureCluster(long clusterId)
+{
+    auto& nodes = clusterNodeIds_[clusterId];
+    auto nodeCount = nodes.size();
+    std::vector<double> nodeDistances(nodeCount * nodeCount, INFINITE_DISTANCE);
+    std::vector<double> distances;
+    for (long i = 0; i < nodeCount; i++) {
+        measureFrom(nodeTriangleIds_[nodes[i]], distances);
+        for (long j = 0; j < nodeCount; j++) {
+            nodeDistances[i * nodeCount + j] = distances[localIds_[nodeTriangleIds_[nodes[j]]]];
+        }
+    }
+    clusterDistances_[clusterId] = std::move(nodeDistances);
+}
+
+// Dijkstra from the triangle to every other triangle of its cluster, without leaving the cluster
+long HierarchicalGraph::measureFrom(long sourceId, std::vector<double>& distances)
+{
+    auto clusterId = clusterIds_[sourceId];
+    distances.assign(clusterStarts_[clusterId + 1] - clusterStarts_[clusterId], INFINITE_DISTANCE);
+    if (graph_->isBlocked(sourceId)) {
+        return 0;
+    }
+    std::priority_queue<std::pair<double, long>, std::vector<std::pair<double, long>>, std::greater<>> open;
+    distances[localIds_[sourceId]] = 0.0;
+    open.emplace(0.0, sourceId);
+    long expandedCount = 0;
+    while (!open.empty()) {
+        auto [distance, id] = open.top();
+        open.pop();
+        if (distance > distances[localIds_[id]]) {
+            continue;
+        }
+        expandedCount++;
+        for (int edge = 0; edge < 3; edge++) {
+            auto neighbour = graph_->neighbourIdAcross(id, edge);
+            if ((neighbour < 0) || (clusterIds_[neighbour] != clusterId) || graph_->isBlocked(neighbour)) {
+                continue;
+            }
+            auto neighbourDistance = distance + graph_->crossingCostOf(id, edge);
+            if (neighbourDistance < distances[localIds_[neighbour]]) {
+                distances[localIds_[neighbour]] = neighbourDistance;
+                open.emplace(neighbourDistance, neighbour);
+            }
+        }
+    }
+    return expandedCount;
+}
+
+void HierarchicalGraph::refresh(const std::vector<long>& triangleIds)
+{
+    std::vector<long> clusterIds;
+    for (auto id : triangleIds) {
+        clusterIds.push_back(clusterIds_.at(id));
+    }
+    std::sort(begin(clusterIds), end(clusterIds));
+    clusterIds.erase(std::unique(begin(clusterIds), end(clusterIds)), end(clusterIds));
+    parallelFor(clusterIds.size(), [&](long i) { measureCluster(clusterIds[i]); });
+}
+
+/*
+ * The start and the goal join the abstract graph as two extra nodes, connected to the nodes of their clusters
+ * by the distances measured inside the cluster, and to each other if they share a cluster.
+ */
+SearchResult HierarchicalGraph::findPath(Vector start, Vector goal)
+{
+    auto startId = graph_->findIdOfTriangleUnder(start);
+    if (startId < 0) {
+        throw std::invalid_argument("The specified start point is not contained by any triangle in this graph");
+    }
+    auto goalId = graph_->findIdOfTriangleUnder(goal);
+    if (goalId < 0) {
+        throw std::invalid_argument("The specified goal point is not contained by any triangle in this graph");
+    }
+    if (graph_->isBlocked(startId) || graph_->isBlocked(goalId)) {
+        return SearchResult::notFound(0);
+    }
+    if (startId == goalId) {
+        return SearchResult { true, { startId }, graph_->costWithin(startId, start, goal), 1 };
+    }
+
+    std::vector<double> fromStart;
+    std::vector<double> toGoal;
+    auto expandedCount = measureFrom(startId, fromStart) + measureFrom(goalId, toGoal);
+    auto startCluster = clusterIds_[startId];
+    auto goalCluster = clusterIds_[goalId];
+    auto startCost = graph_->costWithin(startId, start, graph_->metadataOf(startId).centroid());
+    auto goalCost = graph_->costWithin(goalId, graph_->metadataOf(goalId).centroid(), goal);
+    auto minMultiplier = graph_->minCostMultiplier();
+    auto startNode = nodeCount();
+    auto goalNode = nodeCount() + 1;
+    auto goalX = goal.x();
+    auto goalY = goal.y();
+
+    nodes_.start();
+    auto relax = [&](long fromNode, long toNode, double g) {
+        if (nodes_.isClosed(toNode)) {
+            return;
+        }
+        if (!nodes_.isVisited(toNode) || (g < nodes_.gScoreOf(toNode))) {
+            nodes_.visit(toNode, g, fromNode);
+            auto heuristic = 0.0;
+            if (toNode < startNode) {
+                auto& metadata = graph_->metadataOf(nodeTriangleIds_[toNode]);
+                heuristic = minMultiplier * std::hypot(metadata.centroidX - goalX, metadata.centroidY - goalY);
+            }
+            nodes_.push(g + heuristic, toNode);
+        }
+    };
+    nodes_.visit(startNode, 0.0, -1);
+    nodes_.push(0.0, startNode);
+    while (nodes_.hasOpen()) {
+        auto node = nodes_.pop();
+        nodes_.close(node);
+        expandedCount++;
+        if (node == goalNode) {
+            return refine(startId, start, goalId, goal, expandedCount);
+        }
+        if (node == startNode) {
+            for (auto clusterNode : clusterNodeIds_[startCluster]) {
+                auto distance = fromStart[localIds_[nodeTriangleIds_[clusterNode]]];
+                if (distance < INFINITE_DISTANCE) {
+                    relax(startNode, clusterNode, startCost + distance);
+                }
+            }
+            if ((startCluster == goalCluster) && (fromStart[localIds_[goalId]] < INFINITE_DISTANCE)) {
+                relax(startNode, goalNode, startCost + fromStart[localIds_[goalId]] + goalCost);
+            }
+            continue;
+        }
+
+        auto triangleId = nodeTriangleIds_[node];
+        auto clusterId = clusterIds_[triangleId];
+        auto g = nodes_.gScoreOf(node);
+        for (auto [neighbourNode, cost] : interEdges_[node]) {
+            if (!graph_->isBlocked(nodeTriangleIds_[neighbourNode])) {
+                relax(node, neighbourNode, g + cost);
+            }
+        }
+        auto& clusterNodes = clusterNodeIds_[clusterId];
+        auto& distances = clusterDistances_[clusterId];
+        auto row = nodeLocalIds_[node] * clusterNodes.size();
+        for (long j = 0; j < clusterNodes.size(); j++) {
+            if ((clusterNodes[j] != node) && (distances[row + j] < INFINITE_DISTANCE)) {
+                relax(node, clusterNodes[j], g + distances[row + j]);
+            }
+        }
+        if ((clusterId == goalCluster) && (toGoal[localIds_[triangleId]] < INFINITE_DISTANCE)) {
+            relax(node, goalNode, g + toGoal[localIds_[triangleId]] + goalCost);
+        }
+    }
+    return SearchResult::notFound(expandedCount);
+}
+
+// Searches the triangles again, restricted to the clusters the abstract route passes through
+SearchResult HierarchicalGraph::refine(long startId, Vector start, long goalId, Vector goal, long expandedCount)
+{
+    auto markRoute = [&](uint8_t isOnRoute) {
+        isClusterOnRoute_[clusterIds_[startId]] = isOnRoute;
+        isClusterOnRoute_[clusterIds_[goalId]] = isOnRoute;
+        for (auto node = nodes_.parentIdOf(nodeCount() + 1); node < nodeCount(); node = nodes_.parentIdOf(node)) {
+            isClusterOnRoute_[clusterIds_[nodeTriangleIds_[node]]] = isOnRoute;
+        }
+    };
+    markRoute(1);
+    auto result = refinement_.findPath(startId, start, goalId, goal, [this](long id) {
+        return isClusterOnRoute_[clusterIds_[id]] != 0;
+    });
+    markRoute(0);
+    result.expandedCount += expandedCount;
+    return result;
+}
@@ -0,0 +1,64 @@
+/**
+ * Copyright 2019 Márton Gergó
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <HilbertCurve.h>
+#include <algorithm>
+#include <numeric>
+#include <utility>
+
+using namespace TpaStarCpp::GeometryLibrary;
+
+// source: https://en.wikipedia.org/wiki/Hilbert_curve#Applications_and_mapping_algorithms
+uint64_t HilbertCurve::indexOf(uint32_t x, uint32_t y)
+{
+    uint64_t index = 0;
+    for (uint32_t s = RESOLUTION / 2; s > 0; s /= 2) {
+        uint32_t rx = (x & s) > 0 ? 1 : 0;
+        uint32_t ry = (y & s) > 0 ? 1 : 0;
+        index += static_cast<uint64_t>(s) * s * ((3 * rx) ^ ry);
+        if (ry == 0) {
+            if (rx == 1) {
+                x = RESOLUTION - 1 - x;
+                y = RESOLUTION - 1 - y;
+            }
+            std::swap(x, y);
+        }
+    }
+    return index;
+}
+
+std::vector<long> HilbertCurve::sortedOrder(const std::vector<double>& xs, const std::vector<double>& ys)
+{
+    std::vector<long> order(xs.size());
+    std::iota(begin(order), end(order), 0);
+    if (xs.empty()) {
+        return order;
+    }
+
+    auto [minX, maxX] = std::minmax_element(begin(xs), end(xs));
+    auto [minY, maxY] = std::minmax_element(begin(ys), end(ys));
+    double extent = std::max({ *maxX - *minX, *maxY - *minY, 1e-12 });
+    double scale = (RESOLUTION - 1) / extent;
+
+    std::vector<uint64_t> indices(xs.size());
+    for (long i = 0; i < xs.size(); i++) {
+        auto x = static_cast<uint32_t>((xs[i] - *minX) * scale);
+        auto y = static_cast<uint32_t>((ys[i] - *minY) * scale);
+        indices[i] = indexOf(x, y);
+    }
+    std::stable_sort(begin(order), end(order), [&](long i, long j) { return indices[i] < indices[j]; });
+    return order;
+}
@@ -0,0 +1,226 @@
+/**
+ * Copyright 2019 Márton Gergó
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <IncrementalSearch.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+using namespace TpaStarCpp::GeometryLibrary;
+
+namespace {
+
+    constexpr double INFINITE_DISTANCE = std::numeric_limits<double>::infinity();
+
+    template <typename Entry>
+    bool isLater(const Entry& lhs, const Entry& rhs)
+    {
+        return (lhs.primaryKey > rhs.primaryKey) || ((lhs.primaryKey == rhs.primaryKey) && (lhs.secondaryKey > rhs.secondaryKey));
+    }
+
+}
+
+IncrementalSearch::IncrementalSearch(std::shared_ptr<TriangleGraph> graph) :
+    graph_(std::move(graph))
+{
+}
+
+long IncrementalSearch::locate(Vector point, const char* message)
+{
+    auto id = graph_->findIdOfTriangleUnder(point);
+    if (id < 0) {
+        throw std::invalid_argument(message);
+    }
+    return id;
+}
+
+// the straight line distance between the centroids, scaled by the lowest multiplier, never overestimates the steps between them
+double IncrementalSearch::estimateOf(long id)
+{
+    auto& metadata = graph_->metadataOf(id);
+    auto& start = graph_->metadataOf(startId_);
+    return minCostMultiplier_ * std::hypot(metadata.centroidX - start.centroidX, metadata.centroidY - start.centroidY);
+}
+
+IncrementalSearch::OpenEntry IncrementalSearch::entryOf(long id)
+{
+    auto distance = std::min(gScores_[id], rhsScores_[id]);
+    return { distance + estimateOf(id) + keyOffset_, distance, id };
+}
+
+// Older entries of the triangle stay in the heap and are skipped when their key does not match any more
+void IncrementalSearch::queue(long id)
+{
+    auto entry = entryOf(id);
+    queuedKeys_[id] = entry.primaryKey;
+    open_.push_back(entry);
+    std::push_heap(begin(open_), end(open_), isLater<OpenEntry>);
+}
+
+void IncrementalSearch::updateTriangle(long id)
+{
+    if (id != goalId_) {
+        auto rhs = INFINITE_DISTANCE;
+        if (!graph_->isBlocked(id)) {
+            graph_->forEachStepFrom(id, [&](long neighbour, double cost) {
+                if (!graph_->isBlocked(neighbour)) {
+                    rhs = std::min(rhs, cost + gScores_[neighbour]);
+                }
+            });
+        }
+        rhsScores_[id] = rhs;
+    }
+    queuedKeys_[id] = std::numeric_limits<double>::quiet_NaN();
+    if (gScores_[id] != rhsScores_[id]) {
+        queue(id);
+    }
+}
+
+// the distances of the triangles stepping into this one depend on its distance, links are followed backwards
+void IncrementalSearch::updatePredecessors(long id)
+{
+    graph_->forEachStepTo(id, [&](long neighbour, double) { updateTriangle(neighbour); });
+}
+
+void IncrementalSearch::computeShortestPath()
+{
+    expandedCount_ = 0;
+    while (!open_.empty()) {
+        auto top = open_.front();
+        if (queuedKeys_[top.id] != top.primaryKey) {
+            std::pop_heap(begin(open_), end(open_), isLater<OpenEntry>);
+            open_.pop_back();
+            continue;
+        }
+        auto startEntry = entryOf(startId_);
+        if (!isLater(startEntry, top) && (gScores_[startId_] == rhsScores_[startId_])) {
+            break;
+        }
+        std::pop_heap(begin(open_), end(open_), isLater<OpenEntry>);
+        open_.pop_back();
+        auto id = top.id;
+        queuedKeys_[id] = std::numeric_limits<double>::quiet_NaN();
+        auto current = entryOf(id);
+        if (isLater(current, top)) {
+            // the start moved since the triangle was queued
+            queue(id);
+            continue;
+        }
+        expandedCount_++;
+        if (gScores_[id] > rhsScores_[id]) {
+            gScores_[id] = rhsScores_[id];
+        } else {
+            gScores_[id] = INFINITE_DISTANCE;
+            updateTriangle(id);
+        }
+        updatePredecessors(id);
+    }
+}
+
+// Steps to the neighbour with the lowest distance to the goal until the goal is reached
+SearchResult IncrementalSearch::buildResult()
+{
+    auto distance = gScores_[startId_];
+    if (graph_->isBlocked(startId_) || graph_->isBlocked(goalId_) || !(distance < INFINITE_DISTANCE)) {
+        return SearchResult::notFound(expandedCount_);
+    }
+    if (startId_ == goalId_) {
+        auto cost = graph_->costMultiplierOf(startId_) * std::hypot(startX_ - goalX_, startY_ - goalY_);
+        return SearchResult { true, { startId_ }, cost, expandedCount_ };
+    }
+    auto& start = graph_->metadataOf(startId_);
+    auto startCost = graph_->costMultiplierOf(startId_) * std::hypot(start.centroidX - startX_, start.centroidY - startY_);
+    auto& goal = graph_->metadataOf(goalId_);
+    auto goalCost = graph_->costMultiplierOf(goalId_) * std::hypot(goal.centroidX - goalX_, goal.centroidY - goalY_);
+    std::vector<long> triangleIds { startId_ };
+    for (auto id = startId_; id != goalId_;) {
+        long nextId = -1;
+        auto nextDistance = INFINITE_DISTANCE;
+        graph_->forEachStepFrom(id, [&](long neighbour, double cost) {
+            if (!graph_->isBlocked(neighbour) && (cost + gScores_[neighbour] < nextDistance)) {
+                nextDistance = cost + gScores_[neighbour];
+                nextId = neighbour;
+            }
+        });
+        if ((nextId < 0) || (triangleIds.size() > graph_->triangleCount())) {
+            return SearchResult::notFound(expandedCount_);
+        }
+        triangleIds.push_back(nextId);
+        id = nextId;
+    }
+    return SearchResult { true, std::move(triangleIds), startCost + distance + goalCost, expandedCount_ };
+}
+
+SearchResult IncrementalSearch::findPath(Vector start, Vector goal)
+{
+    auto startId = locate(start, "The specified start point is not contained by any triangle in this graph");
+    auto goalId = locate(goal, "The specified goal point is not contained by any triangle in this graph");
+    startId_ = startId;
+    goalId_ = goalId;
+    startX_ = start.x();
+    startY_ = start.y();
+    goalX_ = goal.x();
+    goalY_ = goal.y();
+    return restart();
+}
+
+SearchResult IncrementalSearch::restart()
+{
+    minCostMultiplier_ = graph_->minCostMultiplier();
+    keyOffset_ = 0.0;
+    gScores_.assign(graph_->triangleCount(), INFINITE_DISTANCE);
+    rhsScores_.assign(graph_->triangleCount(), INFINITE_DISTANCE);
+    queuedKeys_.assign(graph_->triangleCount(), std::numeric_limits<double>::quiet_NaN());
+    open_.clear();
+    rhsScores_[goalId_] = 0.0;
+    queue(goalId_);
+    computeShortestPath();
+    return buildResult();
+}
+
+SearchResult IncrementalSearch::moveStart(Vector start)
+{
+    if (goalId_ < 0) {
+        throw std::invalid_argument("There is no search to continue");
+    }
+    auto startId = locate(start, "The specified start point is not contained by any triangle in this graph");
+    auto& previous = graph_->metadataOf(startId_);
+    auto& current = graph_->metadataOf(startId);
+    keyOffset_ += minCostMultiplier_ * std::hypot(previous.centroidX - current.centroidX, previous.centroidY - current.centroidY);
+    startId_ = startId;
+    startX_ = start.x();
+    startY_ = start.y();
+    computeShortestPath();
+    return buildResult();
+}
+
+SearchResult IncrementalSearch::replan(const std::vector<long>& changedTriangleIds)
+{
+    if (goalId_ < 0) {
+        throw std::invalid_argument("There is no search to continue");
+    }
+    // the queued keys would overestimate with a multiplier below the one they were measured with
+    if (graph_->minCostMultiplier() < minCostMultiplier_) {
+        return restart();
+    }
+    for (auto id : changedTriangleIds) {
+        updateTriangle(id);
+        updatePredecessors(id);
+    }
+    computeShortestPath();
+    return buildResult();
+}
@@ -0,0 +1,55 @@
+/**
+ * Copyright 2019 Márton Gergó
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <IndexedMesh.h>
+
+using namespace TpaStarCpp::GeometryLibrary;
+
+std::vector<TriangleSkeleton> IndexedMesh::toTriangleSkeletons() const
+{
+    std::vector<TriangleSkeleton> skeletons;
+    skeletons.reserve(triangles.size());
+    for (auto& corners : triangles) {
+        skeletons.emplace_back(Vector(xs[corners[0]], ys[corners[0]]),
+                               Vector(xs[corners[1]], ys[corners[1]]),
+                               Vector(xs[corners[2]], ys[corners[2]]));
+    }
+    return skeletons;
+}
+
+void IndexedMesh::removeUnusedVertices()
+{
+    std::vector<long> newIds(xs.size(), -1);
+    std::vector<double> usedXs;
+    std::vector<double> usedYs;
+    std::vector<double> usedHeights;
+    for (auto& corners : triangles) {
+        for (auto& corner : corners) {
+            if (newIds[corner] < 0) {
+                newIds[corner] = usedXs.size();
+                usedXs.push_back(xs[corner]);
+                usedYs.push_back(ys[corner]);
+                if (!heights.empty()) {
+                    usedHeights.push_back(heights[corner]);
+                }
+            }
+            corner = newIds[corner];
+        }
+    }
+    xs = std::move(usedXs);
+    ys = std::move(usedYs);
+    heights = std::move(usedHeights);
+}
@@ -0,0 +1,237 @@
+/**
+ * Copyright 2019 Márton Gergó
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <LandmarkHeuristic.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <stdexcept>
+#include "Parallel.h"
+
+using namespace TpaStarCpp::GeometryLibrary;
+
+namespace {
+
+    constexpr char MAGIC[4] = { 'T', 'P', 'A', 'L' };
+    constexpr uint32_t FORMAT_VERSION = 1;
+
+    void writeUnsigned(std::ostream& output, uint64_t value, int byteCount)
+    {
+        for (int i = 0; i < byteCount; i++) {
+            output.put(static_cast<char>((value >> (8 * i)) & 0xFFu));
+        }
+    }
+
+    uint64_t readUnsigned(std::istream& input, int byteCount)
+    {
+        uint64_t value = 0;
+        for (int i = 0; i < byteCount; i++) {
+            auto byte = input.get();
+            if (byte == std::char_traits<char>::eof()) {
+                throw std::invalid_argument("The landmark data ends unexpectedly");
+            }
+            value |= static_cast<uint64_t>(byte & 0xFF) << (8 * i);
+        }
+        return value;
+    }
+
+    std::vector<double> distancesFrom(TriangleGraph& graph, long sourceId)
+    {
+        std::vector<double> distances(graph.triangleCount(), std::numeric_limits<double>::infinity());
+        std::priority_queue<std::pair<double, long>, std::vector<std::pair<double, long>>, std::greater<>> open;
+        distances[sourceId] = 0.0;
+        open.emplace(0.0, sourceId);
+        auto relax = [&](long neighbour, double neighbourDistance) {
+            if (neighbourDistance < distances[neighbour]) {
+                distances[neighbour] = neighbourDistance;
+                open.emplace(neighbourDistance, neighbour);
+            }
+        };
+        while (!open.empty()) {
+            auto distance = open.top().first;
+            auto id = open.top().second;
+            open.pop();
+            if (distance > distances[id]) {
+                continue;
+            }
+            // links are taken both ways, the distances have to be symmetric for the estimates to hold
+            graph.forEachStepFrom(id, [&](long neighbour, double cost) { relax(neighbour, distance + cost); });
+            graph.forEachStepTo(id, [&](long neighbour, double cost) { relax(neighbour, distance + cost); });
+        }
+        return distances;
+    }
+
+}
+
+LandmarkHeuristic::LandmarkHeuristic(std::shared_ptr<TriangleGraph> graph, int landmarkCount) :
+    graph_(std::move(graph))
+{
+    if (landmarkCount < 1) {
+        throw std::invalid_argument("At least one landmark is needed");
+    }
+    selectLandmarks(landmarkCount);
+    measureDistances();
+}
+
+LandmarkHeuristic::LandmarkHeuristic(std::shared_ptr<TriangleGraph> graph, std::vector<long> landmarkIds) :
+    graph_(std::move(graph)),
+    landmarkIds_(std::move(landmarkIds))
+{
+}
+
+// Unreached triangles count as the farthest ones, so every part of a disconnected mesh gets a landmark first
+void LandmarkHeuristic::selectLandmarks(int landmarkCount)
+{
+    long count = graph_->triangleCount();
+    if (count == 0) {
+        return;
+    }
+    constexpr auto UNREACHED = std::numeric_limits<long>::max();
+    std::vector<long> steps(count);
+    std::vector<long> queue;
+    auto measureStepsFrom = [&](long sourceId) {
+        std::fill(begin(steps), end(steps), UNREACHED);
+        steps[sourceId] = 0;
+        queue.assign(1, sourceId);
+        for (long head = 0; head < queue.size(); head++) {
+            auto id = queue[head];
+            for (auto neighbour : graph_->neighbourIdsOf(id)) {
+                if (steps[neighbour] == UNREACHED) {
+                    steps[neighbour] = steps[id] + 1;
+                    queue.push_back(neighbour);
+                }
+            }
+        }
+    };
+
+    // the far end of the mesh seen from an arbitrary triangle is the first landmark
+    measureStepsFrom(0);
+    auto sourceId = std::max_element(begin(steps), end(steps)) - begin(steps);
+    std::vector<long> stepsFromLandmarks(count, UNREACHED);
+    while (landmarkIds_.size() < landmarkCount) {
+        landmarkIds_.push_back(sourceId);
+        measureStepsFrom(sourceId);
+        for (long id = 0; id < count; id++) {
+            stepsFromLandmarks[id] = std::min(stepsFromLandmarks[id], steps[id]);
+        }
+        sourceId = std::max_element(begin(stepsFromLandmarks), end(stepsFromLandmarks)) - begin(stepsFromLandmarks);
+        if (stepsFromLandmarks[sourceId] == 0) {
+            // every triangle is a landmark already
+            break;
+        }
+    }
+}
+
+void LandmarkHeuristic::measureDistances()
+{
+    long count = graph_->triangleCount();
+    long landmarkCount = landmarkIds_.size();
+    scales_.assign(landmarkCount, 1.0);
+    distances_.assign(count * landmarkCount, UNREACHABLE);
+    parallelFor(landmarkCount, [&](long landmark) {
+        auto distances = distancesFrom(*graph_, landmarkIds_[landmark]);
+        double maxDistance = 0.0;
+        for (auto distance : distances) {
+            maxDistance = std::isinf(distance) ? maxDistance : std::max(maxDistance, distance);
+        }
+        auto scale = (maxDistance > 0.0) ? (UNREACHABLE - 1) / maxDistance : 1.0;
+        scales_[landmark] = scale;
+        for (long id = 0; id < count; id++) {
+            if (!std::isinf(distances[id])) {
+                distances_[id * landmarkCount + landmark] = static_cast<uint16_t>(std::lround(distances[id] * scale));
+            }
+        }
+    });
+}
+
+// Rounding moves each distance by at most half a step, so the difference of two is off by at most one step
+double LandmarkHeuristic::estimate(long id, long goalId)
+{
+    long landmarkCount = landmarkIds_.size();
+    auto from = &distances_[id * landmarkCount];
+    auto to = &distances_[goalId * landmarkCount];
+    double bound = 0.0;
+    for (long i = 0; i < landmarkCount; i++) {
+        if ((from[i] == UNREACHABLE) || (to[i] == UNREACHABLE)) {
+            continue;
+        }
+        auto steps = std::abs(static_cast<int>(from[i]) - static_cast<int>(to[i])) - 1;
+        if (steps > 0) {
+            bound = std::max(bound, steps / scales_[i]);
+        }
+    }
+    return bound;
+}
+
+void LandmarkHeuristic::save(std::ostream& output)
+{
+    output.write(MAGIC, sizeof(MAGIC));
+    writeUnsigned(output, FORMAT_VERSION, 4);
+    writeUnsigned(output, graph_->triangleCount(), 8);
+    writeUnsigned(output, landmarkIds_.size(), 4);
+    for (long i = 0; i < landmarkIds_.size(); i++) {
+        uint64_t scaleBits;
+        std::memcpy(&scaleBits, &scales_[i], sizeof(scaleBits));
+        writeUnsigned(output, landmarkIds_[i], 8);
+        writeUnsigned(output, scaleBits, 8);
+    }
+    for (auto distance : distances_) {
+        writeUnsigned(output, distance, 2);
+    }
+}
+
+LandmarkHeuristic LandmarkHeuristic::load(std::istream& input, std::shared_ptr<TriangleGraph> graph)
+{
+    char magic[sizeof(MAGIC)];
+    if (!input.read(magic, sizeof(magic)) || !std::equal(std::begin(magic), std::end(magic), std::begin(MAGIC))) {
+        throw std::invalid_argument("The data does not hold landmark distances");
+    }
+    if (readUnsigned(input, 4) != FORMAT_VERSION) {
+        throw std::invalid_argument("The landmark data was written in an unsupported format version");
+    }
+    if (readUnsigned(input, 8) != graph->triangleCount()) {
+        throw std::invalid_argument("The landmark data was measured on a different graph");
+    }
+    // the landmarks are distinct triangles, a larger count can only come from corrupt data
+    auto landmarkCount = readUnsigned(input, 4);
+    if (landmarkCount > static_cast<uint64_t>(graph->triangleCount())) {
+        throw std::invalid_argument("The landmark data is malformed");
+    }
+    std::vector<long> landmarkIds;
+    std::vector<double> scales;
+    for (uint64_t i = 0; i < landmarkCount; i++) {
+        auto landmarkId = readUnsigned(input, 8);
+        auto scaleBits = readUnsigned(input, 8);
+        double scale;
+        std::memcpy(&scale, &scaleBits, sizeof(scale));
+        if ((landmarkId >= static_cast<uint64_t>(graph->triangleCount())) || !(scale > 0.0)) {
+            throw std::invalid_argument("The landmark data is malformed");
+        }
+        landmarkIds.push_back(static_cast<long>(landmarkId));
+        scales.push_back(scale);
+    }
+    LandmarkHeuristic landmarks(std::move(graph), std::move(landmarkIds));
+    landmarks.scales_ = std::move(scales);
+    // grown as the distances arrive, so a truncated file fails before the whole table is allocated
+    auto distanceCount = static_cast<uint64_t>(landmarks.graph_->triangleCount()) * landmarkCount;
+    for (uint64_t i = 0; i < distanceCount; i++) {
+        landmarks.distances_.push_back(readUnsigned(input, 2));
+    }
+    return landmarks;
+}
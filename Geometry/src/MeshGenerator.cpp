@@ -0,0 +1,156 @@
+/**
+ * Copyright 2019 Márton Gergó
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <MeshGenerator.h>
+#include <algorithm>
+#include <stdexcept>
+#include "DelaunayTriangulation.h"
+#include "HilbertCurve.h"
+
+using namespace TpaStarCpp::GeometryLibrary;
+
+namespace {
+
+    /*
+     * The distributions of the standard library are free to map the engine output differently in each
+     * implementation, only the engine itself is specified. Its raw output is turned into numbers here,
+     * so that a seed gives the same mesh with every standard library.
+     */
+    double unitInterval(std::mt19937_64& random)
+    {
+        return static_cast<double>(random() >> 11) * 0x1p-53;
+    }
+
+    long indexBelow(std::mt19937_64& random, long count)
+    {
+        return std::min(static_cast<long>(unitInterval(random) * count), count - 1);
+    }
+
+    // triangulates the open cells of a grid, sharing the corners of neighbouring cells
+    IndexedMesh triangulateCells(long columns, long rows, const std::vector<bool>& isOpen)
+    {
+        IndexedMesh mesh;
+        for (long y = 0; y <= rows; y++) {
+            for (long x = 0; x <= columns; x++) {
+                mesh.xs.push_back(x);
+                mesh.ys.push_back(y);
+            }
+        }
+        for (long y = 0; y < rows; y++) {
+            for (long x = 0; x < columns; x++) {
+                if (!isOpen[y * columns + x]) {
+                    continue;
+                }
+                long lowerLeft = y * (columns + 1) + x;
+                long lowerRight = lowerLeft + 1;
+                long upperLeft = lowerLeft + columns + 1;
+                long upperRight = upperLeft + 1;
+                // alternating diagonals, so that the mesh has no preferred direction
+                if ((x + y) % 2 == 0) {
+                    mesh.triangles.push_back({ lowerLeft, lowerRight, upperRight });
+                    mesh.triangles.push_back({ lowerLeft, upperRight, upperLeft });
+                } else {
+                    mesh.triangles.push_back({ lowerLeft, lowerRight, upperLeft });
+                    mesh.triangles.push_back({ lowerRight, upperRight, upperLeft });
+                }
+            }
+        }
+        mesh.removeUnusedVertices();
+        return mesh;
+    }
+
+}
+
+MeshGenerator::MeshGenerator(unsigned long seed) : random_(seed) { }
+
+IndexedMesh MeshGenerator::gridWithHoles(long columns, long rows, double holeRatio)
+{
+    if ((columns < 1) || (rows < 1)) {
+        throw std::invalid_argument("The grid should have at least one column and row");
+    }
+    std::vector<bool> isOpen(columns * rows);
+    for (long cell = 0; cell < columns * rows; cell++) {
+        isOpen[cell] = !(unitInterval(random_) < holeRatio);
+    }
+    return triangulateCells(columns, rows, isOpen);
+}
+
+IndexedMesh MeshGenerator::randomDelaunay(long columns, long rows)
+{
+    if ((columns < 1) || (rows < 1)) {
+        throw std::invalid_argument("The grid should have at least one column and row");
+    }
+    // jittering by at most a quarter cell keeps the points well spaced, which bounds the angles of the triangles
+    auto jitter = [this]() { return 0.5 * unitInterval(random_) - 0.25; };
+    std::vector<double> xs;
+    std::vector<double> ys;
+    for (long y = 0; y <= rows; y++) {
+        for (long x = 0; x <= columns; x++) {
+            bool isCorner = ((x == 0) || (x == columns)) && ((y == 0) || (y == rows));
+            bool isOnVerticalBorder = (x == 0) || (x == columns);
+            bool isOnHorizontalBorder = (y == 0) || (y == rows);
+            double dx = jitter();
+            double dy = jitter();
+            if (!isCorner) {
+                xs.push_back(x + (isOnVerticalBorder ? 0.0 : dx));
+                ys.push_back(y + (isOnHorizontalBorder ? 0.0 : dy));
+            }
+        }
+    }
+
+    DelaunayTriangulation triangulation(0.0, 0.0, columns, rows);
+    for (auto i : HilbertCurve::sortedOrder(xs, ys)) {
+        triangulation.insertVertex(xs[i], ys[i]);
+    }
+    return triangulation.toIndexedMesh();
+}
+
+IndexedMesh MeshGenerator::corridorMaze(long columns, long rows)
+{
+    if ((columns < 1) || (rows < 1)) {
+        throw std::invalid_argument("The maze should have at least one column and row");
+    }
+    // randomized depth-first search over the maze cells, carving the wall between consecutive cells
+    long gridColumns = 2 * columns + 1;
+    long gridRows = 2 * rows + 1;
+    std::vector<bool> isOpen(gridColumns * gridRows, false);
+    std::vector<bool> isVisited(columns * rows, false);
+    std::vector<long> stack { 0 };
+    isVisited[0] = true;
+    isOpen[gridColumns + 1] = true;
+    while (!stack.empty()) {
+        auto cell = stack.back();
+        long x = cell % columns;
+        long y = cell / columns;
+        std::vector<long> unvisited;
+        if ((x > 0) && !isVisited[cell - 1]) { unvisited.push_back(cell - 1); }
+        if ((x < columns - 1) && !isVisited[cell + 1]) { unvisited.push_back(cell + 1); }
+        if ((y > 0) && !isVisited[cell - columns]) { unvisited.push_back(cell - columns); }
+        if ((y < rows - 1) && !isVisited[cell + columns]) { unvisited.push_back(cell + columns); }
+        if (unvisited.empty()) {
+            stack.pop_back();
+            continue;
+        }
+        auto next = unvisited[indexBelow(random_, unvisited.size())];
+        long nextX = next % columns;
+        long nextY = next / columns;
+        isOpen[(y + nextY + 1) * gridColumns + (x + nextX + 1)] = true;
+        isOpen[(2 * nextY + 1) * gridColumns + (2 * nextX + 1)] = true;
+        isVisited[next] = true;
+        stack.push_back(next);
+    }
+    return triangulateCells(gridColumns, gridRows, isOpen);
+}
@@ -0,0 +1,280 @@
+/**
+ * Copyright 2019 Márton Gergó
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <MeshTile.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <map>
+#include <stdexcept>
+#include <utility>
+#include "TriangleGraph.h"
+
+using namespace TpaStarCpp::GeometryLibrary;
+
+namespace {
+
+    constexpr char MAGIC[4] = { 'T', 'P', 'A', 'T' };
+    constexpr uint32_t FORMAT_VERSION = 2;
+
+    void writeUnsigned(std::ostream& output, uint64_t value, int byteCount)
+    {
+        for (int i = 0; i < byteCount; i++) {
+            output.put(static_cast<char>((value >> (8 * i)) & 0xFFu));
+        }
+    }
+
+    uint64_t readUnsigned(std::istream& input, int byteCount)
+    {
+        uint64_t value = 0;
+        for (int i = 0; i < byteCount; i++) {
+            auto byte = input.get();
+            if (byte == std::char_traits<char>::eof()) {
+                throw std::invalid_argument("The tile data ends unexpectedly");
+            }
+            value |= static_cast<uint64_t>(byte & 0xFF) << (8 * i);
+        }
+        return value;
+    }
+
+    // negative values are written in two's complement, -1 marks the missing neighbours
+    void writeSigned(std::ostream& output, long value)
+    {
+        writeUnsigned(output, static_cast<uint64_t>(static_cast<int64_t>(value)), 8);
+    }
+
+    long readSigned(std::istream& input)
+    {
+        return static_cast<long>(static_cast<int64_t>(readUnsigned(input, 8)));
+    }
+
+    void writeDouble(std::ostream& output, double value)
+    {
+        uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        writeUnsigned(output, bits, 8);
+    }
+
+    double readDouble(std::istream& input)
+    {
+        auto bits = readUnsigned(input, 8);
+        double value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    int edgeTowards(const std::array<long, 3>& neighbours, long id)
+    {
+        for (int edge = 0; edge < 3; edge++) {
+            if (neighbours[edge] == id) {
+                return edge;
+            }
+        }
+        return -1;
+    }
+
+}
+
+std::vector<MeshTile> MeshTile::split(IndexedMesh mesh, double tileSize)
+{
+    if (!(tileSize > 0.0) || !std::isfinite(tileSize)) {
+        throw std::invalid_argument("The tile size has to be positive");
+    }
+    if (mesh.neighbours.empty()) {
+        TriangleGraph graph(mesh);
+        mesh.neighbours.resize(mesh.triangles.size());
+        for (long id = 0; id < static_cast<long>(mesh.triangles.size()); id++) {
+            for (int edge = 0; edge < 3; edge++) {
+                mesh.neighbours[id][edge] = graph.neighbourIdAcross(id, edge);
+            }
+        }
+    }
+
+    // the triangles are numbered within their tiles in the order of the mesh
+    std::map<std::pair<long, long>, long> tileIndices;
+    std::vector<MeshTile> tiles;
+    std::vector<long> tileIndexOf(mesh.triangles.size());
+    std::vector<long> localIds(mesh.triangles.size());
+    for (long id = 0; id < static_cast<long>(mesh.triangles.size()); id++) {
+        auto& corners = mesh.triangles[id];
+        auto centroidX = (mesh.xs[corners[0]] + mesh.xs[corners[1]] + mesh.xs[corners[2]]) / 3.0;
+        auto centroidY = (mesh.ys[corners[0]] + mesh.ys[corners[1]] + mesh.ys[corners[2]]) / 3.0;
+        auto key = std::make_pair(static_cast<long>(std::floor(centroidX / tileSize)),
+                static_cast<long>(std::floor(centroidY / tileSize)));
+        auto found = tileIndices.find(key);
+        if (found == tileIndices.end()) {
+            found = tileIndices.emplace(key, tiles.size()).first;
+            tiles.push_back(MeshTile { { key.first, key.second }, {}, {} });
+        }
+        tileIndexOf[id] = found->second;
+        localIds[id] = tiles[found->second].mesh.triangles.size();
+        tiles[found->second].mesh.triangles.push_back(corners);
+        if (!mesh.layers.empty()) {
+            tiles[found->second].mesh.layers.push_back(mesh.layers[id]);
+        }
+    }
+
+    for (long id = 0; id < static_cast<long>(mesh.triangles.size()); id++) {
+        auto& tile = tiles[tileIndexOf[id]];
+        std::array<long, 3> neighbours { -1, -1, -1 };
+        for (int edge = 0; edge < 3; edge++) {
+            auto neighbour = mesh.neighbours[id][edge];
+            if (neighbour < 0) {
+                continue;
+            }
+            if (tileIndexOf[neighbour] == tileIndexOf[id]) {
+                neighbours[edge] = localIds[neighbour];
+            } else {
+                tile.portals.push_back(TilePortal { localIds[id], edge, tiles[tileIndexOf[neighbour]].coordinates,
+                        localIds[neighbour], edgeTowards(mesh.neighbours[neighbour], id) });
+            }
+        }
+        tile.mesh.neighbours.push_back(neighbours);
+    }
+
+    // every tile keeps only the vertices its triangles use
+    std::vector<long> vertexIds(mesh.xs.size(), -1);
+    std::vector<long> usedVertices;
+    for (auto& tile : tiles) {
+        for (auto& corners : tile.mesh.triangles) {
+            for (auto& corner : corners) {
+                if (vertexIds[corner] < 0) {
+                    vertexIds[corner] = tile.mesh.xs.size();
+                    usedVertices.push_back(corner);
+                    tile.mesh.xs.push_back(mesh.xs[corner]);
+                    tile.mesh.ys.push_back(mesh.ys[corner]);
+                    if (!mesh.heights.empty()) {
+                        tile.mesh.heights.push_back(mesh.heights[corner]);
+                    }
+                }
+                corner = vertexIds[corner];
+            }
+        }
+        for (auto vertex : usedVertices) {
+            vertexIds[vertex] = -1;
+        }
+        usedVertices.clear();
+    }
+    return tiles;
+}
+
+void MeshTile::save(std::ostream& output) const
+{
+    output.write(MAGIC, sizeof(MAGIC));
+    writeUnsigned(output, FORMAT_VERSION, 4);
+    writeSigned(output, coordinates.x);
+    writeSigned(output, coordinates.y);
+    writeUnsigned(output, mesh.xs.size(), 8);
+    for (size_t i = 0; i < mesh.xs.size(); i++) {
+        writeDouble(output, mesh.xs[i]);
+        writeDouble(output, mesh.ys[i]);
+    }
+    writeUnsigned(output, mesh.heights.size(), 8);
+    for (auto height : mesh.heights) {
+        writeDouble(output, height);
+    }
+    writeUnsigned(output, mesh.triangles.size(), 8);
+    for (size_t id = 0; id < mesh.triangles.size(); id++) {
+        for (auto corner : mesh.triangles[id]) {
+            writeUnsigned(output, corner, 8);
+        }
+        for (int edge = 0; edge < 3; edge++) {
+            writeSigned(output, mesh.neighbours.empty() ? -1 : mesh.neighbours[id][edge]);
+        }
+    }
+    writeUnsigned(output, mesh.layers.size(), 8);
+    for (auto layer : mesh.layers) {
+        writeUnsigned(output, layer, 8);
+    }
+    writeUnsigned(output, portals.size(), 8);
+    for (auto& portal : portals) {
+        writeUnsigned(output, portal.id, 8);
+        writeUnsigned(output, portal.edge, 1);
+        writeSigned(output, portal.neighbourTile.x);
+        writeSigned(output, portal.neighbourTile.y);
+        writeUnsigned(output, portal.neighbourId, 8);
+        writeUnsigned(output, portal.neighbourEdge, 1);
+    }
+}
+
+MeshTile MeshTile::load(std::istream& input)
+{
+    char magic[sizeof(MAGIC)];
+    if (!input.read(magic, sizeof(magic)) || !std::equal(std::begin(magic), std::end(magic), std::begin(MAGIC))) {
+        throw std::invalid_argument("The data does not hold a mesh tile");
+    }
+    if (readUnsigned(input, 4) != FORMAT_VERSION) {
+        throw std::invalid_argument("The tile data was written in an unsupported format version");
+    }
+    MeshTile tile;
+    tile.coordinates.x = readSigned(input);
+    tile.coordinates.y = readSigned(input);
+    auto vertexCount = readUnsigned(input, 8);
+    for (uint64_t i = 0; i < vertexCount; i++) {
+        tile.mesh.xs.push_back(readDouble(input));
+        tile.mesh.ys.push_back(readDouble(input));
+    }
+    auto heightCount = readUnsigned(input, 8);
+    if ((heightCount != 0) && (heightCount != vertexCount)) {
+        throw std::invalid_argument("The tile data is malformed");
+    }
+    for (uint64_t i = 0; i < heightCount; i++) {
+        tile.mesh.heights.push_back(readDouble(input));
+    }
+    auto triangleCount = readUnsigned(input, 8);
+    for (uint64_t id = 0; id < triangleCount; id++) {
+        std::array<long, 3> corners;
+        std::array<long, 3> neighbours;
+        for (auto& corner : corners) {
+            corner = readUnsigned(input, 8);
+        }
+        for (auto& neighbour : neighbours) {
+            neighbour = readSigned(input);
+        }
+        for (int k = 0; k < 3; k++) {
+            if ((static_cast<uint64_t>(corners[k]) >= vertexCount) || (neighbours[k] < -1)
+                    || (neighbours[k] >= static_cast<long>(triangleCount))) {
+                throw std::invalid_argument("The tile data is malformed");
+            }
+        }
+        tile.mesh.triangles.push_back(corners);
+        tile.mesh.neighbours.push_back(neighbours);
+    }
+    auto layerCount = readUnsigned(input, 8);
+    if ((layerCount != 0) && (layerCount != triangleCount)) {
+        throw std::invalid_argument("The tile data is malformed");
+    }
+    for (uint64_t id = 0; id < layerCount; id++) {
+        tile.mesh.layers.push_back(readUnsigned(input, 8));
+    }
+    auto portalCount = readUnsigned(input, 8);
+    for (uint64_t i = 0; i < portalCount; i++) {
+        TilePortal portal;
+        portal.id = readUnsigned(input, 8);
+        portal.edge = readUnsigned(input, 1);
+        portal.neighbourTile.x = readSigned(input);
+        portal.neighbourTile.y = readSigned(input);
+        portal.neighbourId = readUnsigned(input, 8);
+        portal.neighbourEdge = readUnsigned(input, 1);
+        if ((static_cast<uint64_t>(portal.id) >= triangleCount) || (portal.edge > 2) || (portal.neighbourId < 0)
+                || (portal.neighbourEdge > 2)) {
+            throw std::invalid_argument("The tile data is malformed");
+        }
+        tile.portals.push_back(portal);
+    }
+    return tile;
+}
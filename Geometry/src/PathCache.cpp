@@ -0,0 +1,187 @@
+/**
+ * Copyright 2019 Márton Gergó
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <PathCache.h>
+#include <algorithm>
+#include <stdexcept>
+
+using namespace TpaStarCpp::GeometryLibrary;
+
+PathCache::PathCache(std::shared_ptr<TriangleGraph> graph, long capacity, long shardCount) :
+    graph_(std::move(graph)),
+    funnel_(graph_),
+    shardCapacity_(0),
+    shards_(shardCount > 0 ? shardCount : 1)
+{
+    if (capacity < 1) {
+        throw std::invalid_argument("The capacity of the cache must be positive");
+    }
+    if (shardCount < 1) {
+        throw std::invalid_argument("The cache must have at least one shard");
+    }
+    shardCapacity_ = std::max(capacity / shardCount, 1L);
+}
+
+uint64_t PathCache::keyOf(long startId, long goalId)
+{
+    return static_cast<uint64_t>(startId) * graph_->triangleCount() + goalId;
+}
+
+PathCache::Shard& PathCache::shardOf(uint64_t key)
+{
+    // consecutive ids are spread over the shards by a multiplicative hash
+    return shards_[((key * 0x9E3779B97F4A7C15ULL) >> 32) % shards_.size()];
+}
+
+bool PathCache::isValid(const Entry& entry)
+{
+    if (entry.unblockCount != graph_->unblockCount()) {
+        return false;
+    }
+    for (auto id : entry.triangleIds) {
+        if (graph_->isBlocked(id)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void PathCache::remove(Shard& shard, long slotId)
+{
+    auto& entry = shard.entries[slotId];
+    shard.slotIds.erase(keyOf(entry.startId, entry.goalId));
+    shard.storedIdCount -= entry.triangleIds.size();
+    std::vector<long>().swap(entry.triangleIds);
+    entry.startId = -1;
+    shard.freeSlotIds.push_back(slotId);
+}
+
+// Moves the clock hand, giving referenced entries a second chance, until the ids fit into the shard
+void PathCache::evict(Shard& shard, long idCount)
+{
+    while (shard.storedIdCount + idCount > shardCapacity_) {
+        shard.hand = (shard.hand + 1) % shard.entries.size();
+        auto& entry = shard.entries[shard.hand];
+        if (entry.startId < 0) {
+            continue;
+        }
+        if (entry.isReferenced) {
+            entry.isReferenced = false;
+        } else {
+            remove(shard, shard.hand);
+        }
+    }
+}
+
+std::optional<std::vector<long>> PathCache::findCorridor(long startId, long goalId)
+{
+    auto key = keyOf(startId, goalId);
+    auto& shard = shardOf(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto slot = shard.slotIds.find(key);
+    if (slot == end(shard.slotIds)) {
+        missCount_++;
+        return std::nullopt;
+    }
+    auto& entry = shard.entries[slot->second];
+    if (!isValid(entry)) {
+        remove(shard, slot->second);
+        missCount_++;
+        return std::nullopt;
+    }
+    entry.isReferenced = true;
+    hitCount_++;
+    return entry.triangleIds;
+}
+
+void PathCache::store(long startId, long goalId, std::vector<long> triangleIds)
+{
+    store(startId, goalId, std::move(triangleIds), graph_->unblockCount());
+}
+
+void PathCache::store(long startId, long goalId, std::vector<long> triangleIds, long unblockCount)
+{
+    long idCount = triangleIds.size();
+    if (idCount > shardCapacity_) {
+        return;
+    }
+    auto key = keyOf(startId, goalId);
+    auto& shard = shardOf(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto slot = shard.slotIds.find(key);
+    if (slot != end(shard.slotIds)) {
+        remove(shard, slot->second);
+    }
+    evict(shard, idCount);
+    Entry entry { startId, goalId, std::move(triangleIds), unblockCount, false };
+    long slotId;
+    if (shard.freeSlotIds.empty()) {
+        slotId = shard.entries.size();
+        shard.entries.push_back(std::move(entry));
+    } else {
+        slotId = shard.freeSlotIds.back();
+        shard.freeSlotIds.pop_back();
+        shard.entries[slotId] = std::move(entry);
+    }
+    shard.slotIds[key] = slotId;
+    shard.storedIdCount += idCount;
+}
+
+std::optional<std::vector<Vector>> PathCache::findPath(Vector start, Vector goal, TriangleSearch& search)
+{
+    auto startId = graph_->findIdOfTriangleUnder(start);
+    if (startId < 0) {
+        throw std::invalid_argument("The specified start point is not contained by any triangle in this graph");
+    }
+    auto goalId = graph_->findIdOfTriangleUnder(goal);
+    if (goalId < 0) {
+        throw std::invalid_argument("The specified goal point is not contained by any triangle in this graph");
+    }
+    auto corridor = findCorridor(startId, goalId);
+    if (!corridor) {
+        // a triangle unblocked during the search makes the entry stale right away
+        auto unblockCount = graph_->unblockCount();
+        auto result = search.findPath(startId, start, goalId, goal, [](long) { return true; });
+        if (!result.isFound) {
+            return std::nullopt;
+        }
+        corridor = result.triangleIds;
+        store(startId, goalId, std::move(result.triangleIds), unblockCount);
+    }
+    return funnel_.pullString(*corridor, start, goal);
+}
+
+void PathCache::clear()
+{
+    for (auto& shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.slotIds.clear();
+        shard.entries.clear();
+        shard.freeSlotIds.clear();
+        shard.hand = 0;
+        shard.storedIdCount = 0;
+    }
+}
+
+long PathCache::storedTriangleIdCount()
+{
+    long count = 0;
+    for (auto& shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        count += shard.storedIdCount;
+    }
+    return count;
+}
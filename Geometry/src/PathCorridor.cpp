@@ -0,0 +1,138 @@
+/**
+ * Copyright 2019 Márton Gergó
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <PathCorridor.h>
+#include <algorithm>
+#include <stdexcept>
+
+using namespace TpaStarCpp::GeometryLibrary;
+
+PathCorridor::PathCorridor(std::shared_ptr<TriangleGraph> graph, const std::vector<long>& triangleIds, Vector position, Vector goal) :
+    graph_(std::move(graph)),
+    funnel_(graph_),
+    triangleIds_(begin(triangleIds), end(triangleIds)),
+    positionX_(position.x()),
+    positionY_(position.y()),
+    goalX_(goal.x()),
+    goalY_(goal.y())
+{
+    if (triangleIds_.empty()) {
+        throw std::invalid_argument("The corridor must contain at least one triangle");
+    }
+    if (!graph_->triangleContains(triangleIds_.front(), position)) {
+        throw std::invalid_argument("The position must be in the first triangle of the corridor");
+    }
+    if (!graph_->triangleContains(triangleIds_.back(), goal)) {
+        throw std::invalid_argument("The goal must be in the last triangle of the corridor");
+    }
+}
+
+/*
+ * Crosses the edges the segment from the current position to the target leaves through, or any open edge the
+ * target is behind when the segment runs through a corner. Fails when only the boundary or blocked triangles
+ * are in the way and after too many steps.
+ */
+bool PathCorridor::walkTowards(double x, double y, std::vector<long>& walkedIds)
+{
+    Vector target(x, y);
+    auto id = triangleIds_.front();
+    walkedIds.push_back(id);
+    while (!graph_->triangleContains(id, target)) {
+        if (walkedIds.size() > MAX_WALK_LENGTH) {
+            return false;
+        }
+        double corners[3][2];
+        for (int corner = 0; corner < 3; corner++) {
+            auto point = graph_->cornerOf(id, corner);
+            corners[corner][0] = point.x();
+            corners[corner][1] = point.y();
+        }
+        auto sideOf = [&](int edge, double px, double py) {
+            auto& a = corners[edge];
+            auto& b = corners[(edge + 1) % 3];
+            return (b[0] - a[0]) * (py - a[1]) - (b[1] - a[1]) * (px - a[0]);
+        };
+        // the inside of the triangle is on the side of the third corner
+        auto orientation = (sideOf(0, corners[2][0], corners[2][1]) > 0.0) ? 1.0 : -1.0;
+        // edges the target is behind, the ones the segment crosses first, then edges the target is in line with
+        // to turn around a corner, the triangle just left only if nothing else is open
+        auto previousId = (walkedIds.size() > 1) ? walkedIds[walkedIds.size() - 2] : -1;
+        long nextId = -1;
+        auto bestRank = 6;
+        for (int edge = 0; edge < 3; edge++) {
+            auto neighbour = graph_->neighbourIdAcross(id, edge);
+            auto side = orientation * sideOf(edge, x, y);
+            if ((side > 0.0) || (neighbour < 0) || graph_->isBlocked(neighbour)) {
+                continue;
+            }
+            auto& a = corners[edge];
+            auto& b = corners[(edge + 1) % 3];
+            auto sideOfA = (x - positionX_) * (a[1] - positionY_) - (y - positionY_) * (a[0] - positionX_);
+            auto sideOfB = (x - positionX_) * (b[1] - positionY_) - (y - positionY_) * (b[0] - positionX_);
+            auto rank = (side == 0.0) ? 2 : ((sideOfA * sideOfB <= 0.0) ? 0 : 1);
+            rank += (neighbour == previousId) ? 3 : 0;
+            if (rank < bestRank) {
+                bestRank = rank;
+                nextId = neighbour;
+            }
+        }
+        if (nextId < 0) {
+            return false;
+        }
+        id = nextId;
+        walkedIds.push_back(id);
+    }
+    return true;
+}
+
+bool PathCorridor::movePosition(Vector position)
+{
+    // moving ahead within the corridor, also around corners the walk below could not turn; the farthest
+    // triangle wins, as a position on a corner or an edge is contained by all triangles sharing it
+    long lookahead = std::min<long>(MAX_LOOKAHEAD, triangleIds_.size());
+    for (long i = lookahead - 1; i >= 0; i--) {
+        if (graph_->triangleContains(triangleIds_[i], position)) {
+            triangleIds_.erase(begin(triangleIds_), begin(triangleIds_) + i);
+            positionX_ = position.x();
+            positionY_ = position.y();
+            return true;
+        }
+    }
+    std::vector<long> walkedIds;
+    if (!walkTowards(position.x(), position.y(), walkedIds)) {
+        return false;
+    }
+    // the last triangle of the walk that is also close to the front of the corridor
+    for (long i = walkedIds.size() - 1; i >= 0; i--) {
+        auto found = std::find(begin(triangleIds_), begin(triangleIds_) + lookahead, walkedIds[i]);
+        if (found == begin(triangleIds_) + lookahead) {
+            continue;
+        }
+        triangleIds_.erase(begin(triangleIds_), found);
+        for (long j = i + 1; j < walkedIds.size(); j++) {
+            triangleIds_.push_front(walkedIds[j]);
+        }
+        positionX_ = position.x();
+        positionY_ = position.y();
+        return true;
+    }
+    return false;
+}
+
+std::vector<Vector> PathCorridor::findCorners(long maxCornerCount)
+{
+    return funnel_.pullString(triangleIds_, position(), goal(), maxCornerCount);
+}
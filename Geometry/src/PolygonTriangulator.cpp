@@ -0,0 +1,127 @@
+/**
+ * Copyright 2019 Márton Gergó
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <PolygonTriangulator.h>
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include "Vector.h"
+#include "DelaunayTriangulation.h"
+#include "HilbertCurve.h"
+
+using namespace TpaStarCpp::GeometryLibrary;
+
+namespace {
+
+    double doubleSignedAreaOf(std::vector<Vector>& ring)
+    {
+        double area = 0.0;
+        for (long i = 0; i < ring.size(); i++) {
+            auto& next = ring[(i + 1) % ring.size()];
+            area += ring[i].x() * next.y() - next.x() * ring[i].y();
+        }
+        return area;
+    }
+
+}
+
+void PolygonTriangulator::addRing(std::vector<Vector> ring, bool isHole)
+{
+    if (ring.size() < 3) {
+        throw std::invalid_argument("A ring needs at least three corners");
+    }
+    rings_.push_back(std::move(ring));
+    isHole_.push_back(isHole);
+}
+
+void PolygonTriangulator::addOutline(std::vector<Vector> outline) { addRing(std::move(outline), false); }
+
+// holes are told apart from outlines by how many rings enclose them, the kind is only kept to validate that count
+void PolygonTriangulator::addHole(std::vector<Vector> hole) { addRing(std::move(hole), true); }
+
+IndexedMesh PolygonTriangulator::triangulate()
+{
+    if (rings_.empty()) {
+        throw std::invalid_argument("Cannot triangulate without an outline");
+    }
+    std::vector<double> xs;
+    std::vector<double> ys;
+    for (auto& ring : rings_) {
+        for (auto& corner : ring) {
+            xs.push_back(corner.x());
+            ys.push_back(corner.y());
+        }
+    }
+    auto [minX, maxX] = std::minmax_element(begin(xs), end(xs));
+    auto [minY, maxY] = std::minmax_element(begin(ys), end(ys));
+    // the margin keeps the corners of the rings off the border of the enclosing rectangle
+    auto margin = std::max({ *maxX - *minX, *maxY - *minY, 1.0 }) * 0.1;
+    DelaunayTriangulation triangulation(*minX - margin, *minY - margin, *maxX + margin, *maxY + margin);
+
+    std::vector<long> vertexIds(xs.size());
+    for (auto i : HilbertCurve::sortedOrder(xs, ys)) {
+        vertexIds[i] = triangulation.insertVertex(xs[i], ys[i]);
+    }
+    long ringStart = 0;
+    for (auto& ring : rings_) {
+        for (long i = 0; i < ring.size(); i++) {
+            triangulation.insertConstraint(vertexIds[ringStart + i], vertexIds[ringStart + (i + 1) % ring.size()]);
+        }
+        ringStart += ring.size();
+    }
+
+    /*
+     * The inside of an outline and the outside of a hole have to be kept along every edge of the ring,
+     * except where rings share the edge. Edges running through a corner of another ring were split there,
+     * they are not checked.
+     */
+    std::unordered_map<uint64_t, long> ringCounts;
+    auto keyOf = [&](long from, long to) {
+        return static_cast<uint64_t>(std::min(from, to)) * triangulation.vertexCount() + std::max(from, to);
+    };
+    std::vector<std::pair<long, long>> edges;
+    std::vector<long> edgeRingIds;
+    ringStart = 0;
+    for (long ringId = 0; ringId < rings_.size(); ringId++) {
+        auto& ring = rings_[ringId];
+        bool isKeptOnLeft = (doubleSignedAreaOf(ring) > 0.0) != isHole_[ringId];
+        for (long i = 0; i < ring.size(); i++) {
+            auto from = vertexIds[ringStart + i];
+            auto to = vertexIds[ringStart + (i + 1) % ring.size()];
+            if ((from != to) && (ringCounts[keyOf(from, to)]++ == 0) && triangulation.containsEdge(from, to)) {
+                edges.emplace_back(isKeptOnLeft ? from : to, isKeptOnLeft ? to : from);
+                edgeRingIds.push_back(ringId);
+            }
+        }
+        ringStart += ring.size();
+    }
+    auto isKept = triangulation.findEnclosedLeftSides(edges);
+    for (long i = 0; i < edges.size(); i++) {
+        if (!isKept[i] && (ringCounts[keyOf(edges[i].first, edges[i].second)] == 1)) {
+            throw std::invalid_argument(isHole_[edgeRingIds[i]] ?
+                    "A hole must lie inside an outline and must not overlap other holes" :
+                    "An outline must not lie inside another outline without a hole between them");
+        }
+    }
+    return triangulation.toIndexedMeshOfEnclosedFaces();
+}
+
+std::shared_ptr<TriangleGraph> PolygonTriangulator::buildGraph(TriangleOrdering ordering)
+{
+    return std::make_shared<TriangleGraph>(triangulate(), ordering);
+}
@@ -0,0 +1,144 @@
+/**
+ * Copyright 2019 Márton Gergó
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <SlicedSearch.h>
+#include <cmath>
+#include <stdexcept>
+
+using namespace TpaStarCpp::GeometryLibrary;
+
+namespace {
+
+    // the clock is read once in this many expansions
+    constexpr long CLOCK_INTERVAL = 32;
+
+}
+
+SlicedSearch::SlicedSearch(std::shared_ptr<TriangleGraph> graph) :
+    graph_(std::move(graph)),
+    nodes_(graph_->triangleCount())
+{
+}
+
+void SlicedSearch::start(Vector start, Vector goal)
+{
+    auto startId = graph_->findIdOfTriangleUnder(start);
+    if (startId < 0) {
+        throw std::invalid_argument("The specified start point is not contained by any triangle in this graph");
+    }
+    auto goalId = graph_->findIdOfTriangleUnder(goal);
+    if (goalId < 0) {
+        throw std::invalid_argument("The specified goal point is not contained by any triangle in this graph");
+    }
+    startId_ = startId;
+    goalId_ = goalId;
+    goalX_ = goal.x();
+    goalY_ = goal.y();
+    goalCost_ = graph_->costWithin(goalId, graph_->metadataOf(goalId).centroid(), goal);
+    minCostMultiplier_ = graph_->minCostMultiplier();
+    expandedCount_ = 0;
+    closestId_ = -1;
+    if (graph_->isBlocked(startId) || graph_->isBlocked(goalId)) {
+        state_ = SearchState::NotFound;
+        result_ = SearchResult::notFound(0);
+        return;
+    }
+    if (startId == goalId) {
+        state_ = SearchState::Found;
+        result_ = SearchResult { true, { startId }, graph_->costWithin(startId, start, goal), 1 };
+        return;
+    }
+    state_ = SearchState::Running;
+    result_ = SearchResult::notFound(0);
+    nodes_.start();
+    auto startCost = graph_->costWithin(startId, start, graph_->metadataOf(startId).centroid());
+    nodes_.visit(startId, startCost, -1);
+    nodes_.push(startCost + estimateOf(startId), startId);
+}
+
+double SlicedSearch::estimateOf(long id)
+{
+    if (id == goalId_) {
+        return goalCost_;
+    }
+    auto& metadata = graph_->metadataOf(id);
+    return minCostMultiplier_ * std::hypot(metadata.centroidX - goalX_, metadata.centroidY - goalY_);
+}
+
+void SlicedSearch::expandNext()
+{
+    if (!nodes_.hasOpen()) {
+        state_ = SearchState::NotFound;
+        result_ = SearchResult::notFound(expandedCount_);
+        return;
+    }
+    auto id = nodes_.pop();
+    nodes_.close(id);
+    expandedCount_++;
+    if (id == goalId_) {
+        state_ = SearchState::Found;
+        result_ = SearchResult { true, nodes_.pathTo(id), nodes_.gScoreOf(id) + goalCost_, expandedCount_ };
+        return;
+    }
+    auto distance = estimateOf(id);
+    if ((closestId_ < 0) || (distance < closestDistance_)) {
+        closestId_ = id;
+        closestDistance_ = distance;
+    }
+    graph_->forEachStepFrom(id, [&](long neighbour, double cost) {
+        if (graph_->isBlocked(neighbour)) {
+            return;
+        }
+        auto g = nodes_.gScoreOf(id) + cost;
+        if (!nodes_.isVisited(neighbour) || (g < nodes_.gScoreOf(neighbour))) {
+            nodes_.visit(neighbour, g, id);
+            nodes_.push(g + estimateOf(neighbour), neighbour);
+        }
+    });
+}
+
+SearchState SlicedSearch::step(long maxExpandedCount)
+{
+    for (long i = 0; (i < maxExpandedCount) && (state_ == SearchState::Running); i++) {
+        expandNext();
+    }
+    return state_;
+}
+
+SearchState SlicedSearch::stepFor(std::chrono::microseconds budget)
+{
+    auto deadline = std::chrono::steady_clock::now() + budget;
+    while (state_ == SearchState::Running) {
+        step(CLOCK_INTERVAL);
+        if (std::chrono::steady_clock::now() >= deadline) {
+            break;
+        }
+    }
+    return state_;
+}
+
+const SearchResult& SlicedSearch::cancel()
+{
+    if (state_ == SearchState::Running) {
+        state_ = SearchState::Cancelled;
+        if (closestId_ < 0) {
+            result_ = SearchResult::notFound(expandedCount_);
+        } else {
+            result_ = SearchResult { false, nodes_.pathTo(closestId_), nodes_.gScoreOf(closestId_), expandedCount_ };
+        }
+    }
+    return result_;
+}
@@ -0,0 +1,247 @@
+/**
+ * Copyright 2019 Márton Gergó
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <TiledGraph.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+using namespace TpaStarCpp::GeometryLibrary;
+
+TiledGraph::TiledGraph(TileSource source, double tileSize, long maxResidentTriangleCount) :
+    source_(std::move(source)),
+    tileSize_(tileSize),
+    maxResidentTriangleCount_(maxResidentTriangleCount)
+{
+    if (!(tileSize > 0.0) || !std::isfinite(tileSize)) {
+        throw std::invalid_argument("The tile size has to be positive");
+    }
+    if (maxResidentTriangleCount < 0) {
+        throw std::invalid_argument("The triangle budget cannot be negative");
+    }
+    loader_ = std::thread(&TiledGraph::runLoader, this);
+}
+
+TiledGraph::~TiledGraph()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        isStopping_ = true;
+    }
+    hasRequest_.notify_all();
+    loader_.join();
+}
+
+uint64_t TiledGraph::keyOf(TileCoordinates coordinates)
+{
+    return (static_cast<uint64_t>(static_cast<uint32_t>(coordinates.x)) << 32) | static_cast<uint32_t>(coordinates.y);
+}
+
+TileCoordinates TiledGraph::tileOf(Vector point)
+{
+    return { static_cast<long>(std::floor(point.x() / tileSize_)), static_cast<long>(std::floor(point.y() / tileSize_)) };
+}
+
+std::shared_ptr<const TiledGraph::Tile> TiledGraph::buildTile(MeshTile meshTile)
+{
+    auto tile = std::make_shared<Tile>();
+    tile->coordinates = meshTile.coordinates;
+    auto triangleCount = static_cast<long>(meshTile.mesh.triangles.size());
+    tile->graph = std::make_shared<TriangleGraph>(std::move(meshTile.mesh));
+    tile->portals = std::move(meshTile.portals);
+    std::stable_sort(tile->portals.begin(), tile->portals.end(),
+            [](const TilePortal& a, const TilePortal& b) { return a.id < b.id; });
+    tile->firstPortalIndices.assign(triangleCount + 1, 0);
+    for (auto& portal : tile->portals) {
+        tile->firstPortalIndices[portal.id + 1]++;
+    }
+    for (long id = 0; id < triangleCount; id++) {
+        tile->firstPortalIndices[id + 1] += tile->firstPortalIndices[id];
+    }
+    return tile;
+}
+
+std::shared_ptr<const TiledGraph::Tile> TiledGraph::readTile(TileCoordinates coordinates)
+{
+    auto input = source_(coordinates.x, coordinates.y);
+    if (!input) {
+        return nullptr;
+    }
+    auto meshTile = MeshTile::load(*input);
+    if (!(meshTile.coordinates == coordinates)) {
+        throw std::invalid_argument("The tile data belongs to a different tile");
+    }
+    return buildTile(std::move(meshTile));
+}
+
+void TiledGraph::runLoader()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        hasRequest_.wait(lock, [this] { return isStopping_ || !requests_.empty(); });
+        if (isStopping_) {
+            return;
+        }
+        auto coordinates = requests_.front();
+        requests_.pop_front();
+        lock.unlock();
+        std::shared_ptr<const Tile> tile;
+        bool hasFailed = false;
+        try {
+            tile = readTile(coordinates);
+        } catch (const std::exception&) {
+            hasFailed = true;
+        }
+        lock.lock();
+        pendingTiles_.erase(keyOf(coordinates));
+        if (tile) {
+            insert(std::move(tile));
+        } else if (hasFailed) {
+            failedTiles_.insert(keyOf(coordinates));
+        } else {
+            unavailableTiles_.insert(keyOf(coordinates));
+        }
+        if (requests_.empty()) {
+            isIdle_.notify_all();
+        }
+    }
+}
+
+void TiledGraph::insert(std::shared_ptr<const Tile> tile)
+{
+    auto key = keyOf(tile->coordinates);
+    auto found = tiles_.find(key);
+    if (found != tiles_.end()) {
+        residentTriangleCount_ -= found->second.tile->graph->triangleCount();
+    }
+    residentTriangleCount_ += tile->graph->triangleCount();
+    unavailableTiles_.erase(key);
+    failedTiles_.erase(key);
+    tiles_[key] = ResidentTile { std::move(tile), ++useCount_ };
+    // the newest tile is the most recently used one, it is kept even if it exceeds the budget on its own
+    while ((residentTriangleCount_ > maxResidentTriangleCount_) && (tiles_.size() > 1)) {
+        evictLeastRecent();
+    }
+}
+
+void TiledGraph::evictLeastRecent()
+{
+    auto leastRecent = std::min_element(tiles_.begin(), tiles_.end(),
+            [](const auto& a, const auto& b) { return a.second.lastUse < b.second.lastUse; });
+    residentTriangleCount_ -= leastRecent->second.tile->graph->triangleCount();
+    tiles_.erase(leastRecent);
+}
+
+void TiledGraph::requestTile(TileCoordinates coordinates)
+{
+    auto key = keyOf(coordinates);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if ((tiles_.count(key) != 0) || (pendingTiles_.count(key) != 0) || (unavailableTiles_.count(key) != 0)) {
+            return;
+        }
+        pendingTiles_.insert(key);
+        requests_.push_back(coordinates);
+    }
+    hasRequest_.notify_one();
+}
+
+bool TiledGraph::loadTile(TileCoordinates coordinates)
+{
+    std::shared_ptr<const Tile> tile;
+    try {
+        tile = readTile(coordinates);
+    } catch (const std::exception&) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        failedTiles_.insert(keyOf(coordinates));
+        throw;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!tile) {
+        unavailableTiles_.insert(keyOf(coordinates));
+        return false;
+    }
+    insert(std::move(tile));
+    return true;
+}
+
+void TiledGraph::waitUntilIdle()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    isIdle_.wait(lock, [this] { return pendingTiles_.empty(); });
+}
+
+void TiledGraph::unloadTile(TileCoordinates coordinates)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto found = tiles_.find(keyOf(coordinates));
+    if (found != tiles_.end()) {
+        residentTriangleCount_ -= found->second.tile->graph->triangleCount();
+        tiles_.erase(found);
+    }
+}
+
+void TiledGraph::releaseMemory(long maxTriangleCount)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    while ((residentTriangleCount_ > maxTriangleCount) && !tiles_.empty()) {
+        evictLeastRecent();
+    }
+}
+
+std::shared_ptr<const TiledGraph::Tile> TiledGraph::findTile(TileCoordinates coordinates)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto found = tiles_.find(keyOf(coordinates));
+    if (found == tiles_.end()) {
+        return nullptr;
+    }
+    found->second.lastUse = ++useCount_;
+    return found->second.tile;
+}
+
+bool TiledGraph::isResident(TileCoordinates coordinates)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return tiles_.count(keyOf(coordinates)) != 0;
+}
+
+bool TiledGraph::isUnavailable(TileCoordinates coordinates)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return unavailableTiles_.count(keyOf(coordinates)) != 0;
+}
+
+bool TiledGraph::hasFailed(TileCoordinates coordinates)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return failedTiles_.count(keyOf(coordinates)) != 0;
+}
+
+long TiledGraph::residentTileCount()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return tiles_.size();
+}
+
+long TiledGraph::residentTriangleCount()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return residentTriangleCount_;
+}
@@ -0,0 +1,208 @@
+/**
+ * Copyright 2019 Márton Gergó
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <TiledSearch.h>
+#include <algorithm>
+#include <functional>
+#include <queue>
+#include <stdexcept>
+#include <utility>
+
+using namespace TpaStarCpp::GeometryLibrary;
+
+namespace {
+
+    constexpr int SLOT_SHIFT = 32;
+    constexpr uint64_t ID_MASK = 0xFFFFFFFFu;
+
+    uint64_t nodeKeyOf(long slot, long id)
+    {
+        return (static_cast<uint64_t>(slot) << SLOT_SHIFT) | static_cast<uint64_t>(id);
+    }
+
+    uint64_t tileKeyOf(TileCoordinates coordinates)
+    {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(coordinates.x)) << 32) | static_cast<uint32_t>(coordinates.y);
+    }
+
+}
+
+TiledSearch::TiledSearch(std::shared_ptr<TiledGraph> graph) :
+    graph_(std::move(graph))
+{
+}
+
+long TiledSearch::slotOf(TileCoordinates coordinates)
+{
+    auto key = tileKeyOf(coordinates);
+    auto found = tileSlots_.find(key);
+    if (found != tileSlots_.end()) {
+        return found->second;
+    }
+    auto tile = graph_->findTile(coordinates);
+    long slot = -1;
+    if (tile) {
+        slot = tiles_.size();
+        tiles_.push_back(std::move(tile));
+    } else if (!graph_->isUnavailable(coordinates)) {
+        missingTiles_.push_back(coordinates);
+    }
+    tileSlots_.emplace(key, slot);
+    return slot;
+}
+
+// triangles may reach over the border of their tile, so the point may lie in a triangle of a neighbouring tile
+int64_t TiledSearch::locate(Vector point)
+{
+    auto centre = graph_->tileOf(point);
+    for (auto offset : { std::make_pair(0L, 0L), std::make_pair(-1L, -1L), std::make_pair(0L, -1L),
+            std::make_pair(1L, -1L), std::make_pair(-1L, 0L), std::make_pair(1L, 0L),
+            std::make_pair(-1L, 1L), std::make_pair(0L, 1L), std::make_pair(1L, 1L) }) {
+        auto slot = slotOf({ centre.x + offset.first, centre.y + offset.second });
+        if (slot < 0) {
+            continue;
+        }
+        auto id = tiles_[slot]->graph->findIdOfTriangleUnder(point);
+        if (id >= 0) {
+            return nodeKeyOf(slot, id);
+        }
+    }
+    return -1;
+}
+
+void TiledSearch::release()
+{
+    tiles_.clear();
+    tileSlots_.clear();
+    nodes_.clear();
+}
+
+TiledSearchResult TiledSearch::findPath(Vector start, Vector goal)
+{
+    release();
+    missingTiles_.clear();
+    auto startKey = locate(start);
+    auto goalKey = locate(goal);
+    if ((startKey < 0) || (goalKey < 0)) {
+        if (missingTiles_.empty()) {
+            release();
+            throw std::invalid_argument(startKey < 0
+                    ? "The specified start point is not contained by any triangle in the resident tiles"
+                    : "The specified goal point is not contained by any triangle in the resident tiles");
+        }
+        release();
+        return TiledSearchResult { false, {}, std::numeric_limits<double>::infinity(), 0, std::move(missingTiles_) };
+    }
+
+    if (startKey == goalKey) {
+        auto& graph = *tiles_[startKey >> SLOT_SHIFT]->graph;
+        auto id = static_cast<long>(startKey & ID_MASK);
+        TiledSearchResult result { true, { TileTriangle { tiles_[startKey >> SLOT_SHIFT]->coordinates, id } },
+                graph.costWithin(id, start, goal), 1, std::move(missingTiles_) };
+        release();
+        return result;
+    }
+
+    auto graphOf = [this](uint64_t key) -> TriangleGraph& { return *tiles_[key >> SLOT_SHIFT]->graph; };
+    auto idOf = [](uint64_t key) { return static_cast<long>(key & ID_MASK); };
+    auto goalCostFrom = [&](uint64_t key) {
+        auto& graph = graphOf(key);
+        return graph.costWithin(idOf(key), graph.metadataOf(idOf(key)).centroid(), goal);
+    };
+
+    using OpenEntry = std::pair<double, uint64_t>;
+    std::priority_queue<OpenEntry, std::vector<OpenEntry>, std::greater<OpenEntry>> open;
+    auto visit = [&](uint64_t key, double gScore, uint64_t parentKey) {
+        if (graphOf(key).isBlocked(idOf(key))) {
+            return;
+        }
+        auto found = nodes_.find(key);
+        if (found == nodes_.end()) {
+            found = nodes_.emplace(key, Node { std::numeric_limits<double>::infinity(), key, false }).first;
+        }
+        if (found->second.isClosed || (gScore >= found->second.gScore)) {
+            return;
+        }
+        found->second.gScore = gScore;
+        found->second.parentKey = parentKey;
+        auto& graph = graphOf(key);
+        open.push({ gScore + graph.metadataOf(idOf(key)).centroid().distanceFrom(goal), key });
+    };
+
+    auto& startGraph = graphOf(startKey);
+    visit(startKey, startGraph.costWithin(idOf(startKey), start, startGraph.metadataOf(idOf(startKey)).centroid()),
+            startKey);
+    long expandedCount = 0;
+    while (!open.empty()) {
+        auto key = open.top().second;
+        open.pop();
+        auto& node = nodes_[key];
+        if (node.isClosed) {
+            continue;
+        }
+        node.isClosed = true;
+        expandedCount++;
+        if (key == goalKey) {
+            break;
+        }
+        auto gScore = node.gScore;
+        auto slot = static_cast<long>(key >> SLOT_SHIFT);
+        auto id = idOf(key);
+        auto& graph = graphOf(key);
+        graph.forEachStepFrom(id, [&](long neighbourId, double cost) {
+            visit(nodeKeyOf(slot, neighbourId), gScore + cost, key);
+        });
+        // the tile may be pushed out of tiles_ when it grows, the portals are read from a copy of the pointer
+        auto tile = tiles_[slot];
+        for (auto i = tile->firstPortalIndices[id]; i < tile->firstPortalIndices[id + 1]; i++) {
+            auto& portal = tile->portals[i];
+            auto neighbourSlot = slotOf(portal.neighbourTile);
+            if (neighbourSlot < 0) {
+                continue;
+            }
+            auto& neighbourGraph = *tiles_[neighbourSlot]->graph;
+            if (portal.neighbourId >= neighbourGraph.triangleCount()) {
+                continue;
+            }
+            auto& metadata = graph.metadataOf(id);
+            auto midpoint = metadata.edgeMidpoint(portal.edge);
+            auto cost = metadata.centroid().distanceFrom(midpoint)
+                    + midpoint.distanceFrom(neighbourGraph.metadataOf(portal.neighbourId).centroid());
+            visit(nodeKeyOf(neighbourSlot, portal.neighbourId), gScore + cost, key);
+        }
+    }
+
+    auto goalNode = nodes_.find(goalKey);
+    if ((goalNode == nodes_.end()) || !goalNode->second.isClosed) {
+        TiledSearchResult result { false, {}, std::numeric_limits<double>::infinity(), expandedCount,
+                std::move(missingTiles_) };
+        release();
+        return result;
+    }
+    std::vector<TileTriangle> triangles;
+    for (auto key = goalKey; ; key = nodes_[key].parentKey) {
+        triangles.push_back(TileTriangle { tiles_[key >> SLOT_SHIFT]->coordinates, idOf(key) });
+        if (key == static_cast<uint64_t>(startKey)) {
+            break;
+        }
+    }
+    std::reverse(triangles.begin(), triangles.end());
+    auto cost = goalNode->second.gScore + goalCostFrom(goalKey);
+    TiledSearchResult result { true, std::move(triangles), cost, expandedCount, std::move(missingTiles_) };
+    release();
+    return result;
+}
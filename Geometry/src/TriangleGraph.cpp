@@ -16,59 +16,768 @@
 
 #include <TriangleGraph.h>
 #include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <numeric>
 #include <stdexcept>
+#include <tuple>
 #include "Vector.h"
+#include "HilbertCurve.h"
+#include "Edge.h"
 #include "TriangleSkeleton.h"
 #include "Triangle.h"
 
 using namespace TpaStarCpp::GeometryLibrary;
 
-TriangleGraph::TriangleGraph(std::vector<TriangleSkeleton> triangles) :
+namespace {
+
+    // positive if the corners are in counter-clockwise order
+    double doubleSignedArea(Vector a, Vector b, Vector c)
+    {
+        return (b.x() - a.x()) * (c.y() - a.y()) - (b.y() - a.y()) * (c.x() - a.x());
+    }
+
+    /*
+     * Assigns the same id to corners that are equal within Vector::EQUALITY_CHECK_TOLERANCE.
+     * Corners are hashed into cells of tolerance size, so only the neighbouring cells need to be checked.
+     * The cells live in an open addressing table, as this runs for every corner of meshes with millions of triangles.
+     */
+    class VertexWelder {
+
+    private:
+        struct Slot {
+            long long cellX;
+            long long cellY;
+            long vertexId;
+        };
+
+        std::vector<Slot> slots_;
+        size_t mask_;
+        std::vector<Vector> vertices_;
+
+        static long long cellOf(double coordinate) {
+            return static_cast<long long>(std::floor(coordinate / Vector::EQUALITY_CHECK_TOLERANCE));
+        }
+
+        size_t slotOf(long long cellX, long long cellY) {
+            // splitmix64 finalizer
+            auto hash = static_cast<uint64_t>(cellX) * 0x9E3779B97F4A7C15ULL ^ static_cast<uint64_t>(cellY);
+            hash = (hash ^ (hash >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            hash = (hash ^ (hash >> 27)) * 0x94D049BB133111EBULL;
+            return (hash ^ (hash >> 31)) & mask_;
+        }
+
+        long findInCell(long long cellX, long long cellY, Vector point) {
+            for (auto slot = slotOf(cellX, cellY); slots_[slot].vertexId >= 0; slot = (slot + 1) & mask_) {
+                auto& candidate = slots_[slot];
+                if ((candidate.cellX == cellX) && (candidate.cellY == cellY) && (vertices_[candidate.vertexId] == point)) {
+                    return candidate.vertexId;
+                }
+            }
+            return -1;
+        }
+
+    public:
+        explicit VertexWelder(size_t cornerCount) {
+            size_t capacity = 16;
+            while (capacity < 2 * cornerCount) {
+                capacity *= 2;
+            }
+            slots_.assign(capacity, Slot { 0, 0, -1 });
+            mask_ = capacity - 1;
+            vertices_.reserve(cornerCount);
+        }
+
+        long idOf(Vector point) {
+            auto cellX = cellOf(point.x());
+            auto cellY = cellOf(point.y());
+            auto id = findInCell(cellX, cellY, point);
+            for (long long dx = -1; (id < 0) && (dx <= 1); dx++) {
+                for (long long dy = -1; (id < 0) && (dy <= 1); dy++) {
+                    if ((dx != 0) || (dy != 0)) {
+                        id = findInCell(cellX + dx, cellY + dy, point);
+                    }
+                }
+            }
+            if (id < 0) {
+                id = vertices_.size();
+                vertices_.push_back(point);
+                auto slot = slotOf(cellX, cellY);
+                while (slots_[slot].vertexId >= 0) {
+                    slot = (slot + 1) & mask_;
+                }
+                slots_[slot] = Slot { cellX, cellY, id };
+            }
+            return id;
+        }
+
+    };
+
+    struct EdgeRecord {
+        long lowerVertexId;
+        long higherVertexId;
+        long triangleId;
+        int edge;
+    };
+
+}
+
+TriangleGraph::TriangleGraph(std::vector<TriangleSkeleton> triangles, TriangleOrdering ordering) :
     triangles_(std::move(triangles)),
     neighbourIds_(std::vector<std::vector<long>>(triangles_.size()))
 {
+    weldVertices();
+    findNeighbours();
+    buildIndices(ordering);
+}
+
+TriangleGraph::TriangleGraph(IndexedMesh mesh, TriangleOrdering ordering) :
+    triangles_(mesh.toTriangleSkeletons()),
+    neighbourIds_(std::vector<std::vector<long>>(triangles_.size())),
+    vertexIds_(std::move(mesh.triangles)),
+    heights_(std::move(mesh.heights)),
+    layers_(std::move(mesh.layers))
+{
+    if ((!heights_.empty() && (heights_.size() != mesh.xs.size()))
+            || (!layers_.empty() && (layers_.size() != triangles_.size()))) {
+        throw std::invalid_argument("The heights and the layers have to be given for every vertex and triangle");
+    }
+    if (std::any_of(begin(layers_), end(layers_), [](long layer) { return layer < 0; })) {
+        throw std::invalid_argument("The layers have to be numbered from 0");
+    }
+    if (mesh.neighbours.empty()) {
+        findNeighbours();
+    } else {
+        takeNeighbours(std::move(mesh.neighbours));
+    }
+    buildIndices(ordering);
+}
+
+void TriangleGraph::buildIndices(TriangleOrdering ordering)
+{
+    metadata_.reserve(triangles_.size());
+    for (auto& triangle : triangles_) {
+        metadata_.push_back(TriangleMetadata::of(triangle));
+    }
+    externalIds_.resize(triangles_.size());
+    std::iota(begin(externalIds_), end(externalIds_), 0);
+    internalIds_ = externalIds_;
+    if (ordering == TriangleOrdering::HilbertCurve) {
+        sortAlongHilbertCurve();
+    }
+    grid_ = TriangleGrid(metadata_);
+    buildLayerIndices();
+    costMultipliers_.assign(triangles_.size(), 1.0f);
+    firstOutgoingLinkIds_.assign(triangles_.size(), -1);
+    firstIncomingLinkIds_.assign(triangles_.size(), -1);
+    measureCrossingCosts();
+    measureClearances();
+    isBlocked_.assign(triangles_.size(), 0);
+}
+
+// Searches step from centroid to centroid through the midpoints of the edges, so the steps are measured only once
+void TriangleGraph::measureCrossingCosts()
+{
+    crossingCosts_.assign(triangles_.size(), { 0.0, 0.0, 0.0 });
+    for (long id = 0; id < triangles_.size(); id++) {
+        for (int edge = 0; edge < 3; edge++) {
+            crossingCosts_[id][edge] = measureCrossingCost(id, edge);
+        }
+    }
+}
+
+double TriangleGraph::measureCrossingCost(long id, int edge)
+{
+    auto neighbour = edgeNeighbourIds_[id][edge];
+    if (neighbour < 0) {
+        return 0.0;
+    }
+    auto& from = metadata_[id];
+    auto& to = metadata_[neighbour];
+    auto midpointX = from.edgeMidpointsX[edge];
+    auto midpointY = from.edgeMidpointsY[edge];
+    return costMultipliers_[id] * std::hypot(midpointX - from.centroidX, midpointY - from.centroidY) +
+           costMultipliers_[neighbour] * std::hypot(to.centroidX - midpointX, to.centroidY - midpointY);
+}
+
+double TriangleGraph::costWithin(long id, Vector from, Vector to)
+{
+    return costMultipliers_[id] * from.distanceFrom(to);
+}
+
+// Only the steps into and out of the triangle change, the lowest multiplier is looked for again only if it was raised
+void TriangleGraph::setCostMultiplier(long id, double multiplier)
+{
+    if ((id < 0) || (id >= triangleCount())) {
+        throw std::invalid_argument("Cannot find triangle with the specified id");
+    }
+    if (!(multiplier > 0.0) || std::isinf(multiplier)) {
+        throw std::invalid_argument("The cost multiplier must be positive and finite");
+    }
+    double previous = costMultipliers_[id];
+    costMultipliers_[id] = static_cast<float>(multiplier);
+    double current = costMultipliers_[id];
+    for (int edge = 0; edge < 3; edge++) {
+        crossingCosts_[id][edge] = measureCrossingCost(id, edge);
+        auto neighbour = edgeNeighbourIds_[id][edge];
+        auto neighbourEdge = (neighbour < 0) ? 3 : edgeTowards(neighbour, id);
+        if (neighbourEdge < 3) {
+            crossingCosts_[neighbour][neighbourEdge] = measureCrossingCost(neighbour, neighbourEdge);
+        }
+    }
+    for (auto link = firstOutgoingLinkIds_[id]; link >= 0; link = nextOutgoingLinkIds_[link]) {
+        linkCosts_[link] = measureLinkCost(link);
+    }
+    for (auto link = firstIncomingLinkIds_[id]; link >= 0; link = nextIncomingLinkIds_[link]) {
+        linkCosts_[link] = measureLinkCost(link);
+    }
+    if (current != previous) {
+        unblockCount_++;
+    }
+    if (current <= minCostMultiplier_) {
+        minCostMultiplier_ = current;
+    } else if (previous == minCostMultiplier_) {
+        minCostMultiplier_ = *std::min_element(begin(costMultipliers_), end(costMultipliers_));
+    }
+}
+
+double TriangleGraph::measureLinkCost(long linkId)
+{
+    auto& link = links_[linkId];
+    auto& from = metadata_[link.fromId];
+    auto& to = metadata_[link.toId];
+    return costMultipliers_[link.fromId] * std::hypot(link.entryX - from.centroidX, link.entryY - from.centroidY) +
+           link.cost + costMultipliers_[link.toId] * std::hypot(to.centroidX - link.exitX, to.centroidY - link.exitY);
+}
+
+// The new link is put at the front of the chains of its triangles, so adding one does not walk the others
+long TriangleGraph::addOffMeshLink(Vector entry, Vector exit, double cost)
+{
+    auto fromId = findIdOfTriangleUnder(entry);
+    if (fromId < 0) {
+        throw std::invalid_argument("The entry point of the link is not contained by any triangle in this graph");
+    }
+    auto toId = findIdOfTriangleUnder(exit);
+    if (toId < 0) {
+        throw std::invalid_argument("The exit point of the link is not contained by any triangle in this graph");
+    }
+    return addOffMeshLink(fromId, entry, toId, exit, cost);
+}
+
+long TriangleGraph::addOffMeshLink(long fromId, Vector entry, long toId, Vector exit, double cost)
+{
+    if (!(cost >= 0.0) || std::isinf(cost)) {
+        throw std::invalid_argument("The cost of the link must not be negative");
+    }
+    if ((fromId < 0) || (fromId >= triangleCount()) || !triangleContains(fromId, entry)) {
+        throw std::invalid_argument("The entry point of the link is not contained by the triangle it leaves");
+    }
+    if ((toId < 0) || (toId >= triangleCount()) || !triangleContains(toId, exit)) {
+        throw std::invalid_argument("The exit point of the link is not contained by the triangle it leads to");
+    }
+    long linkId = links_.size();
+    links_.push_back({ fromId, toId, entry.x(), entry.y(), exit.x(), exit.y(), cost });
+    linkCosts_.push_back(measureLinkCost(linkId));
+    nextOutgoingLinkIds_.push_back(firstOutgoingLinkIds_[fromId]);
+    firstOutgoingLinkIds_[fromId] = linkId;
+    nextIncomingLinkIds_.push_back(firstIncomingLinkIds_[toId]);
+    firstIncomingLinkIds_[toId] = linkId;
+    auto distance = entry.distanceFrom(exit);
+    if (distance > 0.0) {
+        minLinkCostRatio_ = std::min(minLinkCostRatio_, cost / distance);
+    }
+    // a new way may be shorter than the paths found so far
+    unblockCount_++;
+    return linkId;
+}
+
+long TriangleGraph::findOffMeshLink(long fromId, long toId)
+{
+    long cheapest = -1;
+    for (auto link = firstOutgoingLinkIds_[fromId]; link >= 0; link = nextOutgoingLinkIds_[link]) {
+        if ((links_[link].toId == toId) && ((cheapest < 0) || (linkCosts_[link] < linkCosts_[cheapest]))) {
+            cheapest = link;
+        }
+    }
+    return cheapest;
+}
+
+/*
+ * The width of a triangle between two of its edges is limited by the obstacles closest to the corner they share:
+ * the other corners, the opposite edge if it is on the boundary, and whatever lies beyond it close enough to the
+ * corner, as in the triangle width of TRA*. Only corners on the boundary count as obstacles.
+ */
+void TriangleGraph::measureClearances()
+{
+    long vertexCount = 0;
+    for (auto& ids : vertexIds_) {
+        vertexCount = std::max(vertexCount, *std::max_element(begin(ids), end(ids)) + 1);
+    }
+    isObstacleVertex_.assign(vertexCount, 0);
+    for (long id = 0; id < triangles_.size(); id++) {
+        for (int edge = 0; edge < 3; edge++) {
+            if (edgeNeighbourIds_[id][edge] < 0) {
+                isObstacleVertex_[vertexIds_[id][edge]] = 1;
+                isObstacleVertex_[vertexIds_[id][(edge + 1) % 3]] = 1;
+            }
+        }
+    }
+
+    auto infinity = std::numeric_limits<double>::infinity();
+    clearances_.assign(triangles_.size(), { 0.0f, 0.0f, 0.0f });
+    for (long id = 0; id < triangles_.size(); id++) {
+        for (int corner = 0; corner < 3; corner++) {
+            if (!isObstacleCorner(id, corner)) {
+                clearances_[id][corner] = static_cast<float>(infinity);
+                continue;
+            }
+            auto c = cornerOf(id, corner);
+            auto width = infinity;
+            for (int other = 1; other < 3; other++) {
+                if (isObstacleCorner(id, (corner + other) % 3)) {
+                    width = std::min(width, c.distanceFrom(cornerOf(id, (corner + other) % 3)));
+                }
+            }
+            clearances_[id][corner] = static_cast<float>(searchWidth(c, id, (corner + 1) % 3, width, 0));
+        }
+    }
+}
+
+// Narrows the width by the obstacles beyond the edge, which only matter if the corner projects onto the edge
+// closer than the width found so far
+double TriangleGraph::searchWidth(Vector corner, long id, int edge, double width, int depth)
+{
+    const int maxDepth = 16;
+    auto a = cornerOf(id, edge);
+    auto ab = cornerOf(id, (edge + 1) % 3) - a;
+    auto t = (corner - a).dotProductWith(ab) / ab.dotProductWith(ab);
+    if ((t <= 0.0) || (t >= 1.0)) {
+        return width;
+    }
+    auto edgeDistance = corner.distanceFrom(a + ab * t);
+    if (edgeDistance >= width) {
+        return width;
+    }
+    auto neighbour = edgeNeighbourIds_[id][edge];
+    if ((neighbour < 0) || (depth == maxDepth)) {
+        // the walls of the boundary, or everything further if the search gives up
+        return edgeDistance;
+    }
+    auto entryEdge = edgeTowards(neighbour, id);
+    auto farCorner = (entryEdge + 2) % 3;
+    if (isObstacleCorner(neighbour, farCorner)) {
+        width = std::min(width, corner.distanceFrom(cornerOf(neighbour, farCorner)));
+    }
+    width = searchWidth(corner, neighbour, (entryEdge + 1) % 3, width, depth + 1);
+    return searchWidth(corner, neighbour, (entryEdge + 2) % 3, width, depth + 1);
+}
+
+void TriangleGraph::setBlocked(long id, bool isBlocked)
+{
+    if ((id < 0) || (id >= triangleCount())) {
+        throw std::invalid_argument("Cannot find triangle with the specified id");
+    }
+    if (this->isBlocked(id) && !isBlocked) {
+        unblockCount_++;
+    }
+    isBlocked_[id] = isBlocked ? 1 : 0;
+}
+
+void TriangleGraph::weldVertices()
+{
+    VertexWelder welder(3 * triangles_.size());
+    vertexIds_.reserve(triangles_.size());
+    for (auto& triangle : triangles_) {
+        vertexIds_.push_back({ welder.idOf(triangle.a()), welder.idOf(triangle.b()), welder.idOf(triangle.c()) });
+    }
+}
+
+// Two triangles are neighbours if they share exactly two corners, which is the same relation
+// TriangleSkeleton::isAdjacentWith describes, found by sorting the edges instead of comparing every pair
+void TriangleGraph::findNeighbours()
+{
+    std::vector<EdgeRecord> edges;
+    edges.reserve(3 * triangles_.size());
+    for (long i=0; i<triangles_.size(); i++) {
+        for (int edge = 0; edge < 3; edge++) {
+            auto first = vertexIds_[i][edge];
+            auto second = vertexIds_[i][(edge + 1) % 3];
+            edges.push_back({ std::min(first, second), std::max(first, second), i, edge });
+        }
+    }
+    std::sort(begin(edges), end(edges), [](const EdgeRecord& lhs, const EdgeRecord& rhs) {
+        return std::tie(lhs.lowerVertexId, lhs.higherVertexId, lhs.triangleId) <
+               std::tie(rhs.lowerVertexId, rhs.higherVertexId, rhs.triangleId);
+    });
+
+    for (auto& neighbours : neighbourIds_) {
+        neighbours.reserve(3);
+    }
+    edgeNeighbourIds_.assign(triangles_.size(), { -1, -1, -1 });
+    auto sharesAllCorners = [&](long i, long j) {
+        return std::is_permutation(begin(vertexIds_[i]), end(vertexIds_[i]), begin(vertexIds_[j]));
+    };
+    for (long groupStart = 0, groupEnd = 0; groupStart < edges.size(); groupStart = groupEnd) {
+        while ((groupEnd < edges.size()) &&
+               (edges[groupEnd].lowerVertexId == edges[groupStart].lowerVertexId) &&
+               (edges[groupEnd].higherVertexId == edges[groupStart].higherVertexId)) {
+            groupEnd++;
+        }
+        for (long i = groupStart; i < groupEnd; i++) {
+            for (long j = groupStart; j < groupEnd; j++) {
+                auto first = edges[i].triangleId;
+                auto second = edges[j].triangleId;
+                if ((i != j) && !sharesAllCorners(first, second)) {
+                    neighbourIds_[first].push_back(second);
+                    auto& acrossEdge = edgeNeighbourIds_[first][edges[i].edge];
+                    acrossEdge = (acrossEdge < 0) ? second : acrossEdge;
+                }
+            }
+        }
+    }
+    for (auto& neighbours : neighbourIds_) {
+        std::sort(begin(neighbours), end(neighbours));
+    }
+}
+
+// The builder already knows the neighbour across every edge, so the edges do not need to be matched again
+void TriangleGraph::takeNeighbours(std::vector<std::array<long, 3>> edgeNeighbourIds)
+{
+    if (edgeNeighbourIds.size() != triangles_.size()) {
+        throw std::invalid_argument("The neighbours of the mesh do not match its triangles");
+    }
+    edgeNeighbourIds_ = std::move(edgeNeighbourIds);
     for (long i=0; i<triangles_.size(); i++) {
-        for (long j=0; j<triangles_.size(); j++) {
-            if (triangles_[i].isAdjacentWith(triangles_[j])) {
-                neighbourIds_[i].push_back(j);
+        auto& neighbours = neighbourIds_[i];
+        for (auto neighbour : edgeNeighbourIds_[i]) {
+            if (neighbour >= 0) {
+                neighbours.push_back(neighbour);
             }
         }
+        std::sort(begin(neighbours), end(neighbours));
+    }
+}
+
+void TriangleGraph::sortAlongHilbertCurve()
+{
+    std::vector<double> xs;
+    std::vector<double> ys;
+    for (auto& metadata : metadata_) {
+        xs.push_back(metadata.centroidX);
+        ys.push_back(metadata.centroidY);
+    }
+    auto order = HilbertCurve::sortedOrder(xs, ys);
+    for (long i=0; i<order.size(); i++) {
+        internalIds_[order[i]] = i;
+    }
+
+    std::vector<TriangleSkeleton> triangles;
+    std::vector<std::vector<long>> neighbourIds(order.size());
+    std::vector<TriangleMetadata> metadata;
+    std::vector<std::array<long, 3>> vertexIds;
+    std::vector<std::array<long, 3>> edgeNeighbourIds;
+    std::vector<long> layers;
+    triangles.reserve(order.size());
+    metadata.reserve(order.size());
+    vertexIds.reserve(order.size());
+    for (long i=0; i<order.size(); i++) {
+        auto oldId = order[i];
+        triangles.push_back(triangles_[oldId]);
+        metadata.push_back(metadata_[oldId]);
+        vertexIds.push_back(vertexIds_[oldId]);
+        if (!layers_.empty()) {
+            layers.push_back(layers_[oldId]);
+        }
+        edgeNeighbourIds.push_back(edgeNeighbourIds_[oldId]);
+        for (auto& neighbour : edgeNeighbourIds.back()) {
+            neighbour = (neighbour < 0) ? neighbour : internalIds_[neighbour];
+        }
+        neighbourIds[i] = std::move(neighbourIds_[oldId]);
+        for (auto& neighbour : neighbourIds[i]) {
+            neighbour = internalIds_[neighbour];
+        }
+        std::sort(begin(neighbourIds[i]), end(neighbourIds[i]));
     }
+    triangles_ = std::move(triangles);
+    neighbourIds_ = std::move(neighbourIds);
+    metadata_ = std::move(metadata);
+    vertexIds_ = std::move(vertexIds);
+    edgeNeighbourIds_ = std::move(edgeNeighbourIds);
+    layers_ = std::move(layers);
+    externalIds_ = std::move(order);
 }
 
+void TriangleGraph::buildLayerIndices()
+{
+    if (layers_.empty()) {
+        return;
+    }
+    layerCount_ = *std::max_element(begin(layers_), end(layers_)) + 1;
+    if (layerCount_ == 1) {
+        return;
+    }
+    layerTriangleIds_.assign(layerCount_, {});
+    for (long id = 0; id < static_cast<long>(layers_.size()); id++) {
+        layerTriangleIds_[layers_[id]].push_back(id);
+    }
+    for (auto& ids : layerTriangleIds_) {
+        std::vector<TriangleMetadata> metadata;
+        metadata.reserve(ids.size());
+        for (auto id : ids) {
+            metadata.push_back(metadata_[id]);
+        }
+        layerGrids_.emplace_back(metadata);
+    }
+}
+
+long TriangleGraph::externalIdOf(long id) { return externalIds_.at(id); }
+
+long TriangleGraph::internalIdOf(long externalId) { return internalIds_.at(externalId); }
+
 std::vector<Triangle> TriangleGraph::getNeighbours(Triangle triangle) {
-    if ((triangle.id() > triangles_.size()) || (triangle.id() < 0))
+    auto neighbours = tryGetNeighbours(triangle);
+    if (!neighbours)
     {
         throw std::invalid_argument("Cannot find triangle with the specified id");
     }
+    return *neighbours;
+}
+
+std::optional<std::vector<Triangle>> TriangleGraph::tryGetNeighbours(Triangle triangle) {
+    if ((triangle.id() >= triangleCount()) || (triangle.id() < 0))
+    {
+        return std::nullopt;
+    }
     // todo check input Triangle equality with stored one
     std::vector<Triangle> adjacentTriangles;
-    auto neighbourIds = neighbourIds_[triangle.id()];
+    auto& neighbourIds = neighbourIds_[triangle.id()];
+    adjacentTriangles.reserve(neighbourIds.size());
     std::for_each(begin(neighbourIds), end(neighbourIds),
             [&](auto& id) { adjacentTriangles.push_back(buildTriangleFromId(id)); });
     return adjacentTriangles;
 }
 
-bool TriangleGraph::containsPoint(Vector point) {
-    return std::any_of(begin(triangles_), end(triangles_), [&](auto& t) { return t.containsPoint(point); });
-}
+long TriangleGraph::triangleCount() { return triangles_.size(); }
+
+bool TriangleGraph::containsPoint(Vector point) { return findIdOfTriangleUnder(point) >= 0; }
 
 Triangle TriangleGraph::getTriangleUnder(Vector point) {
-    if (!containsPoint(point))
+    auto id = findIdOfTriangleUnder(point);
+    if (id < 0)
     {
         throw std::invalid_argument("The specified point is not contained by any triangle in this graph");
     }
-    auto id = determineIdOfTriangleUnderPoint(point);
     return buildTriangleFromId(id);
 }
 
-long TriangleGraph::determineIdOfTriangleUnderPoint(Vector point) {
-    for (long i=0; i<triangles_.size(); i++) {
-        if (triangles_[i].containsPoint(point)) {
-            return i;
+std::optional<Triangle> TriangleGraph::tryGetTriangleUnder(Vector point) {
+    auto id = findIdOfTriangleUnder(point);
+    if (id < 0)
+    {
+        return std::nullopt;
+    }
+    return buildTriangleFromId(id);
+}
+
+bool TriangleGraph::triangleContains(long id, Vector point)
+{
+    return metadata_[id].boundingBoxContains(point) && triangles_[id].containsPoint(point);
+}
+
+// Only the triangles listed in the grid cell of the point are tested, in a single pass
+long TriangleGraph::findIdOfTriangleUnder(Vector point) noexcept {
+    return grid_.findTriangleAt(point.x(), point.y(), [&](long id) {
+        return metadata_[id].boundingBoxContains(point) && triangles_[id].containsPoint(point);
+    });
+}
+
+// The layers are looked up one by one, each in a grid of its own, so floors above each other do not crowd the cells
+long TriangleGraph::findIdOfTriangleUnder(Vector point, double height) noexcept
+{
+    long nearestId = -1;
+    auto nearestDistance = std::numeric_limits<double>::infinity();
+    for (long layer = 0; layer < layerCount_; layer++) {
+        auto id = findIdOfTriangleUnderOnLayer(point, layer);
+        if (id < 0) {
+            continue;
         }
+        auto distance = std::abs(heightAt(id, point) - height);
+        if (distance < nearestDistance) {
+            nearestId = id;
+            nearestDistance = distance;
+        }
+    }
+    return nearestId;
+}
+
+long TriangleGraph::findIdOfTriangleUnderOnLayer(Vector point, long layer) noexcept
+{
+    if ((layer < 0) || (layer >= layerCount_)) {
+        return -1;
+    }
+    if (layerGrids_.empty()) {
+        return findIdOfTriangleUnder(point);
+    }
+    auto& ids = layerTriangleIds_[layer];
+    auto index = layerGrids_[layer].findTriangleAt(point.x(), point.y(), [&](long index) {
+        return metadata_[ids[index]].boundingBoxContains(point) && triangles_[ids[index]].containsPoint(point);
+    });
+    return (index < 0) ? -1 : ids[index];
+}
+
+// Barycentric weights of the corners, each the area of the triangle the point forms with the opposite edge
+double TriangleGraph::heightAt(long id, Vector point)
+{
+    if (heights_.empty()) {
+        return 0.0;
+    }
+    auto a = cornerOf(id, 0);
+    auto b = cornerOf(id, 1);
+    auto c = cornerOf(id, 2);
+    auto area = doubleSignedArea(a, b, c);
+    auto weightA = doubleSignedArea(point, b, c) / area;
+    auto weightB = doubleSignedArea(a, point, c) / area;
+    auto weightC = 1.0 - weightA - weightB;
+    auto& vertexIds = vertexIds_[id];
+    return weightA * heights_[vertexIds[0]] + weightB * heights_[vertexIds[1]] + weightC * heights_[vertexIds[2]];
+}
+
+/*
+ * Walks from the triangle under the start point towards the end point, always stepping over the edge
+ * the segment leaves the current triangle through. Only the triangles touched by the segment are visited.
+ */
+RaycastResult TriangleGraph::raycast(Vector start, Vector end)
+{
+    auto id = findIdOfTriangleUnder(start);
+    if (id < 0)
+    {
+        throw std::invalid_argument("The specified start point is not contained by any triangle in this graph");
+    }
+    return raycast(id, start, end);
+}
+
+RaycastResult TriangleGraph::raycast(long startId, Vector start, Vector end)
+{
+    if ((startId < 0) || (startId >= triangleCount()) || !triangleContains(startId, start)) {
+        throw std::invalid_argument("The specified start point is not contained by the specified triangle");
+    }
+    auto id = startId;
+    auto direction = end - start;
+    int entryEdge = -1;
+    long visitedTriangleCount = 1;
+
+    while (!triangles_[id].containsPoint(end) && (visitedTriangleCount <= triangleCount())) {
+        int exitEdge = -1;
+        double exitDistance = 0.0;
+        for (int edge = 0; edge < 3; edge++) {
+            if (edge == entryEdge) {
+                continue;
+            }
+            auto p = cornerOf(id, edge);
+            auto pq = cornerOf(id, (edge + 1) % 3) - p;
+            auto startToP = p - start;
+            // start + t * direction = p + u * pq
+            auto denominator = direction.x() * pq.y() - direction.y() * pq.x();
+            if (std::abs(denominator) < std::numeric_limits<double>::epsilon()) {
+                continue;
+            }
+            auto t = (startToP.x() * pq.y() - startToP.y() * pq.x()) / denominator;
+            auto u = (startToP.x() * direction.y() - startToP.y() * direction.x()) / denominator;
+            auto tolerance = Vector::EQUALITY_CHECK_TOLERANCE / pq.len();
+            if ((u > -tolerance) && (u < 1.0 + tolerance) && ((exitEdge < 0) || (t > exitDistance))) {
+                exitEdge = edge;
+                exitDistance = t;
+            }
+        }
+        if (exitEdge < 0) {
+            break;
+        }
+
+        auto neighbour = edgeNeighbourIds_[id][exitEdge];
+        if (neighbour < 0) {
+            return RaycastResult { false, id, visitedTriangleCount,
+                                   Edge(cornerOf(id, exitEdge), cornerOf(id, (exitEdge + 1) % 3)),
+                                   start + direction * exitDistance };
+        }
+        entryEdge = edgeTowards(neighbour, id);
+        id = neighbour;
+        visitedTriangleCount++;
+    }
+    // a walk that stalled or went round in circles never reached the endpoint
+    return RaycastResult { triangles_[id].containsPoint(end), id, visitedTriangleCount, std::nullopt, std::nullopt };
+}
+
+/*
+ * A point off the mesh is closest to one of the boundary edges, so only those are projected onto,
+ * and only for the triangles the grid finds within the search radius.
+ */
+std::optional<NearestPoint> TriangleGraph::findNearestPoint(Vector point, double maxRadius)
+{
+    return findNearestPointOnLayer(point, maxRadius, -1);
+}
+
+std::optional<NearestPoint> TriangleGraph::findNearestPoint(Vector point, double maxRadius, long layer)
+{
+    if ((layer < 0) || (layer >= layerCount())) {
+        throw std::invalid_argument("The graph has no layer with the specified number");
+    }
+    return findNearestPointOnLayer(point, maxRadius, layer);
+}
+
+// a negative layer accepts the triangles of every layer
+std::optional<NearestPoint> TriangleGraph::findNearestPointOnLayer(Vector point, double maxRadius, long layer)
+{
+    auto x = point.x();
+    auto y = point.y();
+    auto idUnderPoint = (layer < 0) ? findIdOfTriangleUnder(point) : findIdOfTriangleUnderOnLayer(point, layer);
+    if (idUnderPoint >= 0) {
+        return NearestPoint { buildTriangleFromId(idUnderPoint), point, 0.0 };
     }
-    throw std::invalid_argument("Cannot find triangle under the specified point");
+
+    long nearestId = -1;
+    double nearestX = 0.0;
+    double nearestY = 0.0;
+    double nearestDistance = maxRadius;
+    grid_.forEachTriangleOverlapping(x - maxRadius, y - maxRadius, x + maxRadius, y + maxRadius, [&](long id) {
+        auto& metadata = metadata_[id];
+        if ((layer >= 0) && (layerOf(id) != layer)) {
+            return;
+        }
+        if ((metadata.minX - x > nearestDistance) || (x - metadata.maxX > nearestDistance) ||
+            (metadata.minY - y > nearestDistance) || (y - metadata.maxY > nearestDistance)) {
+            return;
+        }
+        for (int edge = 0; edge < 3; edge++) {
+            if (edgeNeighbourIds_[id][edge] >= 0) {
+                continue;
+            }
+            auto closest = Edge(cornerOf(id, edge), cornerOf(id, (edge + 1) % 3)).closestPointTo(point);
+            auto distance = closest.distanceFrom(point);
+            if (distance <= nearestDistance) {
+                nearestId = id;
+                nearestX = closest.x();
+                nearestY = closest.y();
+                nearestDistance = distance;
+            }
+        }
+    });
+    if (nearestId < 0) {
+        return std::nullopt;
+    }
+    return NearestPoint { buildTriangleFromId(nearestId), Vector(nearestX, nearestY), nearestDistance };
+}
+
+Vector TriangleGraph::cornerOf(long id, int corner)
+{
+    auto& triangle = triangles_[id];
+    return (corner == 0) ? triangle.a() : ((corner == 1) ? triangle.b() : triangle.c());
+}
+
+int TriangleGraph::edgeTowards(long id, long neighbourId)
+{
+    auto& neighbours = edgeNeighbourIds_[id];
+    return static_cast<int>(std::find(begin(neighbours), end(neighbours), neighbourId) - begin(neighbours));
 }
 
 Triangle TriangleGraph::buildTriangleFromId(long id) {
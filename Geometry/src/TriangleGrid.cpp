@@ -0,0 +1,87 @@
+/**
+ * Copyright 2019 Márton Gergó
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <TriangleGrid.h>
+#include <algorithm>
+#include <cmath>
+
+using namespace TpaStarCpp::GeometryLibrary;
+
+TriangleGrid::TriangleGrid(const std::vector<TriangleMetadata>& metadata)
+{
+    if (metadata.empty()) {
+        return;
+    }
+
+    double maxX = metadata[0].maxX;
+    double maxY = metadata[0].maxY;
+    double totalArea = 0.0;
+    minX_ = metadata[0].minX;
+    minY_ = metadata[0].minY;
+    for (auto& triangle : metadata) {
+        minX_ = std::min(minX_, triangle.minX);
+        minY_ = std::min(minY_, triangle.minY);
+        maxX = std::max(maxX, triangle.maxX);
+        maxY = std::max(maxY, triangle.maxY);
+        totalArea += (triangle.maxX - triangle.minX) * (triangle.maxY - triangle.minY);
+    }
+    minX_ -= Vector::EQUALITY_CHECK_TOLERANCE;
+    minY_ -= Vector::EQUALITY_CHECK_TOLERANCE;
+    double width = maxX - minX_ + Vector::EQUALITY_CHECK_TOLERANCE;
+    double height = maxY - minY_ + Vector::EQUALITY_CHECK_TOLERANCE;
+
+    auto count = static_cast<double>(metadata.size());
+    cellSize_ = std::max({ std::sqrt(2.0 * totalArea / count), std::sqrt(width * height / (4.0 * count)),
+                           Vector::EQUALITY_CHECK_TOLERANCE });
+    columns_ = std::max(1L, static_cast<long>(std::ceil(width / cellSize_)));
+    rows_ = std::max(1L, static_cast<long>(std::ceil(height / cellSize_)));
+
+    // counting pass, then filling pass into the ranges the counts define
+    cellStarts_.assign(columns_ * rows_ + 1, 0);
+    auto forEachCellOf = [&](const TriangleMetadata& triangle, auto visit) {
+        double tolerance = Vector::EQUALITY_CHECK_TOLERANCE;
+        auto lastColumn = columnOf(triangle.maxX + tolerance);
+        auto lastRow = rowOf(triangle.maxY + tolerance);
+        for (auto row = rowOf(triangle.minY - tolerance); row <= lastRow; row++) {
+            for (auto column = columnOf(triangle.minX - tolerance); column <= lastColumn; column++) {
+                visit(row * columns_ + column);
+            }
+        }
+    };
+    for (auto& triangle : metadata) {
+        forEachCellOf(triangle, [&](long cell) { cellStarts_[cell + 1]++; });
+    }
+    for (long cell = 0; cell < columns_ * rows_; cell++) {
+        cellStarts_[cell + 1] += cellStarts_[cell];
+    }
+    triangleIds_.resize(cellStarts_.back());
+    auto nextFreeSlots = cellStarts_;
+    for (long id = 0; id < metadata.size(); id++) {
+        forEachCellOf(metadata[id], [&](long cell) { triangleIds_[nextFreeSlots[cell]++] = id; });
+    }
+}
+
+long TriangleGrid::columnOf(double x) const
+{
+    auto column = std::floor((x - minX_) / cellSize_);
+    return static_cast<long>(std::clamp(column, 0.0, static_cast<double>(columns_ - 1)));
+}
+
+long TriangleGrid::rowOf(double y) const
+{
+    auto row = std::floor((y - minY_) / cellSize_);
+    return static_cast<long>(std::clamp(row, 0.0, static_cast<double>(rows_ - 1)));
+}
@@ -0,0 +1,56 @@
+/**
+ * Copyright 2019 Márton Gergó
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <TriangleMetadata.h>
+#include <algorithm>
+#include <cmath>
+
+using namespace TpaStarCpp::GeometryLibrary;
+
+static_assert(sizeof(TriangleMetadata) == 128, "Triangle metadata is expected to fill exactly two cache lines");
+
+TriangleMetadata TriangleMetadata::of(TriangleSkeleton triangle)
+{
+    double xs[3] = { triangle.a().x(), triangle.b().x(), triangle.c().x() };
+    double ys[3] = { triangle.a().y(), triangle.b().y(), triangle.c().y() };
+
+    TriangleMetadata metadata {};
+    metadata.centroidX = (xs[0] + xs[1] + xs[2]) / 3.0;
+    metadata.centroidY = (ys[0] + ys[1] + ys[2]) / 3.0;
+    metadata.minX = std::min({ xs[0], xs[1], xs[2] });
+    metadata.minY = std::min({ ys[0], ys[1], ys[2] });
+    metadata.maxX = std::max({ xs[0], xs[1], xs[2] });
+    metadata.maxY = std::max({ ys[0], ys[1], ys[2] });
+    metadata.area = std::abs((xs[1] - xs[0]) * (ys[2] - ys[0]) - (xs[2] - xs[0]) * (ys[1] - ys[0])) / 2.0;
+    for (int edge = 0; edge < 3; edge++) {
+        int next = (edge + 1) % 3;
+        metadata.edgeLengths[edge] = std::hypot(xs[next] - xs[edge], ys[next] - ys[edge]);
+        metadata.edgeMidpointsX[edge] = (xs[edge] + xs[next]) / 2.0;
+        metadata.edgeMidpointsY[edge] = (ys[edge] + ys[next]) / 2.0;
+    }
+    return metadata;
+}
+
+Vector TriangleMetadata::centroid() const { return Vector(centroidX, centroidY); }
+
+Vector TriangleMetadata::edgeMidpoint(int edge) const { return Vector(edgeMidpointsX[edge], edgeMidpointsY[edge]); }
+
+bool TriangleMetadata::boundingBoxContains(Vector point) const
+{
+    double tolerance = Vector::EQUALITY_CHECK_TOLERANCE;
+    return (point.x() > minX - tolerance) && (point.x() < maxX + tolerance) &&
+           (point.y() > minY - tolerance) && (point.y() < maxY + tolerance);
+}
@@ -0,0 +1,75 @@
+/**
+ * Copyright 2019 Márton Gergó
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <TriangleSearch.h>
+#include <stdexcept>
+#include "LandmarkHeuristic.h"
+
+using namespace TpaStarCpp::GeometryLibrary;
+
+TriangleSearch::TriangleSearch(std::shared_ptr<TriangleGraph> graph) :
+    graph_(std::move(graph)),
+    nodes_(graph_->triangleCount())
+{
+}
+
+long TriangleSearch::locate(Vector point, const char* message)
+{
+    auto id = graph_->findIdOfTriangleUnder(point);
+    if (id < 0) {
+        throw std::invalid_argument(message);
+    }
+    return id;
+}
+
+SearchResult TriangleSearch::findPath(Vector start, Vector goal)
+{
+    auto startId = locate(start, "The specified start point is not contained by any triangle in this graph");
+    auto goalId = locate(goal, "The specified goal point is not contained by any triangle in this graph");
+    return findPath(startId, start, goalId, goal, [](long) { return true; });
+}
+
+SearchResult TriangleSearch::findPath(Vector start, Vector goal, LandmarkHeuristic& landmarks)
+{
+    auto startId = locate(start, "The specified start point is not contained by any triangle in this graph");
+    auto goalId = locate(goal, "The specified goal point is not contained by any triangle in this graph");
+    auto goalX = goal.x();
+    auto goalY = goal.y();
+    auto goalCost = graph_->costWithin(goalId, graph_->metadataOf(goalId).centroid(), goal);
+    auto minMultiplier = graph_->minCostMultiplier();
+    return findPath(startId, start, goalId, goal, [](long) { return true; }, [&](long id) {
+        auto& metadata = graph_->metadataOf(id);
+        auto straightLine = minMultiplier * std::hypot(metadata.centroidX - goalX, metadata.centroidY - goalY);
+        return std::max(straightLine, landmarks.estimate(id, goalId) + goalCost);
+    });
+}
+
+SearchResult TriangleSearch::findBoundedPath(Vector start, Vector goal, double bound)
+{
+    if (!(bound >= 1.0)) {
+        throw std::invalid_argument("The suboptimality bound must be at least 1");
+    }
+    auto startId = locate(start, "The specified start point is not contained by any triangle in this graph");
+    auto goalId = locate(goal, "The specified goal point is not contained by any triangle in this graph");
+    auto goalX = goal.x();
+    auto goalY = goal.y();
+    auto weight = bound * graph_->minCostMultiplier();
+    // reopening keeps the bound: a node of the shortest path with its final cost is always on the open list
+    return findPath(startId, start, goalId, goal, [](long) { return true; }, [&](long id) {
+        auto& metadata = graph_->metadataOf(id);
+        return weight * std::hypot(metadata.centroidX - goalX, metadata.centroidY - goalY);
+    });
+}
@@ -0,0 +1,94 @@
+/**
+ * Copyright 2019 Márton Gergó
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "catch.hpp"
+#include "AnytimeSearch.h"
+#include "MeshGenerator.h"
+#include "TriangleSearch.h"
+#include "Vector.h"
+
+using namespace TpaStarCpp::GeometryLibrary;
+
+TEST_CASE("Anytime search should stay within the bound of every pass")
+{
+    auto graph = std::make_shared<TriangleGraph>(MeshGenerator(3).gridWithHoles(30, 30, 0.3));
+    TriangleSearch optimal(graph);
+    AnytimeSearch search(graph, 3.0, 0.5);
+
+    for (long goalId = 11; goalId < graph->triangleCount(); goalId += 173) {
+        auto start = graph->metadataOf(0).centroid();
+        auto goal = graph->metadataOf(goalId).centroid();
+        auto expected = optimal.findPath(start, goal);
+
+        auto first = search.start(start, goal);
+
+        REQUIRE(first.isFound == expected.isFound);
+        if (!first.isFound) {
+            continue;
+        }
+        CHECK(search.bound() <= 3.0);
+        CHECK(first.cost <= search.bound() * expected.cost + 1e-9);
+        auto previousCost = first.cost;
+        while (search.improve()) {
+            CHECK(search.result().cost <= search.bound() * expected.cost + 1e-9);
+            CHECK(search.result().cost <= previousCost + 1e-9);
+            previousCost = search.result().cost;
+        }
+        CHECK(search.bound() == 1.0);
+        CHECK(search.result().cost == Approx(expected.cost));
+    }
+}
+
+TEST_CASE("Anytime search should stop improving at the target bound")
+{
+    auto graph = std::make_shared<TriangleGraph>(MeshGenerator(4).corridorMaze(15, 15));
+    AnytimeSearch search(graph, 4.0, 0.25);
+    auto start = graph->metadataOf(0).centroid();
+    auto goal = graph->metadataOf(graph->triangleCount() - 1).centroid();
+    auto expected = TriangleSearch(graph).findPath(start, goal);
+
+    auto result = search.findPath(start, goal, 1.5, std::chrono::seconds(10));
+
+    REQUIRE(result.isFound);
+    CHECK(search.bound() <= 1.5);
+    CHECK(result.cost <= 1.5 * expected.cost + 1e-9);
+}
+
+TEST_CASE("Anytime search should throw for a weight below one")
+{
+    auto graph = std::make_shared<TriangleGraph>(MeshGenerator(1).gridWithHoles(4, 4, 0.0));
+
+    CHECK_THROWS_AS(AnytimeSearch(graph, 0.5), std::invalid_argument);
+}
+
+TEST_CASE("Weighted search should cost at most the bound times the shortest path")
+{
+    auto graph = std::make_shared<TriangleGraph>(MeshGenerator(4).corridorMaze(15, 15));
+    TriangleSearch search(graph);
+
+    for (long goalId = 5; goalId < graph->triangleCount(); goalId += 97) {
+        auto start = graph->metadataOf(0).centroid();
+        auto goal = graph->metadataOf(goalId).centroid();
+        auto expected = search.findPath(start, goal);
+
+        for (auto bound : { 1.0, 1.05, 1.5, 3.0 }) {
+            auto result = search.findBoundedPath(start, goal, bound);
+            REQUIRE(result.isFound);
+            CHECK(result.cost <= bound * expected.cost + 1e-9);
+        }
+    }
+    CHECK_THROWS_AS(search.findBoundedPath(Vector(0.5, 0.5), Vector(1.5, 0.5), 0.9), std::invalid_argument);
+}
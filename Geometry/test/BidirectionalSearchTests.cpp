@@ -0,0 +1,129 @@
+/**
+ * Copyright 2019 Márton Gergó
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "catch.hpp"
+#include "BidirectionalSearch.h"
+#include "MeshGenerator.h"
+#include "TriangleSearch.h"
+#include "Vector.h"
+
+using namespace TpaStarCpp::GeometryLibrary;
+
+static bool isConnected(std::shared_ptr<TriangleGraph> graph, const std::vector<long>& triangleIds)
+{
+    for (long i = 1; i < triangleIds.size(); i++) {
+        auto& neighbours = graph->neighbourIdsOf(triangleIds[i - 1]);
+        if (std::find(begin(neighbours), end(neighbours), triangleIds[i]) == end(neighbours)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+TEST_CASE("Bidirectional search should find paths as short as the one sided search")
+{
+    auto graph = std::make_shared<TriangleGraph>(MeshGenerator(3).gridWithHoles(30, 30, 0.25));
+    TriangleSearch oneSided(graph);
+    BidirectionalSearch search(graph);
+
+    for (long startId = 0; startId < graph->triangleCount(); startId += 97) {
+        for (long goalId = 5; goalId < graph->triangleCount(); goalId += 131) {
+            auto start = graph->metadataOf(startId).centroid();
+            auto goal = graph->metadataOf(goalId).centroid();
+            auto expected = oneSided.findPath(start, goal);
+            auto result = search.findPath(start, goal);
+
+            REQUIRE(result.isFound == expected.isFound);
+            if (result.isFound) {
+                CHECK(result.cost == Approx(expected.cost));
+                CHECK(result.triangleIds.front() == startId);
+                CHECK(result.triangleIds.back() == goalId);
+                CHECK(isConnected(graph, result.triangleIds));
+            }
+        }
+    }
+}
+
+TEST_CASE("Bidirectional search should find the shortest paths of a maze")
+{
+    auto graph = std::make_shared<TriangleGraph>(MeshGenerator(5).corridorMaze(12, 12));
+    TriangleSearch oneSided(graph);
+    BidirectionalSearch search(graph);
+
+    for (long startId = 0; startId < graph->triangleCount(); startId += 89) {
+        auto goalId = graph->triangleCount() - 1 - startId / 2;
+        auto start = graph->metadataOf(startId).centroid();
+        auto goal = graph->metadataOf(goalId).centroid();
+
+        auto result = search.findPath(start, goal);
+
+        REQUIRE(result.isFound);
+        CHECK(result.cost == Approx(oneSided.findPath(start, goal).cost));
+        CHECK(isConnected(graph, result.triangleIds));
+    }
+}
+
+TEST_CASE("Bidirectional search should follow off-mesh links from both sides")
+{
+    auto graph = std::make_shared<TriangleGraph>(MeshGenerator(1).gridWithHoles(10, 10, 0.0));
+    for (int y = 0; y < 10; y++) {
+        graph->setBlocked(graph->findIdOfTriangleUnder(Vector(5.2, y + 0.5)), true);
+        graph->setBlocked(graph->findIdOfTriangleUnder(Vector(5.8, y + 0.5)), true);
+    }
+    graph->addOffMeshLink(Vector(4.5, 8.5), Vector(6.5, 8.5), 1.0);
+    TriangleSearch oneSided(graph);
+    BidirectionalSearch search(graph);
+
+    auto result = search.findPath(Vector(0.5, 0.5), Vector(9.5, 0.5));
+
+    REQUIRE(result.isFound);
+    CHECK(result.cost == Approx(oneSided.findPath(Vector(0.5, 0.5), Vector(9.5, 0.5)).cost));
+    CHECK_FALSE(search.findPath(Vector(9.5, 0.5), Vector(0.5, 0.5)).isFound);
+}
+
+TEST_CASE("Bidirectional search should return the distance of points in the same triangle")
+{
+    auto graph = std::make_shared<TriangleGraph>(MeshGenerator(1).gridWithHoles(4, 4, 0.0));
+    BidirectionalSearch search(graph);
+
+    auto result = search.findPath(Vector(1.6, 1.2), Vector(1.9, 1.6));
+
+    CHECK(result.isFound);
+    CHECK(result.triangleIds.size() == 1);
+    CHECK(result.cost == Approx(0.5));
+}
+
+TEST_CASE("Bidirectional search should report a goal cut off by blocked triangles")
+{
+    auto graph = std::make_shared<TriangleGraph>(MeshGenerator(1).gridWithHoles(10, 10, 0.0));
+    BidirectionalSearch search(graph);
+    for (int y = 0; y < 10; y++) {
+        graph->setBlocked(graph->findIdOfTriangleUnder(Vector(5.2, y + 0.5)), true);
+        graph->setBlocked(graph->findIdOfTriangleUnder(Vector(5.8, y + 0.5)), true);
+    }
+
+    auto result = search.findPath(Vector(0.5, 5.5), Vector(9.5, 5.5));
+
+    CHECK_FALSE(result.isFound);
+}
+
+TEST_CASE("Bidirectional search should throw if the start is not on the mesh")
+{
+    auto graph = std::make_shared<TriangleGraph>(MeshGenerator(1).gridWithHoles(4, 4, 0.0));
+    BidirectionalSearch search(graph);
+
+    CHECK_THROWS_AS(search.findPath(Vector(-1.0, 1.0), Vector(2.0, 2.0)), std::invalid_argument);
+}
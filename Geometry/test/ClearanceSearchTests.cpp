@@ -0,0 +1,146 @@
+/**
+ * Copyright 2019 Márton Gergó
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "catch.hpp"
+#include "ClearanceSearch.h"
+#include "Funnel.h"
+#include "MeshGenerator.h"
+#include "PolygonTriangulator.h"
+#include "TriangleSearch.h"
+#include "Vector.h"
+
+using namespace TpaStarCpp::GeometryLibrary;
+
+// a hall around a block, the way below it is narrower than the one above it but shorter
+static std::shared_ptr<TriangleGraph> buildHall()
+{
+    PolygonTriangulator triangulator;
+    triangulator.addOutline({ Vector(0.0, 0.0), Vector(30.0, 0.0), Vector(30.0, 10.0), Vector(0.0, 10.0) });
+    triangulator.addHole({ Vector(5.0, 0.5), Vector(5.0, 7.0), Vector(25.0, 7.0), Vector(25.0, 0.5) });
+    return triangulator.buildGraph();
+}
+
+static double distanceFromBlock(Vector point)
+{
+    std::vector<Vector> corners { Vector(5.0, 0.5), Vector(5.0, 7.0), Vector(25.0, 7.0), Vector(25.0, 0.5) };
+    auto distance = std::numeric_limits<double>::infinity();
+    for (auto& corner : corners) {
+        distance = std::min(distance, point.distanceFrom(corner));
+    }
+    return distance;
+}
+
+TEST_CASE("Triangle graph should measure the clearance at obstacle corners only")
+{
+    auto graph = std::make_shared<TriangleGraph>(MeshGenerator(1).gridWithHoles(4, 4, 0.0));
+    auto center = graph->findIdOfTriangleUnder(Vector(1.2, 1.6));
+
+    for (int corner = 0; corner < 3; corner++) {
+        auto point = graph->cornerOf(center, corner);
+        auto isOnBoundary = (point.x() == 0.0) || (point.x() == 4.0) || (point.y() == 0.0) || (point.y() == 4.0);
+        CHECK(graph->isObstacleCorner(center, corner) == isOnBoundary);
+        if (!isOnBoundary) {
+            CHECK(std::isinf(graph->clearanceOf(center, corner)));
+        }
+    }
+}
+
+TEST_CASE("Triangle graph should measure the width of a corridor as the clearance of its corners")
+{
+    auto graph = buildHall();
+    auto narrowest = std::numeric_limits<double>::infinity();
+
+    for (double x = 5.5; x < 25.0; x += 0.5) {
+        auto id = graph->findIdOfTriangleUnder(Vector(x, 0.25));
+        REQUIRE(id >= 0);
+        for (int corner = 0; corner < 3; corner++) {
+            // only the corners between two edges that can be crossed are gone around
+            if ((graph->neighbourIdAcross(id, corner) >= 0) && (graph->neighbourIdAcross(id, (corner + 2) % 3) >= 0)) {
+                narrowest = std::min(narrowest, graph->clearanceOf(id, corner));
+            }
+        }
+    }
+    CHECK(narrowest == Approx(0.5));
+}
+
+TEST_CASE("Clearance search should find the shortest path for agents fitting every way")
+{
+    auto graph = buildHall();
+    ClearanceSearch search(graph);
+    TriangleSearch unrestricted(graph);
+    Vector start(2.0, 2.0);
+    Vector goal(28.0, 2.0);
+
+    auto result = search.findPath(start, goal, 0.2);
+
+    REQUIRE(result.isFound);
+    CHECK(result.cost == Approx(unrestricted.findPath(start, goal).cost));
+}
+
+TEST_CASE("Clearance search should take the wider way for agents too wide for the shorter one")
+{
+    auto graph = buildHall();
+    ClearanceSearch search(graph);
+    Vector start(2.0, 2.0);
+    Vector goal(28.0, 2.0);
+
+    auto narrow = search.findPath(start, goal, 0.2);
+    auto wide = search.findPath(start, goal, 0.4);
+
+    REQUIRE(wide.isFound);
+    CHECK(wide.cost > narrow.cost);
+    for (auto id : wide.triangleIds) {
+        auto& metadata = graph->metadataOf(id);
+        CHECK(!((metadata.centroidX > 5.0) && (metadata.centroidX < 25.0) && (metadata.centroidY < 0.5)));
+    }
+}
+
+TEST_CASE("Clearance search should not find a path for agents wider than every way")
+{
+    auto graph = buildHall();
+    ClearanceSearch search(graph);
+
+    auto result = search.findPath(Vector(2.0, 2.0), Vector(28.0, 2.0), 1.6);
+
+    CHECK(!result.isFound);
+}
+
+TEST_CASE("Clearance search should throw for points outside the mesh or a negative radius")
+{
+    auto graph = buildHall();
+    ClearanceSearch search(graph);
+
+    CHECK_THROWS_AS(search.findPath(Vector(10.0, 3.0), Vector(28.0, 2.0), 0.2), std::invalid_argument);
+    CHECK_THROWS_AS(search.findPath(Vector(2.0, 2.0), Vector(28.0, 2.0), -1.0), std::invalid_argument);
+}
+
+TEST_CASE("Funnel should keep the radius of the agent from the obstacle corners it turns around")
+{
+    auto graph = buildHall();
+    ClearanceSearch search(graph);
+    Funnel funnel(graph, 0.4);
+    Vector start(2.0, 2.0);
+    Vector goal(28.0, 2.0);
+
+    auto corridor = search.findPath(start, goal, 0.4).triangleIds;
+    auto points = funnel.pullString(corridor, start, goal);
+
+    REQUIRE(points.size() > 2);
+    for (long i = 1; i + 1 < points.size(); i++) {
+        CHECK(distanceFromBlock(points[i]) == Approx(0.4));
+    }
+}
@@ -0,0 +1,168 @@
+/**
+ * Copyright 2019 Márton Gergó
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "catch.hpp"
+#include "ConvexPolygonGraph.h"
+#include "MeshGenerator.h"
+#include "TriangleSkeleton.h"
+#include "Vector.h"
+#include "Edge.h"
+#include <algorithm>
+
+using namespace TpaStarCpp::GeometryLibrary;
+
+static double areaOf(ConvexPolygonGraph& polygons, long id)
+{
+    double area = 0.0;
+    for (int corner = 0; corner < polygons.cornerCountOf(id); corner++) {
+        auto a = polygons.cornerOf(id, corner);
+        auto b = polygons.cornerOf(id, (corner + 1) % polygons.cornerCountOf(id));
+        area += (a.x() * b.y() - b.x() * a.y()) / 2.0;
+    }
+    return area;
+}
+
+// collinear corners are allowed, reflex ones and those turning back on themselves are not
+static bool isConvex(ConvexPolygonGraph& polygons, long id)
+{
+    auto count = polygons.cornerCountOf(id);
+    for (int corner = 0; corner < count; corner++) {
+        auto incoming = polygons.cornerOf(id, (corner + 1) % count) - polygons.cornerOf(id, corner);
+        auto outgoing = polygons.cornerOf(id, (corner + 2) % count) - polygons.cornerOf(id, (corner + 1) % count);
+        auto cross = incoming.x() * outgoing.y() - incoming.y() * outgoing.x();
+        auto dot = incoming.x() * outgoing.x() + incoming.y() * outgoing.y();
+        if ((cross < -1e-9) || ((cross <= 1e-9) && (dot <= 0.0))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+TEST_CASE("Convex polygon graph should merge the two triangles of a square")
+{
+    auto graph = std::make_shared<TriangleGraph>(std::vector<TriangleSkeleton> {
+            TriangleSkeleton(Vector(0.0, 0.0), Vector(1.0, 0.0), Vector(1.0, 1.0)),
+            TriangleSkeleton(Vector(0.0, 0.0), Vector(0.0, 1.0), Vector(1.0, 1.0)) });
+
+    ConvexPolygonGraph polygons(graph);
+
+    CHECK(polygons.polygonCount() == 1);
+    CHECK(polygons.cornerCountOf(0) == 4);
+    CHECK(areaOf(polygons, 0) == Approx(1.0));
+    CHECK(polygons.triangleIdsOf(0) == std::vector<long> { 0, 1 });
+}
+
+TEST_CASE("Convex polygon graph should not merge triangles across a reflex corner")
+{
+    // an L shape, the corner at (1, 1) would become reflex if all of the triangles were merged
+    auto graph = std::make_shared<TriangleGraph>(std::vector<TriangleSkeleton> {
+            TriangleSkeleton(Vector(0.0, 0.0), Vector(2.0, 0.0), Vector(1.0, 1.0)),
+            TriangleSkeleton(Vector(2.0, 0.0), Vector(2.0, 1.0), Vector(1.0, 1.0)),
+            TriangleSkeleton(Vector(0.0, 0.0), Vector(1.0, 1.0), Vector(0.0, 2.0)),
+            TriangleSkeleton(Vector(1.0, 1.0), Vector(1.0, 2.0), Vector(0.0, 2.0)) });
+
+    ConvexPolygonGraph polygons(graph);
+
+    CHECK(polygons.polygonCount() == 2);
+    CHECK(isConvex(polygons, 0));
+    CHECK(isConvex(polygons, 1));
+}
+
+TEST_CASE("Convex polygon graph should return the shared edge of neighbouring polygons as their portal")
+{
+    auto graph = std::make_shared<TriangleGraph>(std::vector<TriangleSkeleton> {
+            TriangleSkeleton(Vector(0.0, 0.0), Vector(2.0, 0.0), Vector(1.0, 1.0)),
+            TriangleSkeleton(Vector(2.0, 0.0), Vector(2.0, 1.0), Vector(1.0, 1.0)),
+            TriangleSkeleton(Vector(0.0, 0.0), Vector(1.0, 1.0), Vector(0.0, 2.0)),
+            TriangleSkeleton(Vector(1.0, 1.0), Vector(1.0, 2.0), Vector(0.0, 2.0)) });
+    ConvexPolygonGraph polygons(graph);
+
+    auto portal = polygons.portalBetween(0, 1);
+
+    CHECK(polygons.neighbourIdsOf(0) == std::vector<long> { 1 });
+    CHECK(polygons.neighbourIdsOf(1) == std::vector<long> { 0 });
+    CHECK(((portal == Edge(Vector(0.0, 0.0), Vector(1.0, 1.0))) || (portal == Edge(Vector(1.0, 1.0), Vector(0.0, 0.0)))));
+    CHECK_THROWS_WITH(polygons.portalBetween(0, 0), Catch::Contains("not neighbours"));
+}
+
+TEST_CASE("Convex polygon graph of a generated mesh should have fewer convex polygons covering the same area")
+{
+    auto mesh = MeshGenerator(3).randomDelaunay(30, 30);
+    auto graph = std::make_shared<TriangleGraph>(mesh);
+
+    ConvexPolygonGraph polygons(graph);
+
+    double area = 0.0;
+    bool allConvex = true;
+    bool allNeighboursMutual = true;
+    for (long id = 0; id < polygons.polygonCount(); id++) {
+        area += areaOf(polygons, id);
+        allConvex &= isConvex(polygons, id);
+        for (auto neighbour : polygons.neighbourIdsOf(id)) {
+            auto& backwards = polygons.neighbourIdsOf(neighbour);
+            allNeighboursMutual &= std::binary_search(begin(backwards), end(backwards), id);
+        }
+    }
+    CHECK(polygons.polygonCount() < graph->triangleCount() * 2 / 3);
+    CHECK(area == Approx(900.0));
+    CHECK(allConvex);
+    CHECK(allNeighboursMutual);
+}
+
+TEST_CASE("Convex polygon graph should find the polygon under a point through the triangle under it")
+{
+    auto mesh = MeshGenerator(3).gridWithHoles(10, 10, 0.0);
+    auto graph = std::make_shared<TriangleGraph>(mesh);
+    ConvexPolygonGraph polygons(graph);
+
+    auto id = polygons.findIdOfPolygonUnder(Vector(2.5, 3.5));
+
+    CHECK(id == polygons.polygonIdOf(graph->findIdOfTriangleUnder(Vector(2.5, 3.5))));
+    CHECK(polygons.findIdOfPolygonUnder(Vector(20.0, 3.5)) == -1);
+}
+
+TEST_CASE("Convex polygon graph of a mesh with holes should not wrap polygons around the holes")
+{
+    for (unsigned long seed = 1; seed <= 3; seed++) {
+        auto graph = std::make_shared<TriangleGraph>(MeshGenerator(seed).gridWithHoles(20, 20, 0.2));
+
+        ConvexPolygonGraph polygons(graph);
+
+        double area = 0.0;
+        bool allConvex = true;
+        bool noneOwnNeighbour = true;
+        bool noneRepeatingCorners = true;
+        for (long id = 0; id < polygons.polygonCount(); id++) {
+            area += areaOf(polygons, id);
+            allConvex &= isConvex(polygons, id);
+            auto& neighbours = polygons.neighbourIdsOf(id);
+            noneOwnNeighbour &= !std::binary_search(begin(neighbours), end(neighbours), id);
+            for (int corner = 0; corner < polygons.cornerCountOf(id); corner++) {
+                for (int other = corner + 1; other < polygons.cornerCountOf(id); other++) {
+                    noneRepeatingCorners &= !(polygons.cornerOf(id, corner) == polygons.cornerOf(id, other));
+                }
+            }
+        }
+        double triangleArea = 0.0;
+        for (long id = 0; id < graph->triangleCount(); id++) {
+            triangleArea += graph->metadataOf(id).area;
+        }
+        CHECK(area == Approx(triangleArea));
+        CHECK(allConvex);
+        CHECK(noneOwnNeighbour);
+        CHECK(noneRepeatingCorners);
+    }
+}
@@ -0,0 +1,135 @@
+/**
+ * Copyright 2019 Márton Gergó
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "catch.hpp"
+#include "CorridorGraph.h"
+#include "MeshGenerator.h"
+#include "TriangleSkeleton.h"
+#include "Vector.h"
+
+using namespace TpaStarCpp::GeometryLibrary;
+
+// unit squares at the specified cells, each split into two triangles along the same diagonal
+static std::shared_ptr<TriangleGraph> cells(std::vector<std::pair<int, int>> positions)
+{
+    std::vector<TriangleSkeleton> triangles;
+    for (auto [x, y] : positions) {
+        triangles.emplace_back(Vector(x, y), Vector(x + 1, y), Vector(x + 1, y + 1));
+        triangles.emplace_back(Vector(x, y), Vector(x + 1, y + 1), Vector(x, y + 1));
+    }
+    return std::make_shared<TriangleGraph>(triangles);
+}
+
+static const std::vector<std::pair<int, int>> RING { { 0, 0 }, { 1, 0 }, { 2, 0 }, { 2, 1 }, { 2, 2 }, { 1, 2 }, { 0, 2 }, { 0, 1 } };
+
+TEST_CASE("Corridor graph should prune every triangle of a mesh without rings")
+{
+    auto graph = std::make_shared<TriangleGraph>(MeshGenerator(1).corridorMaze(5, 5));
+
+    CorridorGraph corridors(graph);
+
+    bool allTrees = true;
+    bool allDetached = true;
+    for (long id = 0; id < graph->triangleCount(); id++) {
+        allTrees &= corridors.levelOf(id) == ContractionLevel::Tree;
+        allDetached &= corridors.treeRootOf(id) == -1;
+    }
+    CHECK(allTrees);
+    CHECK(allDetached);
+    CHECK(corridors.corridorCount() == 0);
+}
+
+TEST_CASE("Corridor graph should collapse a ring into a single corridor around one junction")
+{
+    auto graph = cells(RING);
+
+    CorridorGraph corridors(graph);
+
+    REQUIRE(corridors.corridorCount() == 1);
+    auto& corridor = corridors.corridor(0);
+    CHECK(corridors.junctionIds().size() == 1);
+    CHECK(corridor.fromJunctionId == corridors.junctionIds()[0]);
+    CHECK(corridor.toJunctionId == corridors.junctionIds()[0]);
+    // the outer triangles of two corner cells are dead ends
+    CHECK(corridor.triangleIds.size() == 13);
+    CHECK(corridor.portals.size() == 14);
+}
+
+TEST_CASE("Corridor graph should hang dead ends off the triangle they are attached to")
+{
+    auto positions = RING;
+    positions.emplace_back(3, 1);
+    positions.emplace_back(4, 1);
+    auto graph = cells(positions);
+
+    CorridorGraph corridors(graph);
+
+    auto root = graph->findIdOfTriangleUnder(Vector(2.9, 1.5));
+    auto deadEnd = graph->findIdOfTriangleUnder(Vector(4.5, 1.2));
+    CHECK(corridors.levelOf(root) == ContractionLevel::Corridor);
+    CHECK(corridors.levelOf(deadEnd) == ContractionLevel::Tree);
+    CHECK(corridors.treeRootOf(deadEnd) == root);
+    CHECK(corridors.treeParentOf(graph->findIdOfTriangleUnder(Vector(3.5, 1.2))) ==
+          graph->findIdOfTriangleUnder(Vector(3.5, 1.8)));
+    CHECK(corridors.corridorCount() == 1);
+    CHECK(corridors.corridor(0).triangleIds.size() == 13);
+}
+
+TEST_CASE("Corridor graph should keep dead ends with an off-mesh link as junctions")
+{
+    auto positions = RING;
+    positions.emplace_back(3, 1);
+    positions.emplace_back(4, 1);
+    positions.emplace_back(8, 1);
+    auto graph = cells(positions);
+    graph->addOffMeshLink(Vector(4.5, 1.2), Vector(8.5, 1.2), 1.0);
+
+    CorridorGraph corridors(graph);
+
+    auto entry = graph->findIdOfTriangleUnder(Vector(4.5, 1.2));
+    auto exit = graph->findIdOfTriangleUnder(Vector(8.5, 1.2));
+    CHECK(corridors.levelOf(entry) == ContractionLevel::Junction);
+    CHECK(corridors.levelOf(exit) == ContractionLevel::Junction);
+    CHECK(corridors.levelOf(graph->findIdOfTriangleUnder(Vector(3.5, 1.2))) == ContractionLevel::Corridor);
+    CHECK(corridors.treeRootOf(graph->findIdOfTriangleUnder(Vector(8.5, 1.8))) == exit);
+}
+
+TEST_CASE("Corridor graph should connect the junctions of a mesh by corridors measured through their portals")
+{
+    auto graph = std::make_shared<TriangleGraph>(MeshGenerator(2).gridWithHoles(20, 20, 0.3));
+
+    CorridorGraph corridors(graph);
+
+    bool allPortalsCounted = true;
+    bool allLengthsLongEnough = true;
+    bool allTrianglesAssigned = true;
+    for (long i = 0; i < corridors.corridorCount(); i++) {
+        auto& corridor = corridors.corridor(i);
+        allPortalsCounted &= corridor.portals.size() == corridor.triangleIds.size() + 1;
+        auto from = graph->metadataOf(corridor.fromJunctionId).centroid();
+        auto to = graph->metadataOf(corridor.toJunctionId).centroid();
+        allLengthsLongEnough &= corridor.length >= from.distanceFrom(to) - 1e-9;
+    }
+    for (long id = 0; id < graph->triangleCount(); id++) {
+        if (corridors.levelOf(id) == ContractionLevel::Corridor) {
+            allTrianglesAssigned &= corridors.corridorIdOf(id) >= 0;
+        }
+    }
+    CHECK(corridors.corridorCount() > 0);
+    CHECK(allPortalsCounted);
+    CHECK(allLengthsLongEnough);
+    CHECK(allTrianglesAssigned);
+}
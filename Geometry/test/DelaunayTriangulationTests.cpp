@@ -0,0 +1,203 @@
+/**
+ * Copyright 2019 Márton Gergó
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "catch.hpp"
+#include "DelaunayTriangulation.h"
+#include <random>
+
+using namespace TpaStarCpp::GeometryLibrary;
+
+static double signedArea(IndexedMesh& mesh, std::array<long, 3> corners)
+{
+    return ((mesh.xs[corners[1]] - mesh.xs[corners[0]]) * (mesh.ys[corners[2]] - mesh.ys[corners[0]]) -
+            (mesh.xs[corners[2]] - mesh.xs[corners[0]]) * (mesh.ys[corners[1]] - mesh.ys[corners[0]])) / 2.0;
+}
+
+static bool isInCircumcircle(IndexedMesh& mesh, std::array<long, 3> corners, double px, double py)
+{
+    double ax = mesh.xs[corners[0]] - px, ay = mesh.ys[corners[0]] - py;
+    double bx = mesh.xs[corners[1]] - px, by = mesh.ys[corners[1]] - py;
+    double cx = mesh.xs[corners[2]] - px, cy = mesh.ys[corners[2]] - py;
+    double determinant = (ax * ax + ay * ay) * (bx * cy - cx * by)
+                       - (bx * bx + by * by) * (ax * cy - cx * ay)
+                       + (cx * cx + cy * cy) * (ax * by - bx * ay);
+    return determinant > 1e-9;
+}
+
+TEST_CASE("Delaunay triangulation should start with the two triangles of its rectangle")
+{
+    DelaunayTriangulation triangulation(0.0, 0.0, 2.0, 1.0);
+
+    auto mesh = triangulation.toIndexedMesh();
+
+    CHECK(triangulation.vertexCount() == 4);
+    CHECK(mesh.triangles.size() == 2);
+}
+
+TEST_CASE("Delaunay triangulation should split the triangle under an inserted point")
+{
+    DelaunayTriangulation triangulation(0.0, 0.0, 2.0, 2.0);
+
+    triangulation.insertVertex(1.0, 0.5);
+    auto mesh = triangulation.toIndexedMesh();
+
+    CHECK(mesh.triangles.size() == 4);
+}
+
+TEST_CASE("Delaunay triangulation should split the border edge under an inserted point")
+{
+    DelaunayTriangulation triangulation(0.0, 0.0, 2.0, 2.0);
+
+    triangulation.insertVertex(1.0, 0.0);
+    auto mesh = triangulation.toIndexedMesh();
+
+    CHECK(mesh.triangles.size() == 3);
+}
+
+TEST_CASE("Delaunay triangulation should reuse the vertex equal to an inserted point")
+{
+    DelaunayTriangulation triangulation(0.0, 0.0, 2.0, 2.0);
+    auto first = triangulation.insertVertex(1.0, 0.5);
+
+    auto second = triangulation.insertVertex(1.000001, 0.5);
+
+    CHECK(first == second);
+    CHECK(triangulation.vertexCount() == 5);
+}
+
+TEST_CASE("Delaunay triangulation should not accept points outside of its rectangle")
+{
+    DelaunayTriangulation triangulation(0.0, 0.0, 2.0, 2.0);
+
+    CHECK_THROWS_WITH(triangulation.insertVertex(3.0, 1.0), Catch::Contains("outside"));
+}
+
+TEST_CASE("Delaunay triangulation of random points should have counter-clockwise triangles with empty circumcircles")
+{
+    std::mt19937 random(3);
+    std::uniform_real_distribution<double> coordinate(0.0, 10.0);
+    DelaunayTriangulation triangulation(0.0, 0.0, 10.0, 10.0);
+    for (int i = 0; i < 200; i++) {
+        triangulation.insertVertex(coordinate(random), coordinate(random));
+    }
+
+    auto mesh = triangulation.toIndexedMesh();
+
+    double totalArea = 0.0;
+    bool allCounterClockwise = true;
+    bool allCircumcirclesEmpty = true;
+    for (auto& corners : mesh.triangles) {
+        totalArea += signedArea(mesh, corners);
+        allCounterClockwise &= signedArea(mesh, corners) > 0.0;
+        for (long vertex = 0; vertex < mesh.xs.size(); vertex++) {
+            allCircumcirclesEmpty &= !isInCircumcircle(mesh, corners, mesh.xs[vertex], mesh.ys[vertex]);
+        }
+    }
+    CHECK(mesh.triangles.size() == 2 * 204 - 4 - 2);
+    CHECK(totalArea == Approx(100.0));
+    CHECK(allCounterClockwise);
+    CHECK(allCircumcirclesEmpty);
+}
+
+static bool hasEdge(IndexedMesh& mesh, double fromX, double fromY, double toX, double toY)
+{
+    for (auto& corners : mesh.triangles) {
+        for (int edge = 0; edge < 3; edge++) {
+            auto from = corners[edge];
+            auto to = corners[(edge + 1) % 3];
+            if ((mesh.xs[from] == fromX) && (mesh.ys[from] == fromY) && (mesh.xs[to] == toX) && (mesh.ys[to] == toY)) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+TEST_CASE("Delaunay triangulation should contain an inserted constraint crossing several triangles")
+{
+    std::mt19937 random(5);
+    std::uniform_real_distribution<double> coordinate(0.0, 10.0);
+    DelaunayTriangulation triangulation(0.0, 0.0, 10.0, 10.0);
+    auto from = triangulation.insertVertex(0.5, 0.7);
+    auto to = triangulation.insertVertex(9.3, 9.6);
+    for (int i = 0; i < 200; i++) {
+        triangulation.insertVertex(coordinate(random), coordinate(random));
+    }
+
+    triangulation.insertConstraint(from, to);
+    auto mesh = triangulation.toIndexedMesh();
+
+    double totalArea = 0.0;
+    bool allCounterClockwise = true;
+    for (auto& corners : mesh.triangles) {
+        totalArea += signedArea(mesh, corners);
+        allCounterClockwise &= signedArea(mesh, corners) > 0.0;
+    }
+    CHECK((hasEdge(mesh, 0.5, 0.7, 9.3, 9.6) && hasEdge(mesh, 9.3, 9.6, 0.5, 0.7)));
+    CHECK(totalArea == Approx(100.0));
+    CHECK(allCounterClockwise);
+}
+
+TEST_CASE("Delaunay triangulation should keep a constraint when later points would flip it")
+{
+    DelaunayTriangulation triangulation(0.0, 0.0, 10.0, 10.0);
+    auto from = triangulation.insertVertex(1.0, 5.0);
+    auto to = triangulation.insertVertex(9.0, 5.0);
+    triangulation.insertConstraint(from, to);
+
+    triangulation.insertVertex(5.0, 5.5);
+    triangulation.insertVertex(5.0, 4.5);
+    auto mesh = triangulation.toIndexedMesh();
+
+    CHECK((hasEdge(mesh, 1.0, 5.0, 9.0, 5.0) && hasEdge(mesh, 9.0, 5.0, 1.0, 5.0)));
+}
+
+TEST_CASE("Delaunay triangulation should keep the faces enclosed by a ring of constraints")
+{
+    DelaunayTriangulation triangulation(0.0, 0.0, 10.0, 10.0);
+    auto a = triangulation.insertVertex(2.0, 2.0);
+    auto b = triangulation.insertVertex(8.0, 2.0);
+    auto c = triangulation.insertVertex(8.0, 8.0);
+    auto d = triangulation.insertVertex(2.0, 8.0);
+    triangulation.insertConstraint(a, b);
+    triangulation.insertConstraint(b, c);
+    triangulation.insertConstraint(c, d);
+    triangulation.insertConstraint(d, a);
+
+    auto mesh = triangulation.toIndexedMeshOfEnclosedFaces();
+
+    double totalArea = 0.0;
+    for (auto& corners : mesh.triangles) {
+        totalArea += signedArea(mesh, corners);
+    }
+    CHECK(mesh.triangles.size() == 2);
+    CHECK(totalArea == Approx(36.0));
+    CHECK(mesh.xs.size() == 4);
+    CHECK(mesh.neighbours.size() == 2);
+}
+
+TEST_CASE("Delaunay triangulation should not accept a constraint crossing an earlier one")
+{
+    DelaunayTriangulation triangulation(0.0, 0.0, 10.0, 10.0);
+    auto a = triangulation.insertVertex(2.0, 5.0);
+    auto b = triangulation.insertVertex(8.0, 5.0);
+    auto c = triangulation.insertVertex(5.0, 2.0);
+    auto d = triangulation.insertVertex(5.0, 8.0);
+    triangulation.insertConstraint(a, b);
+
+    CHECK_THROWS_WITH(triangulation.insertConstraint(c, d), Catch::Contains("cross"));
+    CHECK(triangulation.containsEdge(a, b));
+}
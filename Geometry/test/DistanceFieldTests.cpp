@@ -0,0 +1,147 @@
+/**
+ * Copyright 2019 Márton Gergó
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "catch.hpp"
+#include "DistanceField.h"
+#include "MeshGenerator.h"
+#include "TriangleSearch.h"
+#include "Vector.h"
+
+using namespace TpaStarCpp::GeometryLibrary;
+
+TEST_CASE("Distance field should hold the costs of the shortest paths to the source")
+{
+    auto graph = std::make_shared<TriangleGraph>(MeshGenerator(3).gridWithHoles(20, 20, 0.25));
+    TriangleSearch search(graph);
+    auto source = graph->metadataOf(0).centroid();
+
+    DistanceField field(graph, source);
+
+    for (long id = 0; id < graph->triangleCount(); id += 7) {
+        auto result = search.findPath(graph->metadataOf(id).centroid(), source);
+        REQUIRE(field.isReached(id) == result.isFound);
+        if (result.isFound) {
+            CHECK(field.distanceOf(id) == Approx(result.cost));
+        }
+    }
+}
+
+TEST_CASE("Distance field should lead back to the triangle of the source through neighbours")
+{
+    auto graph = std::make_shared<TriangleGraph>(MeshGenerator(4).corridorMaze(6, 6));
+    DistanceField field(graph, graph->metadataOf(10).centroid());
+
+    auto path = field.pathFrom(graph->triangleCount() - 1);
+
+    REQUIRE_FALSE(path.empty());
+    CHECK(path.front() == graph->triangleCount() - 1);
+    CHECK(path.back() == 10);
+    CHECK(field.parentIdOf(10) == -1);
+    for (long i = 1; i < path.size(); i++) {
+        auto& neighbours = graph->neighbourIdsOf(path[i - 1]);
+        CHECK(std::find(begin(neighbours), end(neighbours), path[i]) != end(neighbours));
+        CHECK(field.distanceOf(path[i]) < field.distanceOf(path[i - 1]));
+    }
+}
+
+TEST_CASE("Distance field should leave the triangles beyond the radius unreached")
+{
+    auto graph = std::make_shared<TriangleGraph>(MeshGenerator(1).gridWithHoles(20, 20, 0.0));
+    Vector source(10.5, 10.5);
+
+    DistanceField field(graph, source, 3.0);
+
+    for (long id = 0; id < graph->triangleCount(); id++) {
+        auto straightLine = source.distanceFrom(graph->metadataOf(id).centroid());
+        if (straightLine > 3.0) {
+            CHECK_FALSE(field.isReached(id));
+        }
+        if (field.isReached(id)) {
+            CHECK(field.distanceOf(id) <= 3.0);
+        }
+    }
+    CHECK(field.isReached(graph->findIdOfTriangleUnder(Vector(11.5, 10.5))));
+    CHECK(field.pathFrom(0).empty());
+}
+
+TEST_CASE("Distance field should not enter blocked triangles")
+{
+    auto graph = std::make_shared<TriangleGraph>(MeshGenerator(1).gridWithHoles(10, 10, 0.0));
+    for (int y = 0; y < 10; y++) {
+        graph->setBlocked(graph->findIdOfTriangleUnder(Vector(5.2, y + 0.5)), true);
+        graph->setBlocked(graph->findIdOfTriangleUnder(Vector(5.8, y + 0.5)), true);
+    }
+
+    DistanceField field(graph, Vector(0.5, 0.5));
+
+    CHECK(field.isReached(graph->findIdOfTriangleUnder(Vector(4.5, 9.5))));
+    CHECK_FALSE(field.isReached(graph->findIdOfTriangleUnder(Vector(5.2, 0.5))));
+    CHECK_FALSE(field.isReached(graph->findIdOfTriangleUnder(Vector(9.5, 0.5))));
+}
+
+TEST_CASE("Distance fields of several sources should match the fields measured one by one")
+{
+    auto graph = std::make_shared<TriangleGraph>(MeshGenerator(2).randomDelaunay(15, 15));
+    std::vector<Vector> sources { Vector(1.0, 1.0), Vector(7.5, 7.5), Vector(14.0, 2.0) };
+
+    auto fields = DistanceField::measureFrom(graph, sources, 8.0);
+
+    REQUIRE(fields.size() == 3);
+    for (int i = 0; i < 3; i++) {
+        DistanceField expected(graph, sources[i], 8.0);
+        CHECK(fields[i].sourceId() == expected.sourceId());
+        for (long id = 0; id < graph->triangleCount(); id++) {
+            CHECK(fields[i].distanceOf(id) == expected.distanceOf(id));
+        }
+    }
+}
+
+TEST_CASE("Distance field should throw if the source is not on the mesh")
+{
+    auto graph = std::make_shared<TriangleGraph>(MeshGenerator(1).gridWithHoles(4, 4, 0.0));
+
+    CHECK_THROWS_AS(DistanceField(graph, Vector(-1.0, 1.0)), std::invalid_argument);
+    CHECK_THROWS_AS(DistanceField::measureFrom(graph, { Vector(1.0, 1.0), Vector(9.0, 1.0) }), std::invalid_argument);
+}
+
+TEST_CASE("Distance field should lead to the source through off-mesh links in their direction only")
+{
+    auto graph = std::make_shared<TriangleGraph>(MeshGenerator(1).gridWithHoles(10, 10, 0.0));
+    for (int y = 0; y < 10; y++) {
+        graph->setBlocked(graph->findIdOfTriangleUnder(Vector(5.2, y + 0.5)), true);
+        graph->setBlocked(graph->findIdOfTriangleUnder(Vector(5.8, y + 0.5)), true);
+    }
+    graph->addOffMeshLink(Vector(4.5, 8.5), Vector(6.5, 8.5), 1.0);
+    auto leftId = graph->findIdOfTriangleUnder(Vector(0.5, 0.5));
+    auto rightId = graph->findIdOfTriangleUnder(Vector(9.5, 0.5));
+    TriangleSearch search(graph);
+
+    DistanceField towardsRight(graph, Vector(9.5, 0.5));
+    DistanceField towardsLeft(graph, Vector(0.5, 0.5));
+
+    REQUIRE(towardsRight.isReached(leftId));
+    CHECK_FALSE(towardsLeft.isReached(rightId));
+    auto path = towardsRight.pathFrom(leftId);
+    bool allSteps = true;
+    for (size_t i = 0; i + 1 < path.size(); i++) {
+        bool isStep = false;
+        graph->forEachStepFrom(path[i], [&](long neighbour, double) { isStep |= neighbour == path[i + 1]; });
+        allSteps &= isStep;
+    }
+    CHECK(allSteps);
+    CHECK(path.back() == rightId);
+    CHECK(towardsRight.distanceOf(leftId) == Approx(search.findPath(graph->metadataOf(leftId).centroid(), Vector(9.5, 0.5)).cost));
+}
@@ -0,0 +1,112 @@
+/**
+ * Copyright 2019 Márton Gergó
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "catch.hpp"
+#include "DistanceMatrix.h"
+#include "MeshGenerator.h"
+#include "TriangleSearch.h"
+#include "Vector.h"
+
+using namespace TpaStarCpp::GeometryLibrary;
+
+TEST_CASE("Distance matrix should hold the costs found by point to point searches")
+{
+    auto graph = std::make_shared<TriangleGraph>(MeshGenerator(3).gridWithHoles(20, 20, 0.25));
+    TriangleSearch search(graph);
+    std::vector<Vector> waypoints;
+    for (long id = 0; id < graph->triangleCount(); id += 41) {
+        waypoints.push_back(graph->metadataOf(id).centroid());
+    }
+    waypoints.push_back(Vector(waypoints[0].x() + 0.05, waypoints[0].y()));
+
+    DistanceMatrix matrix(graph, waypoints);
+
+    REQUIRE(matrix.size() == waypoints.size());
+    REQUIRE(matrix.costs().size() == waypoints.size() * waypoints.size());
+    for (long i = 0; i < matrix.size(); i++) {
+        CHECK(matrix.costBetween(i, i) == 0.0);
+        for (long j = 0; j < matrix.size(); j++) {
+            if (i == j) {
+                continue;
+            }
+            auto result = search.findPath(waypoints[i], waypoints[j]);
+            if (result.isFound) {
+                CHECK(matrix.costBetween(i, j) == Approx(result.cost));
+            } else {
+                CHECK(matrix.costBetween(i, j) == std::numeric_limits<double>::infinity());
+            }
+        }
+    }
+}
+
+TEST_CASE("Distance matrix should leave waypoints behind a wall unreachable")
+{
+    auto graph = std::make_shared<TriangleGraph>(MeshGenerator(1).gridWithHoles(10, 10, 0.0));
+    for (int y = 0; y < 10; y++) {
+        graph->setBlocked(graph->findIdOfTriangleUnder(Vector(5.2, y + 0.5)), true);
+        graph->setBlocked(graph->findIdOfTriangleUnder(Vector(5.8, y + 0.5)), true);
+    }
+
+    DistanceMatrix matrix(graph, { Vector(0.5, 0.5), Vector(9.5, 9.5), Vector(4.5, 9.5), Vector(5.2, 3.5) });
+
+    CHECK(matrix.costBetween(0, 1) == std::numeric_limits<double>::infinity());
+    CHECK(matrix.costBetween(1, 2) == std::numeric_limits<double>::infinity());
+    CHECK(matrix.costBetween(0, 2) < 15.0);
+    CHECK(matrix.costBetween(3, 0) == std::numeric_limits<double>::infinity());
+    CHECK(matrix.corridorBetween(0, 1).empty());
+}
+
+TEST_CASE("Distance matrix should keep the costs of a one way link in its direction only")
+{
+    auto graph = std::make_shared<TriangleGraph>(MeshGenerator(1).gridWithHoles(10, 10, 0.0));
+    for (int y = 0; y < 10; y++) {
+        graph->setBlocked(graph->findIdOfTriangleUnder(Vector(5.2, y + 0.5)), true);
+        graph->setBlocked(graph->findIdOfTriangleUnder(Vector(5.8, y + 0.5)), true);
+    }
+    graph->addOffMeshLink(Vector(2.5, 5.5), Vector(8.5, 5.5), 6.0);
+    TriangleSearch search(graph);
+    std::vector<Vector> waypoints { Vector(0.5, 0.5), Vector(9.5, 9.5), Vector(1.5, 8.5) };
+
+    DistanceMatrix matrix(graph, waypoints);
+
+    CHECK(matrix.costBetween(0, 1) == Approx(search.findPath(waypoints[0], waypoints[1]).cost));
+    CHECK(matrix.costBetween(1, 0) == std::numeric_limits<double>::infinity());
+    CHECK(matrix.costBetween(2, 1) == Approx(search.findPath(waypoints[2], waypoints[1]).cost));
+    CHECK(matrix.costBetween(1, 2) == std::numeric_limits<double>::infinity());
+    CHECK(matrix.costBetween(0, 2) == Approx(matrix.costBetween(2, 0)));
+    CHECK(matrix.corridorBetween(1, 0).empty());
+}
+
+TEST_CASE("Distance matrix should search the corridor between two waypoints on demand")
+{
+    auto graph = std::make_shared<TriangleGraph>(MeshGenerator(4).corridorMaze(6, 6));
+    auto first = graph->metadataOf(0).centroid();
+    auto last = graph->metadataOf(graph->triangleCount() - 1).centroid();
+    DistanceMatrix matrix(graph, { first, last });
+
+    auto corridor = matrix.corridorBetween(1, 0);
+
+    REQUIRE_FALSE(corridor.empty());
+    CHECK(corridor.front() == graph->triangleCount() - 1);
+    CHECK(corridor.back() == 0);
+}
+
+TEST_CASE("Distance matrix should throw if a waypoint is not on the mesh")
+{
+    auto graph = std::make_shared<TriangleGraph>(MeshGenerator(1).gridWithHoles(4, 4, 0.0));
+
+    CHECK_THROWS_AS(DistanceMatrix(graph, { Vector(1.0, 1.0), Vector(-1.0, 1.0) }), std::invalid_argument);
+}
@@ -182,3 +182,23 @@ TEST_CASE("Distorted edge should not be created")
 
     CHECK_THROWS_WITH(Edge(a, b), Catch::Contains("equal"));
 }
+
+TEST_CASE("Closest point of an edge should be the projection of a point falling between its endpoints")
+{
+    Edge edge(Vector(1.0, 1.0), Vector(3.0, 3.0));
+
+    auto closest = edge.closestPointTo(Vector(1.0, 3.0));
+
+    CHECK(closest.x() == Approx(2.0));
+    CHECK(closest.y() == Approx(2.0));
+}
+
+TEST_CASE("Closest point of an edge should be its endpoint for a point beyond that endpoint")
+{
+    Edge edge(Vector(2.0, 1.0), Vector(4.0, 1.0));
+
+    auto closest = edge.closestPointTo(Vector(6.0, 2.0));
+
+    CHECK(closest.x() == Approx(4.0));
+    CHECK(closest.y() == Approx(1.0));
+}
@@ -0,0 +1,127 @@
+/**
+ * Copyright 2019 Márton Gergó
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "catch.hpp"
+#include "Funnel.h"
+#include "MeshGenerator.h"
+#include "TriangleSearch.h"
+#include "Vector.h"
+
+using namespace TpaStarCpp::GeometryLibrary;
+
+static double lengthOf(std::vector<Vector>& points)
+{
+    double length = 0.0;
+    for (long i = 1; i < points.size(); i++) {
+        length += points[i].distanceFrom(points[i - 1]);
+    }
+    return length;
+}
+
+TEST_CASE("Funnel should return a straight line through an open corridor")
+{
+    auto graph = std::make_shared<TriangleGraph>(MeshGenerator(1).gridWithHoles(10, 10, 0.0));
+    TriangleSearch search(graph);
+    Funnel funnel(graph);
+    Vector start(0.2, 0.5);
+    Vector goal(9.8, 0.5);
+
+    auto corridor = search.findPath(start, goal).triangleIds;
+    auto points = funnel.pullString(corridor, start, goal);
+
+    REQUIRE(points.size() == 2);
+    CHECK(points.front().x() == Approx(0.2));
+    CHECK(points.back().x() == Approx(9.8));
+}
+
+TEST_CASE("Funnel should bend around the end of a wall")
+{
+    auto graph = std::make_shared<TriangleGraph>(MeshGenerator(1).gridWithHoles(10, 10, 0.0));
+    for (int y = 0; y < 9; y++) {
+        graph->setBlocked(graph->findIdOfTriangleUnder(Vector(5.2, y + 0.5)), true);
+        graph->setBlocked(graph->findIdOfTriangleUnder(Vector(5.8, y + 0.5)), true);
+    }
+    TriangleSearch search(graph);
+    Funnel funnel(graph);
+    Vector start(0.5, 0.5);
+    Vector goal(9.5, 0.5);
+
+    auto result = search.findPath(start, goal);
+    auto points = funnel.pullString(result.triangleIds, start, goal);
+
+    auto isCorner = [&](double x, double y) {
+        return std::any_of(begin(points), end(points), [&](Vector point) {
+            return (point.x() == Approx(x)) && (point.y() == Approx(y));
+        });
+    };
+    CHECK(isCorner(5.0, 9.0));
+    CHECK(isCorner(6.0, 9.0));
+    CHECK(lengthOf(points) >= 2.0 * std::hypot(4.5, 8.5) + 1.0 - 1e-9);
+    CHECK(lengthOf(points) <= result.cost);
+}
+
+TEST_CASE("Funnel should not be longer than the path through the edge midpoints")
+{
+    auto graph = std::make_shared<TriangleGraph>(MeshGenerator(4).corridorMaze(8, 8));
+    TriangleSearch search(graph);
+    Funnel funnel(graph);
+
+    for (long goalId = 3; goalId < graph->triangleCount(); goalId += 37) {
+        auto start = graph->metadataOf(0).centroid();
+        auto goal = graph->metadataOf(goalId).centroid();
+        auto result = search.findPath(start, goal);
+        REQUIRE(result.isFound);
+
+        auto points = funnel.pullString(result.triangleIds, start, goal);
+
+        CHECK(lengthOf(points) <= result.cost + 1e-9);
+        CHECK(lengthOf(points) >= start.distanceFrom(goal) - 1e-9);
+    }
+}
+
+TEST_CASE("Funnel should throw if the corridor is not connected")
+{
+    auto graph = std::make_shared<TriangleGraph>(MeshGenerator(1).gridWithHoles(4, 4, 0.0));
+    Funnel funnel(graph);
+    auto first = graph->findIdOfTriangleUnder(Vector(0.5, 0.2));
+    auto last = graph->findIdOfTriangleUnder(Vector(3.5, 3.8));
+
+    CHECK_THROWS_AS(funnel.pullString({ first, last }, Vector(0.5, 0.2), Vector(3.5, 3.8)), std::invalid_argument);
+}
+
+TEST_CASE("Funnel should pass through the entry and the exit of an off-mesh link")
+{
+    auto graph = std::make_shared<TriangleGraph>(MeshGenerator(1).gridWithHoles(10, 10, 0.0));
+    for (int y = 0; y < 10; y++) {
+        graph->setBlocked(graph->findIdOfTriangleUnder(Vector(5.2, y + 0.5)), true);
+        graph->setBlocked(graph->findIdOfTriangleUnder(Vector(5.8, y + 0.5)), true);
+    }
+    graph->addOffMeshLink(Vector(4.5, 8.5), Vector(6.5, 8.5), 1.0);
+    TriangleSearch search(graph);
+    Funnel funnel(graph);
+    Vector start(0.5, 0.5);
+    Vector goal(9.5, 0.5);
+
+    auto corridor = search.findPath(start, goal).triangleIds;
+    auto points = funnel.pullString(corridor, start, goal);
+
+    auto entry = std::find_if(begin(points), end(points), [](Vector point) { return point == Vector(4.5, 8.5); });
+    REQUIRE(entry != end(points));
+    REQUIRE(entry + 1 != end(points));
+    CHECK((entry + 1)->x() == Approx(6.5));
+    CHECK((entry + 1)->y() == Approx(8.5));
+    CHECK(points.back().x() == Approx(9.5));
+}
@@ -0,0 +1,128 @@
+/**
+ * Copyright 2019 Márton Gergó
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "catch.hpp"
+#include "HierarchicalGraph.h"
+#include "MeshGenerator.h"
+#include "TriangleSearch.h"
+#include "Vector.h"
+
+using namespace TpaStarCpp::GeometryLibrary;
+
+TEST_CASE("Hierarchical graph should split the mesh into clusters of about the specified size")
+{
+    auto graph = std::make_shared<TriangleGraph>(MeshGenerator(1).gridWithHoles(32, 32, 0.0));
+
+    HierarchicalGraph hierarchy(graph, 128);
+
+    CHECK(hierarchy.clusterCount() == 16);
+    CHECK(hierarchy.nodeCount() > 0);
+}
+
+TEST_CASE("Hierarchical graph should find paths close to the shortest one while expanding fewer nodes")
+{
+    auto graph = std::make_shared<TriangleGraph>(MeshGenerator(4).gridWithHoles(60, 60, 0.25));
+    HierarchicalGraph hierarchy(graph, 128);
+    TriangleSearch search(graph);
+    auto start = graph->metadataOf(0).centroid();
+    auto goal = graph->metadataOf(graph->triangleCount() - 1).centroid();
+
+    auto shortest = search.findPath(start, goal);
+    auto hierarchical = hierarchy.findPath(start, goal);
+
+    REQUIRE(hierarchical.isFound == shortest.isFound);
+    if (shortest.isFound) {
+        CHECK(hierarchical.cost >= shortest.cost - 1e-9);
+        CHECK(hierarchical.cost < 1.15 * shortest.cost);
+        CHECK(hierarchical.triangleIds.front() == shortest.triangleIds.front());
+        CHECK(hierarchical.triangleIds.back() == shortest.triangleIds.back());
+    }
+}
+
+TEST_CASE("Hierarchical graph should avoid triangles blocked after construction once refreshed")
+{
+    auto graph = std::make_shared<TriangleGraph>(MeshGenerator(1).gridWithHoles(40, 40, 0.0));
+    HierarchicalGraph hierarchy(graph, 64);
+    std::vector<long> blocked;
+    for (int y = 0; y < 39; y++) {
+        blocked.push_back(graph->findIdOfTriangleUnder(Vector(20.2, y + 0.5)));
+        blocked.push_back(graph->findIdOfTriangleUnder(Vector(20.8, y + 0.5)));
+    }
+    for (auto id : blocked) {
+        graph->setBlocked(id, true);
+    }
+
+    hierarchy.refresh(blocked);
+    auto result = hierarchy.findPath(Vector(0.5, 0.5), Vector(39.5, 0.5));
+
+    REQUIRE(result.isFound);
+    bool avoidsBlocked = true;
+    for (auto id : result.triangleIds) {
+        avoidsBlocked &= !graph->isBlocked(id);
+    }
+    CHECK(avoidsBlocked);
+    CHECK(result.cost > 39.0 + 2 * 38.0);
+}
+
+TEST_CASE("Hierarchical graph should report goals that cannot be reached as not found")
+{
+    auto graph = std::make_shared<TriangleGraph>(MeshGenerator(1).gridWithHoles(40, 2, 0.0));
+    HierarchicalGraph hierarchy(graph, 16);
+    std::vector<long> blocked;
+    for (int y = 0; y < 2; y++) {
+        blocked.push_back(graph->findIdOfTriangleUnder(Vector(20.2, y + 0.5)));
+        blocked.push_back(graph->findIdOfTriangleUnder(Vector(20.8, y + 0.5)));
+    }
+    for (auto id : blocked) {
+        graph->setBlocked(id, true);
+    }
+    hierarchy.refresh(blocked);
+
+    auto result = hierarchy.findPath(Vector(0.5, 0.5), Vector(39.5, 0.5));
+
+    CHECK_FALSE(result.isFound);
+}
+
+TEST_CASE("Hierarchical graph should find paths between meshes joined by an off-mesh link only")
+{
+    auto mesh = MeshGenerator(1).gridWithHoles(10, 10, 0.0);
+    long vertexCount = mesh.xs.size();
+    long triangleCount = mesh.triangles.size();
+    for (long i = 0; i < vertexCount; i++) {
+        mesh.xs.push_back(mesh.xs[i] + 20.0);
+        mesh.ys.push_back(mesh.ys[i]);
+    }
+    // a copy of the grid to the right, the neighbours are found from the shared corners
+    mesh.neighbours.clear();
+    for (long i = 0; i < triangleCount; i++) {
+        auto triangle = mesh.triangles[i];
+        for (auto& corner : triangle) {
+            corner += vertexCount;
+        }
+        mesh.triangles.push_back(triangle);
+    }
+    auto graph = std::make_shared<TriangleGraph>(mesh);
+    graph->addOffMeshLink(Vector(9.5, 5.5), Vector(20.5, 5.5), 1.0);
+    HierarchicalGraph hierarchy(graph, 32);
+    TriangleSearch search(graph);
+
+    auto result = hierarchy.findPath(Vector(0.5, 0.5), Vector(29.5, 9.5));
+    auto back = hierarchy.findPath(Vector(29.5, 9.5), Vector(0.5, 0.5));
+
+    REQUIRE(result.isFound);
+    CHECK(result.cost >= search.findPath(Vector(0.5, 0.5), Vector(29.5, 9.5)).cost - 1e-9);
+    CHECK_FALSE(back.isFound);
+}
@@ -0,0 +1,61 @@
+/**
+ * Copyright 2019 Márton Gergó
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "catch.hpp"
+#include "HilbertCurve.h"
+
+using namespace TpaStarCpp::GeometryLibrary;
+
+TEST_CASE("Hilbert curve should start at the origin")
+{
+    CHECK(HilbertCurve::indexOf(0, 0) == 0);
+}
+
+TEST_CASE("Hilbert curve should visit consecutive indices at neighbouring cells")
+{
+    uint32_t lastX = 0;
+    uint32_t lastY = 0;
+    std::vector<std::pair<uint32_t, uint32_t>> cells(64 * 64);
+    for (uint32_t x = 0; x < 64; x++) {
+        for (uint32_t y = 0; y < 64; y++) {
+            // the lower left 64x64 block of the curve is a complete curve on its own
+            cells[HilbertCurve::indexOf(x, y)] = { x, y };
+        }
+    }
+
+    bool allStepsAreUnit = true;
+    for (auto cell : cells) {
+        auto distance = std::abs(static_cast<long>(cell.first) - static_cast<long>(lastX)) +
+                        std::abs(static_cast<long>(cell.second) - static_cast<long>(lastY));
+        allStepsAreUnit &= (distance <= 1);
+        lastX = cell.first;
+        lastY = cell.second;
+    }
+
+    CHECK(allStepsAreUnit);
+}
+
+TEST_CASE("Hilbert order should keep the points of a quadrant together")
+{
+    std::vector<double> xs { 0.0, 10.0, 0.5, 10.0, 0.0, 9.5 };
+    std::vector<double> ys { 0.0, 10.0, 0.5, 9.5, 0.5, 10.0 };
+
+    auto order = HilbertCurve::sortedOrder(xs, ys);
+
+    auto lowerLeftPoints = std::count_if(begin(order), begin(order) + 3, [&](long i) { return xs[i] < 5.0; });
+    CHECK(order.size() == 6);
+    CHECK((lowerLeftPoints == 3 || lowerLeftPoints == 0));
+}
@@ -0,0 +1,179 @@
+/**
+ * Copyright 2019 Márton Gergó
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "catch.hpp"
+#include "IncrementalSearch.h"
+#include "MeshGenerator.h"
+#include "TriangleSearch.h"
+#include "Vector.h"
+
+using namespace TpaStarCpp::GeometryLibrary;
+
+TEST_CASE("Incremental search should find the shortest paths of a full search")
+{
+    auto graph = std::make_shared<TriangleGraph>(MeshGenerator(3).gridWithHoles(20, 20, 0.25));
+    TriangleSearch search(graph);
+    IncrementalSearch incremental(graph);
+
+    for (long goalId = 3; goalId < graph->triangleCount(); goalId += 59) {
+        auto start = graph->metadataOf(0).centroid();
+        auto goal = graph->metadataOf(goalId).centroid();
+        auto expected = search.findPath(start, goal);
+
+        auto result = incremental.findPath(start, goal);
+
+        REQUIRE(result.isFound == expected.isFound);
+        if (result.isFound) {
+            CHECK(result.cost == Approx(expected.cost));
+            CHECK(result.triangleIds.front() == 0);
+            CHECK(result.triangleIds.back() == goalId);
+        }
+    }
+}
+
+TEST_CASE("Incremental search should repair the path after triangles on it are blocked and unblocked")
+{
+    auto graph = std::make_shared<TriangleGraph>(MeshGenerator(2).randomDelaunay(30, 30));
+    TriangleSearch search(graph);
+    IncrementalSearch incremental(graph);
+    Vector start(1.0, 1.0);
+    Vector goal(29.0, 28.0);
+    auto first = incremental.findPath(start, goal);
+    REQUIRE(first.isFound);
+
+    std::vector<long> changedIds;
+    for (long i = first.triangleIds.size() / 3; i < 2 * first.triangleIds.size() / 3; i += 2) {
+        graph->setBlocked(first.triangleIds[i], true);
+        changedIds.push_back(first.triangleIds[i]);
+    }
+    auto detour = incremental.replan(changedIds);
+
+    REQUIRE(detour.isFound);
+    CHECK(detour.cost == Approx(search.findPath(start, goal).cost));
+    CHECK(detour.cost > first.cost);
+    CHECK(detour.expandedCount < first.expandedCount);
+    for (auto id : detour.triangleIds) {
+        CHECK_FALSE(graph->isBlocked(id));
+    }
+
+    for (auto id : changedIds) {
+        graph->setBlocked(id, false);
+    }
+    auto restored = incremental.replan(changedIds);
+
+    CHECK(restored.cost == Approx(first.cost));
+}
+
+TEST_CASE("Incremental search should search again after a triangle got cheaper than any before")
+{
+    auto graph = std::make_shared<TriangleGraph>(MeshGenerator(2).randomDelaunay(30, 30));
+    TriangleSearch search(graph);
+    IncrementalSearch incremental(graph);
+    Vector start(1.0, 1.0);
+    Vector goal(29.0, 28.0);
+    auto first = incremental.findPath(start, goal);
+    REQUIRE(first.isFound);
+
+    std::vector<long> changedIds;
+    for (long id = 0; id < graph->triangleCount(); id++) {
+        if (graph->metadataOf(id).centroidX < 15.0) {
+            graph->setCostMultiplier(id, 0.1);
+            changedIds.push_back(id);
+        }
+    }
+    auto cheaper = incremental.replan(changedIds);
+
+    REQUIRE(cheaper.isFound);
+    CHECK(cheaper.cost < first.cost);
+    CHECK(cheaper.cost == Approx(search.findPath(start, goal).cost));
+}
+
+TEST_CASE("Incremental search should follow the agent moving along the path")
+{
+    auto graph = std::make_shared<TriangleGraph>(MeshGenerator(4).corridorMaze(10, 10));
+    TriangleSearch search(graph);
+    IncrementalSearch incremental(graph);
+    auto goal = graph->metadataOf(graph->triangleCount() - 1).centroid();
+    auto first = incremental.findPath(graph->metadataOf(0).centroid(), goal);
+    REQUIRE(first.isFound);
+
+    auto position = graph->metadataOf(first.triangleIds[first.triangleIds.size() / 2]).centroid();
+    auto moved = incremental.moveStart(position);
+    auto blockedId = moved.triangleIds[moved.triangleIds.size() / 2];
+    graph->setBlocked(blockedId, true);
+    auto replanned = incremental.replan({ blockedId });
+
+    CHECK(moved.cost == Approx(search.findPath(position, goal).cost));
+    CHECK(moved.cost < first.cost);
+    auto expected = search.findPath(position, goal);
+    REQUIRE(replanned.isFound == expected.isFound);
+    if (expected.isFound) {
+        CHECK(replanned.cost == Approx(expected.cost));
+    }
+}
+
+TEST_CASE("Incremental search should repair paths over off-mesh links")
+{
+    auto graph = std::make_shared<TriangleGraph>(MeshGenerator(1).gridWithHoles(10, 10, 0.0));
+    for (int y = 0; y < 10; y++) {
+        graph->setBlocked(graph->findIdOfTriangleUnder(Vector(5.2, y + 0.5)), true);
+        graph->setBlocked(graph->findIdOfTriangleUnder(Vector(5.8, y + 0.5)), true);
+    }
+    graph->addOffMeshLink(Vector(4.5, 8.5), Vector(6.5, 8.5), 1.0);
+    TriangleSearch search(graph);
+    IncrementalSearch incremental(graph);
+    Vector start(0.5, 0.5);
+    Vector goal(9.5, 0.5);
+
+    auto first = incremental.findPath(start, goal);
+    auto entryId = graph->findIdOfTriangleUnder(Vector(4.5, 8.5));
+    graph->setBlocked(entryId, true);
+    auto blocked = incremental.replan({ entryId });
+    graph->setBlocked(entryId, false);
+    auto repaired = incremental.replan({ entryId });
+
+    REQUIRE(first.isFound);
+    CHECK(first.cost == Approx(search.findPath(start, goal).cost));
+    CHECK_FALSE(blocked.isFound);
+    REQUIRE(repaired.isFound);
+    CHECK(repaired.cost == Approx(first.cost));
+}
+
+TEST_CASE("Incremental search should report a goal cut off by blocked triangles")
+{
+    auto graph = std::make_shared<TriangleGraph>(MeshGenerator(1).gridWithHoles(10, 10, 0.0));
+    IncrementalSearch incremental(graph);
+    REQUIRE(incremental.findPath(Vector(0.5, 0.5), Vector(9.5, 0.5)).isFound);
+    std::vector<long> wallIds;
+    for (int y = 0; y < 10; y++) {
+        wallIds.push_back(graph->findIdOfTriangleUnder(Vector(5.2, y + 0.5)));
+        wallIds.push_back(graph->findIdOfTriangleUnder(Vector(5.8, y + 0.5)));
+    }
+    for (auto id : wallIds) {
+        graph->setBlocked(id, true);
+    }
+
+    CHECK_FALSE(incremental.replan(wallIds).isFound);
+}
+
+TEST_CASE("Incremental search should throw when continuing without a search")
+{
+    auto graph = std::make_shared<TriangleGraph>(MeshGenerator(1).gridWithHoles(4, 4, 0.0));
+    IncrementalSearch incremental(graph);
+
+    CHECK_THROWS_AS(incremental.moveStart(Vector(1.0, 1.0)), std::invalid_argument);
+    CHECK_THROWS_AS(incremental.findPath(Vector(1.0, 1.0), Vector(9.0, 1.0)), std::invalid_argument);
+}
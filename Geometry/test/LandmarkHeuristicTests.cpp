@@ -0,0 +1,136 @@
+/**
+ * Copyright 2019 Márton Gergó
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "catch.hpp"
+#include "LandmarkHeuristic.h"
+#include "MeshGenerator.h"
+#include "TriangleSearch.h"
+#include "Vector.h"
+#include <algorithm>
+#include <random>
+#include <sstream>
+
+using namespace TpaStarCpp::GeometryLibrary;
+
+// the search between two centroids has no start and goal costs, so it returns the distance the bound is compared to
+static double distanceBetween(std::shared_ptr<TriangleGraph> graph, TriangleSearch& search, long id, long goalId)
+{
+    auto start = graph->metadataOf(id).centroid();
+    auto goal = graph->metadataOf(goalId).centroid();
+    return search.findPath(id, start, goalId, goal, [](long) { return true; }).cost;
+}
+
+TEST_CASE("Landmark heuristic should pick distinct landmarks starting from the far end of the mesh")
+{
+    auto graph = std::make_shared<TriangleGraph>(MeshGenerator(1).gridWithHoles(30, 1, 0.0));
+
+    LandmarkHeuristic landmarks(graph, 4);
+
+    auto ids = landmarks.landmarkIds();
+    std::sort(begin(ids), end(ids));
+    CHECK(std::unique(begin(ids), end(ids)) == end(ids));
+    CHECK(landmarks.landmarkCount() == 4);
+    auto first = graph->metadataOf(landmarks.landmarkIds()[0]).centroidX;
+    auto second = graph->metadataOf(landmarks.landmarkIds()[1]).centroidX;
+    CHECK(std::min(first, second) < 1.0);
+    CHECK(std::max(first, second) > 29.0);
+}
+
+TEST_CASE("Landmark heuristic should never overestimate the distance of two triangles")
+{
+    auto graph = std::make_shared<TriangleGraph>(MeshGenerator(2).corridorMaze(10, 10));
+    LandmarkHeuristic landmarks(graph, 6);
+    TriangleSearch search(graph);
+    std::mt19937 random(3);
+    std::uniform_int_distribution<long> triangle(0, graph->triangleCount() - 1);
+
+    bool allAdmissible = true;
+    double estimatedSum = 0.0;
+    double distanceSum = 0.0;
+    for (int i = 0; i < 50; i++) {
+        auto id = triangle(random);
+        auto goalId = triangle(random);
+        auto distance = distanceBetween(graph, search, id, goalId);
+        auto estimate = landmarks.estimate(id, goalId);
+        allAdmissible &= estimate <= distance + 1e-9;
+        estimatedSum += estimate;
+        distanceSum += distance;
+    }
+    CHECK(allAdmissible);
+    CHECK(estimatedSum > 0.5 * distanceSum);
+}
+
+TEST_CASE("Triangle search with landmarks should find equally short paths expanding fewer triangles in a maze")
+{
+    auto graph = std::make_shared<TriangleGraph>(MeshGenerator(2).corridorMaze(20, 20));
+    LandmarkHeuristic landmarks(graph, 8);
+    TriangleSearch search(graph);
+    Vector start(1.5, 1.5);
+    Vector goal(39.5, 39.5);
+
+    auto plain = search.findPath(start, goal);
+    auto guided = search.findPath(start, goal, landmarks);
+
+    REQUIRE(plain.isFound);
+    REQUIRE(guided.isFound);
+    CHECK(guided.cost == Approx(plain.cost));
+    CHECK(guided.expandedCount < plain.expandedCount);
+}
+
+TEST_CASE("Landmark heuristic should give the same estimates after saving and loading it")
+{
+    auto graph = std::make_shared<TriangleGraph>(MeshGenerator(2).randomDelaunay(10, 10));
+    LandmarkHeuristic landmarks(graph, 3);
+    std::stringstream stream;
+
+    landmarks.save(stream);
+    auto loaded = LandmarkHeuristic::load(stream, graph);
+
+    bool allEqual = true;
+    for (long id = 0; id < graph->triangleCount(); id++) {
+        allEqual &= loaded.estimate(id, 0) == landmarks.estimate(id, 0);
+    }
+    CHECK(loaded.landmarkIds() == landmarks.landmarkIds());
+    CHECK(allEqual);
+}
+
+TEST_CASE("Landmark heuristic should not load data measured on a different graph")
+{
+    auto graph = std::make_shared<TriangleGraph>(MeshGenerator(2).randomDelaunay(10, 10));
+    auto otherGraph = std::make_shared<TriangleGraph>(MeshGenerator(2).randomDelaunay(12, 10));
+    std::stringstream stream;
+    LandmarkHeuristic(graph, 2).save(stream);
+
+    CHECK_THROWS_WITH(LandmarkHeuristic::load(stream, otherGraph), Catch::Contains("different graph"));
+}
+
+TEST_CASE("Landmark heuristic should not load a corrupt landmark count or landmark id")
+{
+    auto graph = std::make_shared<TriangleGraph>(MeshGenerator(2).randomDelaunay(10, 10));
+    std::stringstream stream;
+    LandmarkHeuristic(graph, 2).save(stream);
+    auto data = stream.str();
+    // the landmark count follows the magic, the version and the triangle count, the first landmark id follows it
+    auto corruptCount = data;
+    std::fill(corruptCount.begin() + 16, corruptCount.begin() + 20, '\xFF');
+    auto corruptId = data;
+    std::fill(corruptId.begin() + 20, corruptId.begin() + 28, '\xFF');
+
+    std::stringstream countStream(corruptCount);
+    std::stringstream idStream(corruptId);
+    CHECK_THROWS_WITH(LandmarkHeuristic::load(countStream, graph), Catch::Contains("malformed"));
+    CHECK_THROWS_WITH(LandmarkHeuristic::load(idStream, graph), Catch::Contains("malformed"));
+}
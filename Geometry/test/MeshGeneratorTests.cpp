@@ -0,0 +1,132 @@
+/**
+ * Copyright 2019 Márton Gergó
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "catch.hpp"
+#include "MeshGenerator.h"
+#include "TriangleGraph.h"
+
+using namespace TpaStarCpp::GeometryLibrary;
+
+static double totalArea(std::shared_ptr<TriangleGraph> graph)
+{
+    double area = 0.0;
+    for (long id = 0; id < graph->triangleCount(); id++) {
+        area += graph->metadataOf(id).area;
+    }
+    return area;
+}
+
+static long reachableTriangleCount(std::shared_ptr<TriangleGraph> graph)
+{
+    std::vector<bool> isReached(graph->triangleCount(), false);
+    std::vector<long> stack { 0 };
+    isReached[0] = true;
+    long count = 0;
+    while (!stack.empty()) {
+        auto id = stack.back();
+        stack.pop_back();
+        count++;
+        for (auto neighbour : graph->neighbourIdsOf(id)) {
+            if (!isReached[neighbour]) {
+                isReached[neighbour] = true;
+                stack.push_back(neighbour);
+            }
+        }
+    }
+    return count;
+}
+
+TEST_CASE("Generated grid without holes should cover its rectangle with two triangles per cell")
+{
+    MeshGenerator generator(1);
+
+    auto mesh = generator.gridWithHoles(8, 4, 0.0);
+    auto graph = std::make_shared<TriangleGraph>(mesh.toTriangleSkeletons());
+
+    CHECK(mesh.triangles.size() == 64);
+    CHECK(mesh.xs.size() == 45);
+    CHECK(totalArea(graph) == Approx(32.0));
+    CHECK(reachableTriangleCount(graph) == 64);
+}
+
+TEST_CASE("Generated grid with holes should leave out about the specified ratio of cells")
+{
+    MeshGenerator generator(1);
+
+    auto mesh = generator.gridWithHoles(100, 100, 0.2);
+
+    CHECK(mesh.triangles.size() > 2 * 7500);
+    CHECK(mesh.triangles.size() < 2 * 8500);
+}
+
+TEST_CASE("Generated meshes should be the same for the same seed")
+{
+    MeshGenerator first(5);
+    MeshGenerator second(5);
+
+    auto firstMesh = first.randomDelaunay(10, 10);
+    auto secondMesh = second.randomDelaunay(10, 10);
+
+    CHECK(firstMesh.xs == secondMesh.xs);
+    CHECK(firstMesh.ys == secondMesh.ys);
+    CHECK(firstMesh.triangles == secondMesh.triangles);
+}
+
+// the values were recorded once, mt19937_64 is specified by the standard, so they hold for every standard library
+TEST_CASE("Generated meshes should be the same for the same seed with any standard library")
+{
+    auto grid = MeshGenerator(7).gridWithHoles(10, 10, 0.3);
+    auto delaunay = MeshGenerator(7).randomDelaunay(3, 3);
+    auto maze = MeshGenerator(7).corridorMaze(5, 5);
+
+    CHECK(grid.triangles.size() == 120);
+    CHECK(delaunay.xs[1] == Approx(1.9487227272078669).epsilon(1e-12));
+    CHECK(delaunay.ys[1] == Approx(0.90426435831373697).epsilon(1e-12));
+    CHECK(maze.triangles.size() == 98);
+}
+
+TEST_CASE("Generated meshes should differ for different seeds")
+{
+    MeshGenerator first(5);
+    MeshGenerator second(6);
+
+    CHECK(first.gridWithHoles(20, 20, 0.3).triangles != second.gridWithHoles(20, 20, 0.3).triangles);
+}
+
+TEST_CASE("Generated random Delaunay mesh should cover its rectangle with valid connected triangles")
+{
+    MeshGenerator generator(2);
+
+    auto mesh = generator.randomDelaunay(30, 20);
+    auto graph = std::make_shared<TriangleGraph>(mesh.toTriangleSkeletons());
+
+    CHECK(mesh.xs.size() == 31 * 21);
+    CHECK(mesh.triangles.size() == 2 * 30 * 20);
+    CHECK(totalArea(graph) == Approx(600.0));
+    CHECK(reachableTriangleCount(graph) == graph->triangleCount());
+}
+
+TEST_CASE("Generated corridor maze should be a single connected region of unit corridors")
+{
+    MeshGenerator generator(3);
+
+    auto mesh = generator.corridorMaze(10, 8);
+    auto graph = std::make_shared<TriangleGraph>(mesh.toTriangleSkeletons());
+
+    // a perfect maze of n cells has n - 1 passages between them
+    CHECK(mesh.triangles.size() == 2 * (10 * 8 + 10 * 8 - 1));
+    CHECK(reachableTriangleCount(graph) == graph->triangleCount());
+}
@@ -0,0 +1,148 @@
+/**
+ * Copyright 2019 Márton Gergó
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "catch.hpp"
+#include "MeshGenerator.h"
+#include "MeshTile.h"
+#include <sstream>
+#include <stdexcept>
+
+using namespace TpaStarCpp::GeometryLibrary;
+
+static const MeshTile& tileAt(const std::vector<MeshTile>& tiles, TileCoordinates coordinates)
+{
+    for (auto& tile : tiles) {
+        if (tile.coordinates == coordinates) {
+            return tile;
+        }
+    }
+    throw std::invalid_argument("No such tile");
+}
+
+TEST_CASE("Mesh tile split should put every triangle in the tile of its centroid")
+{
+    auto mesh = MeshGenerator(1).randomDelaunay(30, 30);
+
+    auto tiles = MeshTile::split(mesh, 10.0);
+
+    size_t triangleCount = 0;
+    bool allInside = true;
+    for (auto& tile : tiles) {
+        triangleCount += tile.mesh.triangles.size();
+        for (auto& corners : tile.mesh.triangles) {
+            auto centroidX = (tile.mesh.xs[corners[0]] + tile.mesh.xs[corners[1]] + tile.mesh.xs[corners[2]]) / 3.0;
+            auto centroidY = (tile.mesh.ys[corners[0]] + tile.mesh.ys[corners[1]] + tile.mesh.ys[corners[2]]) / 3.0;
+            allInside &= (centroidX >= 10.0 * tile.coordinates.x) && (centroidX < 10.0 * (tile.coordinates.x + 1));
+            allInside &= (centroidY >= 10.0 * tile.coordinates.y) && (centroidY < 10.0 * (tile.coordinates.y + 1));
+        }
+    }
+    CHECK(tiles.size() == 9);
+    CHECK(triangleCount == mesh.triangles.size());
+    CHECK(allInside);
+}
+
+TEST_CASE("Mesh tile split should stitch the tiles with portals leading back to each other")
+{
+    auto tiles = MeshTile::split(MeshGenerator(1).randomDelaunay(30, 30), 10.0);
+
+    bool allMatching = true;
+    long portalCount = 0;
+    for (auto& tile : tiles) {
+        for (auto& portal : tile.portals) {
+            portalCount++;
+            allMatching &= tile.mesh.neighbours[portal.id][portal.edge] == -1;
+            auto& neighbourTile = tileAt(tiles, portal.neighbourTile);
+            bool hasWayBack = false;
+            for (auto& back : neighbourTile.portals) {
+                hasWayBack |= (back.id == portal.neighbourId) && (back.edge == portal.neighbourEdge)
+                        && (back.neighbourTile == tile.coordinates) && (back.neighbourId == portal.id)
+                        && (back.neighbourEdge == portal.edge);
+            }
+            allMatching &= hasWayBack;
+        }
+    }
+    CHECK(portalCount > 0);
+    CHECK(allMatching);
+}
+
+TEST_CASE("Mesh tile should read back what it saved")
+{
+    auto tiles = MeshTile::split(MeshGenerator(2).gridWithHoles(20, 20, 0.2), 10.0);
+    auto& tile = tileAt(tiles, { 1, 0 });
+    std::stringstream data;
+
+    tile.save(data);
+    auto loaded = MeshTile::load(data);
+
+    CHECK(loaded.coordinates == tile.coordinates);
+    CHECK(loaded.mesh.xs == tile.mesh.xs);
+    CHECK(loaded.mesh.ys == tile.mesh.ys);
+    CHECK(loaded.mesh.triangles == tile.mesh.triangles);
+    CHECK(loaded.mesh.neighbours == tile.mesh.neighbours);
+    REQUIRE(loaded.portals.size() == tile.portals.size());
+    for (size_t i = 0; i < tile.portals.size(); i++) {
+        CHECK(loaded.portals[i].id == tile.portals[i].id);
+        CHECK(loaded.portals[i].edge == tile.portals[i].edge);
+        CHECK(loaded.portals[i].neighbourTile == tile.portals[i].neighbourTile);
+        CHECK(loaded.portals[i].neighbourId == tile.portals[i].neighbourId);
+        CHECK(loaded.portals[i].neighbourEdge == tile.portals[i].neighbourEdge);
+    }
+}
+
+TEST_CASE("Mesh tile should reject data that is not a whole tile")
+{
+    auto tiles = MeshTile::split(MeshGenerator(2).gridWithHoles(20, 20, 0.2), 10.0);
+    std::stringstream data;
+    tiles[0].save(data);
+    auto bytes = data.str();
+
+    std::stringstream truncated(bytes.substr(0, bytes.size() / 2));
+    std::stringstream landmarks("TPAL");
+
+    CHECK_THROWS_AS(MeshTile::load(truncated), std::invalid_argument);
+    CHECK_THROWS_AS(MeshTile::load(landmarks), std::invalid_argument);
+}
+
+TEST_CASE("Mesh tile split should reject a tile size that is not positive")
+{
+    CHECK_THROWS_AS(MeshTile::split(MeshGenerator(2).gridWithHoles(2, 2, 0.0), 0.0), std::invalid_argument);
+}
+
+TEST_CASE("Mesh tile should keep the heights and the layers of the mesh")
+{
+    auto mesh = MeshGenerator(2).gridWithHoles(20, 20, 0.0);
+    for (auto x : mesh.xs) {
+        mesh.heights.push_back(0.5 * x);
+    }
+    for (size_t id = 0; id < mesh.triangles.size(); id++) {
+        mesh.layers.push_back(id % 2);
+    }
+    auto tiles = MeshTile::split(mesh, 10.0);
+    std::stringstream data;
+
+    tiles[1].save(data);
+    auto loaded = MeshTile::load(data);
+
+    REQUIRE(loaded.mesh.heights.size() == loaded.mesh.xs.size());
+    bool allMatching = true;
+    for (size_t i = 0; i < loaded.mesh.xs.size(); i++) {
+        allMatching &= loaded.mesh.heights[i] == 0.5 * loaded.mesh.xs[i];
+    }
+    CHECK(allMatching);
+    CHECK(loaded.mesh.layers == tiles[1].mesh.layers);
+    CHECK(loaded.mesh.layers.size() == loaded.mesh.triangles.size());
+}
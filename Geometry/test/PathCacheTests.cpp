@@ -0,0 +1,167 @@
+/**
+ * Copyright 2019 Márton Gergó
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "catch.hpp"
+#include "MeshGenerator.h"
+#include "Parallel.h"
+#include "PathCache.h"
+#include "TriangleSearch.h"
+#include "Vector.h"
+
+using namespace TpaStarCpp::GeometryLibrary;
+
+TEST_CASE("Path cache should count a repeated query as a hit with the same path")
+{
+    auto graph = std::make_shared<TriangleGraph>(MeshGenerator(2).gridWithHoles(20, 20, 0.2));
+    TriangleSearch search(graph);
+    PathCache cache(graph, 10000);
+    auto start = graph->metadataOf(0).centroid();
+    auto goal = graph->metadataOf(graph->triangleCount() - 1).centroid();
+
+    auto first = cache.findPath(start, goal, search);
+    auto second = cache.findPath(start, goal, search);
+
+    REQUIRE(first);
+    REQUIRE(second);
+    CHECK(cache.missCount() == 1);
+    CHECK(cache.hitCount() == 1);
+    REQUIRE(first->size() == second->size());
+    for (long i = 0; i < first->size(); i++) {
+        CHECK((*first)[i].x() == (*second)[i].x());
+        CHECK((*first)[i].y() == (*second)[i].y());
+    }
+}
+
+TEST_CASE("Path cache should pull the string for the exact endpoints of a hit")
+{
+    auto graph = std::make_shared<TriangleGraph>(MeshGenerator(1).gridWithHoles(10, 10, 0.0));
+    TriangleSearch search(graph);
+    PathCache cache(graph, 10000);
+    cache.findPath(Vector(0.3, 0.1), Vector(9.3, 9.9), search);
+
+    auto path = cache.findPath(Vector(0.4, 0.1), Vector(9.2, 9.9), search);
+
+    REQUIRE(path);
+    CHECK(cache.hitCount() == 1);
+    CHECK(path->front().x() == Approx(0.4));
+    CHECK(path->back().x() == Approx(9.2));
+}
+
+TEST_CASE("Path cache should drop a corridor when one of its triangles is blocked")
+{
+    auto graph = std::make_shared<TriangleGraph>(MeshGenerator(1).gridWithHoles(10, 10, 0.0));
+    TriangleSearch search(graph);
+    PathCache cache(graph, 10000);
+    auto startId = graph->findIdOfTriangleUnder(Vector(0.5, 5.5));
+    auto goalId = graph->findIdOfTriangleUnder(Vector(9.5, 5.5));
+    auto corridor = search.findPath(Vector(0.5, 5.5), Vector(9.5, 5.5)).triangleIds;
+    cache.store(startId, goalId, corridor);
+
+    graph->setBlocked(corridor[corridor.size() / 2], true);
+
+    CHECK_FALSE(cache.findCorridor(startId, goalId));
+    CHECK(cache.storedTriangleIdCount() == 0);
+}
+
+TEST_CASE("Path cache should drop the corridors stored before a triangle was unblocked")
+{
+    auto graph = std::make_shared<TriangleGraph>(MeshGenerator(1).gridWithHoles(10, 10, 0.0));
+    TriangleSearch search(graph);
+    PathCache cache(graph, 10000);
+    graph->setBlocked(graph->findIdOfTriangleUnder(Vector(5.5, 5.2)), true);
+    cache.findPath(Vector(0.5, 5.5), Vector(9.5, 5.5), search);
+
+    graph->setBlocked(graph->findIdOfTriangleUnder(Vector(5.5, 5.2)), false);
+    cache.findPath(Vector(0.5, 5.5), Vector(9.5, 5.5), search);
+
+    CHECK(cache.hitCount() == 0);
+    CHECK(cache.missCount() == 2);
+}
+
+TEST_CASE("Path cache should drop the corridors stored before a triangle got more expensive")
+{
+    auto graph = std::make_shared<TriangleGraph>(MeshGenerator(1).gridWithHoles(10, 10, 0.0));
+    TriangleSearch search(graph);
+    PathCache cache(graph, 10000);
+    cache.findPath(Vector(0.5, 5.5), Vector(9.5, 5.5), search);
+    auto startId = graph->findIdOfTriangleUnder(Vector(0.5, 5.5));
+    auto goalId = graph->findIdOfTriangleUnder(Vector(9.5, 5.5));
+    auto corridor = *cache.findCorridor(startId, goalId);
+
+    graph->setCostMultiplier(corridor[corridor.size() / 2], 50.0);
+    cache.findPath(Vector(0.5, 5.5), Vector(9.5, 5.5), search);
+
+    CHECK(cache.hitCount() == 1);
+    CHECK(cache.missCount() == 2);
+    CHECK(*cache.findCorridor(startId, goalId) != corridor);
+}
+
+TEST_CASE("Path cache should keep the stored corridors within its capacity")
+{
+    auto graph = std::make_shared<TriangleGraph>(MeshGenerator(1).gridWithHoles(30, 30, 0.0));
+    TriangleSearch search(graph);
+    PathCache cache(graph, 400, 4);
+
+    for (long goalId = 0; goalId < graph->triangleCount(); goalId += 7) {
+        cache.findPath(graph->metadataOf(0).centroid(), graph->metadataOf(goalId).centroid(), search);
+        CHECK(cache.storedTriangleIdCount() <= 400);
+    }
+    CHECK(cache.storedTriangleIdCount() > 0);
+}
+
+TEST_CASE("Path cache should keep recently used corridors when evicting")
+{
+    auto graph = std::make_shared<TriangleGraph>(MeshGenerator(1).gridWithHoles(10, 10, 0.0));
+    PathCache cache(graph, 30, 1);
+    cache.store(0, 1, std::vector<long>(10, 0));
+    cache.store(0, 2, std::vector<long>(10, 0));
+    cache.store(0, 3, std::vector<long>(10, 0));
+    cache.findCorridor(0, 1);
+
+    cache.store(0, 4, std::vector<long>(10, 0));
+
+    CHECK(cache.findCorridor(0, 1));
+    CHECK_FALSE(cache.findCorridor(0, 2));
+    CHECK(cache.findCorridor(0, 3));
+    CHECK(cache.findCorridor(0, 4));
+}
+
+TEST_CASE("Path cache should count every query of concurrent threads")
+{
+    auto graph = std::make_shared<TriangleGraph>(MeshGenerator(2).gridWithHoles(20, 20, 0.0));
+    PathCache cache(graph, 100000);
+
+    parallelFor(64, [&](long i) {
+        TriangleSearch search(graph);
+        for (long goalId = 0; goalId < 40; goalId += 4) {
+            cache.findPath(graph->metadataOf(i % 8).centroid(), graph->metadataOf(goalId).centroid(), search);
+        }
+    });
+
+    CHECK(cache.hitCount() + cache.missCount() == 640);
+    CHECK(cache.missCount() >= 80);
+}
+
+TEST_CASE("Path cache should throw if the start or the goal is not on the mesh")
+{
+    auto graph = std::make_shared<TriangleGraph>(MeshGenerator(2).gridWithHoles(4, 4, 0.0));
+    TriangleSearch search(graph);
+    PathCache cache(graph, 1000);
+
+    CHECK_THROWS_WITH(cache.findPath(Vector(-1.0, 1.0), Vector(1.5, 1.5), search), Catch::Contains("start point"));
+    CHECK_THROWS_WITH(cache.findPath(Vector(1.5, 1.5), Vector(9.0, 1.0), search), Catch::Contains("goal point"));
+    CHECK(cache.missCount() == 0);
+}
@@ -0,0 +1,122 @@
+/**
+ * Copyright 2019 Márton Gergó
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "catch.hpp"
+#include "MeshGenerator.h"
+#include "PathCorridor.h"
+#include "TriangleSearch.h"
+#include "Vector.h"
+
+using namespace TpaStarCpp::GeometryLibrary;
+
+static bool isConnected(std::shared_ptr<TriangleGraph> graph, const std::deque<long>& triangleIds)
+{
+    for (long i = 1; i < triangleIds.size(); i++) {
+        auto& neighbours = graph->neighbourIdsOf(triangleIds[i - 1]);
+        if (std::find(begin(neighbours), end(neighbours), triangleIds[i]) == end(neighbours)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+TEST_CASE("Path corridor should shrink as the agent follows its corners to the goal")
+{
+    auto graph = std::make_shared<TriangleGraph>(MeshGenerator(4).corridorMaze(8, 8));
+    auto start = graph->metadataOf(0).centroid();
+    auto goal = graph->metadataOf(graph->triangleCount() - 1).centroid();
+    auto route = TriangleSearch(graph).findPath(start, goal);
+    REQUIRE(route.isFound);
+    PathCorridor corridor(graph, route.triangleIds, start, goal);
+
+    long tickCount = 0;
+    while ((corridor.position().distanceFrom(goal) > 1e-9) && (tickCount < 10000)) {
+        auto corners = corridor.findCorners(2);
+        REQUIRE(corners.size() >= 2);
+        auto direction = corners[1] - corners[0];
+        auto isLastStep = direction.len() <= 0.2;
+        auto next = isLastStep ? corners[1] : corners[0] + direction * (0.2 / direction.len());
+        long previousSize = corridor.triangleIds().size();
+
+        REQUIRE(corridor.movePosition(next));
+
+        CHECK(corridor.triangleIds().size() <= previousSize);
+        CHECK(graph->triangleContains(corridor.triangleIds().front(), corridor.position()));
+        tickCount++;
+    }
+
+    CHECK(corridor.triangleIds().size() == 1);
+    CHECK(corridor.triangleIds().front() == graph->triangleCount() - 1);
+}
+
+TEST_CASE("Path corridor should put the triangles the agent drifted into in front")
+{
+    auto graph = std::make_shared<TriangleGraph>(MeshGenerator(1).gridWithHoles(10, 10, 0.0));
+    Vector start(0.5, 0.2);
+    Vector goal(9.5, 0.2);
+    auto route = TriangleSearch(graph).findPath(start, goal);
+    PathCorridor corridor(graph, route.triangleIds, start, goal);
+    auto length = corridor.triangleIds().size();
+
+    REQUIRE(corridor.movePosition(Vector(0.5, 2.5)));
+
+    CHECK(corridor.triangleIds().size() > length);
+    CHECK(corridor.triangleIds().front() == graph->findIdOfTriangleUnder(Vector(0.5, 2.5)));
+    CHECK(isConnected(graph, corridor.triangleIds()));
+    auto corners = corridor.findCorners(10);
+    CHECK(corners.back().x() == Approx(9.5));
+}
+
+TEST_CASE("Path corridor should pull only the requested number of corners")
+{
+    auto graph = std::make_shared<TriangleGraph>(MeshGenerator(4).corridorMaze(8, 8));
+    auto start = graph->metadataOf(0).centroid();
+    auto goal = graph->metadataOf(graph->triangleCount() - 1).centroid();
+    auto route = TriangleSearch(graph).findPath(start, goal);
+    PathCorridor corridor(graph, route.triangleIds, start, goal);
+    auto all = corridor.findCorners(1000);
+    REQUIRE(all.size() > 4);
+
+    auto visible = corridor.findCorners(3);
+
+    REQUIRE(visible.size() == 4);
+    for (int i = 0; i < 4; i++) {
+        CHECK(visible[i].x() == all[i].x());
+        CHECK(visible[i].y() == all[i].y());
+    }
+}
+
+TEST_CASE("Path corridor should refuse a move through a blocked triangle")
+{
+    auto graph = std::make_shared<TriangleGraph>(MeshGenerator(1).gridWithHoles(10, 10, 0.0));
+    graph->setBlocked(graph->findIdOfTriangleUnder(Vector(1.5, 0.2)), true);
+    graph->setBlocked(graph->findIdOfTriangleUnder(Vector(1.5, 0.8)), true);
+    Vector start(0.5, 0.2);
+    PathCorridor corridor(graph, { graph->findIdOfTriangleUnder(start) }, start, start);
+
+    CHECK_FALSE(corridor.movePosition(Vector(2.5, 0.5)));
+    CHECK(corridor.position().x() == 0.5);
+    CHECK(corridor.triangleIds().size() == 1);
+}
+
+TEST_CASE("Path corridor should throw if the position is not in its first triangle")
+{
+    auto graph = std::make_shared<TriangleGraph>(MeshGenerator(1).gridWithHoles(4, 4, 0.0));
+    auto id = graph->findIdOfTriangleUnder(Vector(0.5, 0.2));
+
+    CHECK_THROWS_AS(PathCorridor(graph, { id }, Vector(3.5, 3.5), Vector(0.5, 0.2)), std::invalid_argument);
+    CHECK_THROWS_AS(PathCorridor(graph, {}, Vector(0.5, 0.2), Vector(0.5, 0.2)), std::invalid_argument);
+}
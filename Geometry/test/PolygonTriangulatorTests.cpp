@@ -0,0 +1,172 @@
+/**
+ * Copyright 2019 Márton Gergó
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "catch.hpp"
+#include "PolygonTriangulator.h"
+#include "TriangleGraph.h"
+#include "Triangle.h"
+#include "Vector.h"
+#include <cmath>
+
+using namespace TpaStarCpp::GeometryLibrary;
+
+static double totalAreaOf(IndexedMesh& mesh)
+{
+    double area = 0.0;
+    for (auto& corners : mesh.triangles) {
+        area += ((mesh.xs[corners[1]] - mesh.xs[corners[0]]) * (mesh.ys[corners[2]] - mesh.ys[corners[0]]) -
+                 (mesh.xs[corners[2]] - mesh.xs[corners[0]]) * (mesh.ys[corners[1]] - mesh.ys[corners[0]])) / 2.0;
+    }
+    return area;
+}
+
+static std::vector<Vector> circle(double centerX, double centerY, double radius, int cornerCount)
+{
+    std::vector<Vector> corners;
+    for (int i = 0; i < cornerCount; i++) {
+        auto angle = 2.0 * M_PI * i / cornerCount;
+        corners.emplace_back(centerX + radius * std::cos(angle), centerY + radius * std::sin(angle));
+    }
+    return corners;
+}
+
+TEST_CASE("Polygon triangulator should cover a convex outline")
+{
+    PolygonTriangulator triangulator;
+    triangulator.addOutline({ Vector(0.0, 0.0), Vector(4.0, 0.0), Vector(4.0, 3.0), Vector(0.0, 3.0) });
+
+    auto mesh = triangulator.triangulate();
+
+    CHECK(mesh.triangles.size() == 2);
+    CHECK(totalAreaOf(mesh) == Approx(12.0));
+}
+
+TEST_CASE("Polygon triangulator should cover a concave outline")
+{
+    PolygonTriangulator triangulator;
+    triangulator.addOutline({ Vector(0.0, 0.0), Vector(6.0, 0.0), Vector(6.0, 6.0), Vector(4.0, 6.0),
+                              Vector(4.0, 2.0), Vector(2.0, 2.0), Vector(2.0, 6.0), Vector(0.0, 6.0) });
+
+    auto mesh = triangulator.triangulate();
+
+    CHECK(mesh.triangles.size() == 6);
+    CHECK(totalAreaOf(mesh) == Approx(28.0));
+}
+
+TEST_CASE("Polygon triangulator should leave out the holes of the outline")
+{
+    PolygonTriangulator triangulator;
+    triangulator.addOutline(circle(0.0, 0.0, 10.0, 64));
+    triangulator.addHole({ Vector(-5.0, -1.0), Vector(-3.0, -1.0), Vector(-3.0, 1.0), Vector(-5.0, 1.0) });
+    triangulator.addHole(circle(4.0, 0.0, 2.0, 16));
+
+    auto mesh = triangulator.triangulate();
+
+    auto outlineArea = 0.5 * 64 * 100.0 * std::sin(2.0 * M_PI / 64);
+    auto holeArea = 4.0 + 0.5 * 16 * 4.0 * std::sin(2.0 * M_PI / 16);
+    CHECK(totalAreaOf(mesh) == Approx(outlineArea - holeArea));
+    CHECK(mesh.xs.size() == 64 + 4 + 16);
+}
+
+TEST_CASE("Polygon triangulator should build the same neighbours as matching the edges of the triangles")
+{
+    PolygonTriangulator triangulator;
+    triangulator.addOutline(circle(0.0, 0.0, 10.0, 48));
+    triangulator.addHole(circle(2.0, 1.0, 3.0, 12));
+    auto mesh = triangulator.triangulate();
+
+    TriangleGraph graph(mesh);
+    TriangleGraph matchedGraph(mesh.toTriangleSkeletons());
+
+    bool allNeighboursEqual = true;
+    for (long id = 0; id < graph.triangleCount(); id++) {
+        allNeighboursEqual &= graph.neighbourIdsOf(id) == matchedGraph.neighbourIdsOf(id);
+        for (int edge = 0; edge < 3; edge++) {
+            allNeighboursEqual &= graph.neighbourIdAcross(id, edge) == matchedGraph.neighbourIdAcross(id, edge);
+        }
+    }
+    CHECK(graph.triangleCount() == mesh.triangles.size());
+    CHECK(allNeighboursEqual);
+}
+
+TEST_CASE("Polygon triangulator should build a graph that does not contain the holes")
+{
+    PolygonTriangulator triangulator;
+    triangulator.addOutline({ Vector(0.0, 0.0), Vector(10.0, 0.0), Vector(10.0, 10.0), Vector(0.0, 10.0) });
+    triangulator.addHole({ Vector(4.0, 4.0), Vector(6.0, 4.0), Vector(6.0, 6.0), Vector(4.0, 6.0) });
+
+    auto graph = triangulator.buildGraph(TriangleOrdering::HilbertCurve);
+
+    CHECK(graph->containsPoint(Vector(2.0, 2.0)));
+    CHECK_FALSE(graph->containsPoint(Vector(5.0, 5.0)));
+    CHECK_FALSE(graph->containsPoint(Vector(11.0, 5.0)));
+}
+
+TEST_CASE("Polygon triangulator should leave out an outline inside a hole and keep the hole of that outline")
+{
+    PolygonTriangulator triangulator;
+    triangulator.addOutline({ Vector(0.0, 0.0), Vector(10.0, 0.0), Vector(10.0, 10.0), Vector(0.0, 10.0) });
+    triangulator.addHole({ Vector(2.0, 2.0), Vector(2.0, 8.0), Vector(8.0, 8.0), Vector(8.0, 2.0) });
+    triangulator.addOutline({ Vector(3.0, 3.0), Vector(7.0, 3.0), Vector(7.0, 7.0), Vector(3.0, 7.0) });
+    triangulator.addHole({ Vector(4.0, 4.0), Vector(6.0, 4.0), Vector(6.0, 6.0), Vector(4.0, 6.0) });
+
+    auto mesh = triangulator.triangulate();
+
+    CHECK(totalAreaOf(mesh) == Approx(100.0 - 36.0 + 16.0 - 4.0));
+}
+
+TEST_CASE("Polygon triangulator should not accept overlapping or misplaced holes")
+{
+    std::vector<Vector> outline { Vector(0.0, 0.0), Vector(10.0, 0.0), Vector(10.0, 10.0), Vector(0.0, 10.0) };
+    PolygonTriangulator crossing;
+    crossing.addOutline(outline);
+    crossing.addHole({ Vector(2.0, 2.0), Vector(6.0, 2.0), Vector(6.0, 6.0), Vector(2.0, 6.0) });
+    crossing.addHole({ Vector(4.0, 4.0), Vector(8.0, 4.0), Vector(8.0, 8.0), Vector(4.0, 8.0) });
+    PolygonTriangulator nested;
+    nested.addOutline(outline);
+    nested.addHole({ Vector(2.0, 2.0), Vector(8.0, 2.0), Vector(8.0, 8.0), Vector(2.0, 8.0) });
+    nested.addHole({ Vector(4.0, 4.0), Vector(6.0, 4.0), Vector(6.0, 6.0), Vector(4.0, 6.0) });
+    PolygonTriangulator outside;
+    outside.addOutline(outline);
+    outside.addHole({ Vector(12.0, 2.0), Vector(14.0, 2.0), Vector(14.0, 4.0), Vector(12.0, 4.0) });
+    PolygonTriangulator outlineInOutline;
+    outlineInOutline.addOutline(outline);
+    outlineInOutline.addOutline({ Vector(4.0, 4.0), Vector(6.0, 4.0), Vector(6.0, 6.0), Vector(4.0, 6.0) });
+
+    CHECK_THROWS_WITH(crossing.triangulate(), Catch::Contains("cross"));
+    CHECK_THROWS_WITH(nested.triangulate(), Catch::Contains("hole"));
+    CHECK_THROWS_WITH(outside.triangulate(), Catch::Contains("hole"));
+    CHECK_THROWS_WITH(outlineInOutline.triangulate(), Catch::Contains("outline"));
+}
+
+TEST_CASE("Polygon triangulator should accept holes sharing an edge")
+{
+    PolygonTriangulator triangulator;
+    triangulator.addOutline({ Vector(0.0, 0.0), Vector(10.0, 0.0), Vector(10.0, 10.0), Vector(0.0, 10.0) });
+    triangulator.addHole({ Vector(2.0, 2.0), Vector(4.0, 2.0), Vector(4.0, 4.0), Vector(2.0, 4.0) });
+    triangulator.addHole({ Vector(4.0, 2.0), Vector(6.0, 2.0), Vector(6.0, 4.0), Vector(4.0, 4.0) });
+
+    auto mesh = triangulator.triangulate();
+
+    CHECK(totalAreaOf(mesh) == Approx(92.0));
+}
+
+TEST_CASE("Polygon triangulator should not accept rings of less than three corners")
+{
+    PolygonTriangulator triangulator;
+
+    CHECK_THROWS_WITH(triangulator.addOutline({ Vector(0.0, 0.0), Vector(1.0, 0.0) }), Catch::Contains("three"));
+}
@@ -0,0 +1,104 @@
+/**
+ * Copyright 2019 Márton Gergó
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "catch.hpp"
+#include "MeshGenerator.h"
+#include "SlicedSearch.h"
+#include "TriangleSearch.h"
+#include "Vector.h"
+
+using namespace TpaStarCpp::GeometryLibrary;
+
+TEST_CASE("Sliced search should find the same path as the search run at once")
+{
+    auto graph = std::make_shared<TriangleGraph>(MeshGenerator(4).corridorMaze(10, 10));
+    auto start = graph->metadataOf(0).centroid();
+    auto goal = graph->metadataOf(graph->triangleCount() - 1).centroid();
+    auto expected = TriangleSearch(graph).findPath(start, goal);
+    SlicedSearch search(graph);
+
+    search.start(start, goal);
+    long sliceCount = 0;
+    while (search.step(10) == SearchState::Running) {
+        sliceCount++;
+    }
+
+    CHECK(search.state() == SearchState::Found);
+    CHECK(sliceCount > 1);
+    CHECK(search.result().isFound);
+    CHECK(search.result().cost == Approx(expected.cost));
+    CHECK(search.result().triangleIds == expected.triangleIds);
+    CHECK(search.expandedCount() == expected.expandedCount);
+}
+
+TEST_CASE("Sliced search should make progress in every time slice")
+{
+    auto graph = std::make_shared<TriangleGraph>(MeshGenerator(4).corridorMaze(10, 10));
+    SlicedSearch search(graph);
+    search.start(graph->metadataOf(0).centroid(), graph->metadataOf(graph->triangleCount() - 1).centroid());
+
+    long previousCount = 0;
+    while (search.stepFor(std::chrono::microseconds(0)) == SearchState::Running) {
+        CHECK(search.expandedCount() > previousCount);
+        previousCount = search.expandedCount();
+    }
+
+    CHECK(search.state() == SearchState::Found);
+}
+
+TEST_CASE("Sliced search should return the path towards the goal when cancelled")
+{
+    auto graph = std::make_shared<TriangleGraph>(MeshGenerator(1).gridWithHoles(30, 30, 0.0));
+    Vector start(0.5, 0.5);
+    Vector goal(29.5, 29.5);
+    SlicedSearch search(graph);
+    search.start(start, goal);
+
+    search.step(100);
+    auto& partial = search.cancel();
+
+    CHECK(search.state() == SearchState::Cancelled);
+    CHECK_FALSE(partial.isFound);
+    REQUIRE(partial.triangleIds.size() > 1);
+    CHECK(partial.triangleIds.front() == graph->findIdOfTriangleUnder(start));
+    auto last = graph->metadataOf(partial.triangleIds.back()).centroid();
+    CHECK(last.distanceFrom(goal) < start.distanceFrom(goal) - 5.0);
+    CHECK(search.step(100) == SearchState::Cancelled);
+}
+
+TEST_CASE("Sliced search should report a goal it cannot reach")
+{
+    auto graph = std::make_shared<TriangleGraph>(MeshGenerator(1).gridWithHoles(10, 10, 0.0));
+    for (int y = 0; y < 10; y++) {
+        graph->setBlocked(graph->findIdOfTriangleUnder(Vector(5.2, y + 0.5)), true);
+        graph->setBlocked(graph->findIdOfTriangleUnder(Vector(5.8, y + 0.5)), true);
+    }
+    SlicedSearch search(graph);
+
+    search.start(Vector(0.5, 0.5), Vector(9.5, 0.5));
+
+    CHECK(search.step(1000000) == SearchState::NotFound);
+    CHECK_FALSE(search.result().isFound);
+}
+
+TEST_CASE("Sliced search should throw if the goal is not on the mesh")
+{
+    auto graph = std::make_shared<TriangleGraph>(MeshGenerator(1).gridWithHoles(4, 4, 0.0));
+    SlicedSearch search(graph);
+
+    CHECK_THROWS_AS(search.start(Vector(1.0, 1.0), Vector(9.0, 1.0)), std::invalid_argument);
+    CHECK(search.state() == SearchState::Idle);
+}
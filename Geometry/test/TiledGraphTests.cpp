@@ -0,0 +1,144 @@
+/**
+ * Copyright 2019 Márton Gergó
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "catch.hpp"
+#include "MeshGenerator.h"
+#include "TiledGraph.h"
+#include <atomic>
+#include <map>
+#include <sstream>
+
+using namespace TpaStarCpp::GeometryLibrary;
+
+// serves the tiles from saved copies held in memory, counting the tiles opened
+static TileSource sourceOf(const std::vector<MeshTile>& tiles, std::shared_ptr<std::atomic<int>> openCount)
+{
+    auto data = std::make_shared<std::map<std::pair<long, long>, std::string>>();
+    for (auto& tile : tiles) {
+        std::stringstream output;
+        tile.save(output);
+        (*data)[{ tile.coordinates.x, tile.coordinates.y }] = output.str();
+    }
+    return [data, openCount](long tileX, long tileY) -> std::unique_ptr<std::istream> {
+        auto found = data->find({ tileX, tileY });
+        if (found == data->end()) {
+            return nullptr;
+        }
+        (*openCount)++;
+        return std::make_unique<std::istringstream>(found->second);
+    };
+}
+
+TEST_CASE("Tiled graph should load a tile on the calling thread")
+{
+    auto openCount = std::make_shared<std::atomic<int>>(0);
+    TiledGraph graph(sourceOf(MeshTile::split(MeshGenerator(1).gridWithHoles(30, 30, 0.0), 10.0), openCount), 10.0,
+            100000);
+
+    CHECK(graph.loadTile({ 1, 1 }));
+    CHECK_FALSE(graph.loadTile({ 5, 5 }));
+
+    CHECK(graph.isResident({ 1, 1 }));
+    CHECK(graph.residentTileCount() == 1);
+    CHECK(graph.residentTriangleCount() == 200);
+    CHECK(graph.isUnavailable({ 5, 5 }));
+    auto tile = graph.findTile({ 1, 1 });
+    REQUIRE(tile != nullptr);
+    CHECK(tile->graph->findIdOfTriangleUnder(Vector(15.2, 15.5)) >= 0);
+    CHECK(graph.findTile({ 0, 0 }) == nullptr);
+}
+
+TEST_CASE("Tiled graph should load the requested tiles in the background once each")
+{
+    auto openCount = std::make_shared<std::atomic<int>>(0);
+    TiledGraph graph(sourceOf(MeshTile::split(MeshGenerator(1).gridWithHoles(30, 30, 0.0), 10.0), openCount), 10.0,
+            100000);
+
+    for (long x = -1; x <= 3; x++) {
+        graph.requestTile({ x, 0 });
+        graph.requestTile({ x, 0 });
+    }
+    graph.waitUntilIdle();
+
+    CHECK(graph.residentTileCount() == 3);
+    CHECK(*openCount == 3);
+    CHECK(graph.isUnavailable({ -1, 0 }));
+    CHECK(graph.isUnavailable({ 3, 0 }));
+}
+
+TEST_CASE("Tiled graph should unload the least recently used tiles over its budget")
+{
+    auto openCount = std::make_shared<std::atomic<int>>(0);
+    TiledGraph graph(sourceOf(MeshTile::split(MeshGenerator(1).gridWithHoles(30, 30, 0.0), 10.0), openCount), 10.0,
+            400);
+    graph.loadTile({ 0, 0 });
+    graph.loadTile({ 1, 0 });
+    auto held = graph.findTile({ 0, 0 });
+
+    graph.loadTile({ 2, 0 });
+
+    CHECK(graph.residentTriangleCount() == 400);
+    CHECK(graph.isResident({ 0, 0 }));
+    CHECK_FALSE(graph.isResident({ 1, 0 }));
+    CHECK(graph.isResident({ 2, 0 }));
+
+    graph.releaseMemory(0);
+
+    CHECK(graph.residentTileCount() == 0);
+    CHECK(held->graph->triangleCount() == 200);
+}
+
+TEST_CASE("Tiled graph should keep the last tile loaded even if it exceeds the budget alone")
+{
+    auto openCount = std::make_shared<std::atomic<int>>(0);
+    TiledGraph graph(sourceOf(MeshTile::split(MeshGenerator(1).gridWithHoles(30, 30, 0.0), 10.0), openCount), 10.0,
+            100);
+
+    graph.loadTile({ 0, 0 });
+    graph.loadTile({ 1, 0 });
+
+    CHECK(graph.residentTileCount() == 1);
+    CHECK(graph.isResident({ 1, 0 }));
+}
+
+TEST_CASE("Tiled graph should retry a tile whose data could not be read")
+{
+    auto tiles = MeshTile::split(MeshGenerator(1).gridWithHoles(30, 30, 0.0), 10.0);
+    auto openCount = std::make_shared<std::atomic<int>>(0);
+    auto source = sourceOf(tiles, openCount);
+    auto isReady = std::make_shared<std::atomic<bool>>(false);
+    TiledGraph graph([source, isReady](long tileX, long tileY) -> std::unique_ptr<std::istream> {
+        return *isReady ? source(tileX, tileY) : std::make_unique<std::istringstream>("TPAT");
+    }, 10.0, 100000);
+
+    graph.requestTile({ 0, 0 });
+    graph.waitUntilIdle();
+
+    CHECK(graph.hasFailed({ 0, 0 }));
+    CHECK_FALSE(graph.isUnavailable({ 0, 0 }));
+    CHECK_THROWS_AS(graph.loadTile({ 1, 0 }), std::invalid_argument);
+    CHECK(graph.hasFailed({ 1, 0 }));
+
+    *isReady = true;
+    graph.requestTile({ 0, 0 });
+    graph.waitUntilIdle();
+
+    CHECK(graph.isResident({ 0, 0 }));
+    CHECK_FALSE(graph.hasFailed({ 0, 0 }));
+    CHECK(graph.loadTile({ 1, 0 }));
+    CHECK_FALSE(graph.hasFailed({ 1, 0 }));
+}
@@ -0,0 +1,143 @@
+/**
+ * Copyright 2019 Márton Gergó
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "catch.hpp"
+#include "MeshGenerator.h"
+#include "TiledSearch.h"
+#include "TriangleSearch.h"
+#include "Vector.h"
+#include <algorithm>
+#include <map>
+#include <random>
+#include <sstream>
+
+using namespace TpaStarCpp::GeometryLibrary;
+
+static TileSource sourceOf(const std::vector<MeshTile>& tiles)
+{
+    auto data = std::make_shared<std::map<std::pair<long, long>, std::string>>();
+    for (auto& tile : tiles) {
+        std::stringstream output;
+        tile.save(output);
+        (*data)[{ tile.coordinates.x, tile.coordinates.y }] = output.str();
+    }
+    return [data](long tileX, long tileY) -> std::unique_ptr<std::istream> {
+        auto found = data->find({ tileX, tileY });
+        if (found == data->end()) {
+            return nullptr;
+        }
+        return std::make_unique<std::istringstream>(found->second);
+    };
+}
+
+static bool contains(const std::vector<TileCoordinates>& tiles, TileCoordinates coordinates)
+{
+    return std::find(tiles.begin(), tiles.end(), coordinates) != tiles.end();
+}
+
+TEST_CASE("Tiled search should find paths as short as the triangle search on the whole mesh")
+{
+    auto mesh = MeshGenerator(3).randomDelaunay(30, 30);
+    auto whole = std::make_shared<TriangleGraph>(mesh);
+    TriangleSearch search(whole);
+    auto graph = std::make_shared<TiledGraph>(sourceOf(MeshTile::split(mesh, 10.0)), 10.0, 100000);
+    // the ring around the map is found unavailable, so no tile is reported missing
+    for (long x = -1; x <= 3; x++) {
+        for (long y = -1; y <= 3; y++) {
+            graph->loadTile({ x, y });
+        }
+    }
+    TiledSearch tiledSearch(graph);
+    std::mt19937 random(4);
+    std::uniform_real_distribution<double> coordinate(0.5, 29.5);
+
+    bool allEqual = true;
+    for (int i = 0; i < 30; i++) {
+        Vector start(coordinate(random), coordinate(random));
+        Vector goal(coordinate(random), coordinate(random));
+        auto expected = search.findPath(start, goal);
+        auto result = tiledSearch.findPath(start, goal);
+        allEqual &= result.isFound && (result.cost == Approx(expected.cost))
+                && (result.triangles.size() == expected.triangleIds.size()) && result.missingTiles.empty();
+    }
+    CHECK(allEqual);
+}
+
+TEST_CASE("Tiled search should cross to the neighbouring tile through the portals")
+{
+    auto graph = std::make_shared<TiledGraph>(
+            sourceOf(MeshTile::split(MeshGenerator(1).gridWithHoles(30, 10, 0.0), 10.0)), 10.0, 100000);
+    graph->loadTile({ 0, 0 });
+    graph->loadTile({ 1, 0 });
+    graph->loadTile({ 2, 0 });
+    TiledSearch search(graph);
+
+    auto result = search.findPath(Vector(1.5, 5.5), Vector(28.5, 5.5));
+
+    REQUIRE(result.isFound);
+    CHECK(result.triangles.front().tile == TileCoordinates { 0, 0 });
+    CHECK(result.triangles.back().tile == TileCoordinates { 2, 0 });
+    CHECK(result.cost >= 27.0);
+    CHECK(result.missingTiles.empty());
+}
+
+TEST_CASE("Tiled search should report the missing tile standing between the start and the goal")
+{
+    auto graph = std::make_shared<TiledGraph>(
+            sourceOf(MeshTile::split(MeshGenerator(1).gridWithHoles(30, 10, 0.0), 10.0)), 10.0, 100000);
+    graph->loadTile({ 0, 0 });
+    graph->loadTile({ 2, 0 });
+    TiledSearch search(graph);
+
+    auto result = search.findPath(Vector(1.5, 5.5), Vector(28.5, 5.5));
+
+    CHECK_FALSE(result.isFound);
+    CHECK(contains(result.missingTiles, { 1, 0 }));
+    CHECK_FALSE(contains(result.missingTiles, { 0, 1 }));
+
+    graph->requestTile({ 1, 0 });
+    graph->waitUntilIdle();
+
+    CHECK(search.findPath(Vector(1.5, 5.5), Vector(28.5, 5.5)).isFound);
+}
+
+TEST_CASE("Tiled search should report the missing tile of an endpoint")
+{
+    auto graph = std::make_shared<TiledGraph>(
+            sourceOf(MeshTile::split(MeshGenerator(1).gridWithHoles(30, 10, 0.0), 10.0)), 10.0, 100000);
+    graph->loadTile({ 0, 0 });
+    TiledSearch search(graph);
+
+    auto result = search.findPath(Vector(1.5, 5.5), Vector(28.5, 5.5));
+
+    CHECK_FALSE(result.isFound);
+    CHECK(contains(result.missingTiles, { 2, 0 }));
+}
+
+TEST_CASE("Tiled search should throw for a point off the map once the tiles around it are known")
+{
+    auto graph = std::make_shared<TiledGraph>(
+            sourceOf(MeshTile::split(MeshGenerator(1).gridWithHoles(30, 10, 0.0), 10.0)), 10.0, 100000);
+    for (long x = 0; x < 3; x++) {
+        for (long y = 0; y < 3; y++) {
+            graph->loadTile({ x, y });
+        }
+    }
+    TiledSearch search(graph);
+
+    CHECK_THROWS_AS(search.findPath(Vector(1.5, 5.5), Vector(15.0, 15.0)), std::invalid_argument);
+}
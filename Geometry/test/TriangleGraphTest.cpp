@@ -16,6 +16,7 @@
 
 #include <catch.hpp>
 #include <Triangle.h>
+#include "IndexedMesh.h"
 #include "TriangleGraph.h"
 #include "TriangleSkeleton.h"
 
@@ -136,4 +137,561 @@ TEST_CASE("Neighbour triangle in a square should have exactly one neighbour")
 
     CHECK(neighbours.size() == 1);
     CHECK(neighbourTriangleMathcer.matches(neighbours[0]));
-}
\ No newline at end of file
+}
+
+TEST_CASE("Graph should provide the precomputed metadata of its triangles")
+{
+    auto triangles = std::vector<TriangleSkeleton> {
+            TriangleSkeleton(Vector(1.0, 2.0), Vector(3.0, 2.0), Vector(1.0, 4.0)),
+            TriangleSkeleton(Vector(3.0, 4.0), Vector(3.0, 2.0), Vector(1.0, 4.0)),
+    };
+    auto graph = std::make_shared<TriangleGraph>(triangles);
+
+    auto metadata = graph->metadataOf(1);
+
+    CHECK(graph->triangleCount() == 2);
+    CHECK(metadata.centroidX == Approx(7.0 / 3.0));
+    CHECK(metadata.centroidY == Approx(10.0 / 3.0));
+    CHECK(metadata.area == Approx(2.0));
+}
+
+TEST_CASE("Triangles sharing corners within vector tolerance should be neighbours")
+{
+    auto triangles = std::vector<TriangleSkeleton> {
+            TriangleSkeleton(Vector(1.0, 2.0), Vector(3.0, 2.0), Vector(1.0, 4.0)),
+            TriangleSkeleton(Vector(3.0, 4.0), Vector(3.000001, 2.0), Vector(1.0, 4.000001)),
+    };
+    auto graph = std::make_shared<TriangleGraph>(triangles);
+
+    CHECK(graph->neighbourIdsOf(0) == std::vector<long> { 1 });
+    CHECK(graph->neighbourIdsOf(1) == std::vector<long> { 0 });
+}
+
+TEST_CASE("Triangles sharing only one corner should not be neighbours in the graph")
+{
+    auto triangles = std::vector<TriangleSkeleton> {
+            TriangleSkeleton(Vector(1.0, 1.0), Vector(2.0, 1.0), Vector(2.0, 3.5)),
+            TriangleSkeleton(Vector(2.0, 1.0), Vector(4.0, 1.0), Vector(2.0, 0.0)),
+    };
+    auto graph = std::make_shared<TriangleGraph>(triangles);
+
+    CHECK(graph->neighbourIdsOf(0).empty());
+    CHECK(graph->neighbourIdsOf(1).empty());
+}
+
+TEST_CASE("External ids should match input order when triangles are not reordered")
+{
+    auto triangles = std::vector<TriangleSkeleton> {
+            TriangleSkeleton(Vector(1.0, 2.0), Vector(3.0, 2.0), Vector(1.0, 4.0)),
+            TriangleSkeleton(Vector(3.0, 4.0), Vector(3.0, 2.0), Vector(1.0, 4.0)),
+    };
+    auto graph = std::make_shared<TriangleGraph>(triangles);
+
+    CHECK(graph->externalIdOf(0) == 0);
+    CHECK(graph->externalIdOf(1) == 1);
+    CHECK(graph->internalIdOf(1) == 1);
+}
+
+TEST_CASE("Triangles reordered along the Hilbert curve should keep their neighbours")
+{
+    // a strip of squares from right to left, the diagonal of each square going from top left to bottom right
+    std::vector<TriangleSkeleton> triangles;
+    for (int i = 7; i >= 0; i--) {
+        triangles.emplace_back(Vector(i, 0.0), Vector(i + 1.0, 0.0), Vector(i, 1.0));
+        triangles.emplace_back(Vector(i + 1.0, 1.0), Vector(i + 1.0, 0.0), Vector(i, 1.0));
+    }
+    auto inputOrderGraph = std::make_shared<TriangleGraph>(triangles);
+    auto reorderedGraph = std::make_shared<TriangleGraph>(triangles, TriangleOrdering::HilbertCurve);
+
+    bool neighboursMatch = true;
+    bool idsRoundTrip = true;
+    for (long externalId = 0; externalId < inputOrderGraph->triangleCount(); externalId++) {
+        auto internalId = reorderedGraph->internalIdOf(externalId);
+        idsRoundTrip &= (reorderedGraph->externalIdOf(internalId) == externalId);
+        std::vector<long> mappedNeighbours;
+        for (auto neighbour : reorderedGraph->neighbourIdsOf(internalId)) {
+            mappedNeighbours.push_back(reorderedGraph->externalIdOf(neighbour));
+        }
+        std::sort(begin(mappedNeighbours), end(mappedNeighbours));
+        neighboursMatch &= (mappedNeighbours == inputOrderGraph->neighbourIdsOf(externalId));
+    }
+
+    CHECK(idsRoundTrip);
+    CHECK(neighboursMatch);
+}
+
+TEST_CASE("Reordered graph should find the triangle under a point")
+{
+    std::vector<TriangleSkeleton> triangles;
+    for (int i = 7; i >= 0; i--) {
+        triangles.emplace_back(Vector(i, 0.0), Vector(i + 1.0, 0.0), Vector(i, 1.0));
+        triangles.emplace_back(Vector(i + 1.0, 1.0), Vector(i + 1.0, 0.0), Vector(i, 1.0));
+    }
+    auto graph = std::make_shared<TriangleGraph>(triangles, TriangleOrdering::HilbertCurve);
+    auto testTriangle = TestTriangle(Vector(6.0, 0.0), Vector(7.0, 0.0), Vector(6.0, 1.0));
+
+    auto triangle = graph->getTriangleUnder(Vector(6.2, 0.2));
+
+    CHECK(testTriangle.matches(triangle));
+    CHECK(graph->externalIdOf(triangle.id()) == 2);
+}
+
+TEST_CASE("Triangles in a square should be neighbours across their shared edge")
+{
+    auto triangles = std::vector<TriangleSkeleton> {
+            TriangleSkeleton(Vector(1.0, 2.0), Vector(3.0, 2.0), Vector(1.0, 4.0)),
+            TriangleSkeleton(Vector(3.0, 4.0), Vector(3.0, 2.0), Vector(1.0, 4.0)),
+    };
+    auto graph = std::make_shared<TriangleGraph>(triangles);
+
+    CHECK(graph->neighbourIdAcross(0, 0) == -1);
+    CHECK(graph->neighbourIdAcross(0, 1) == 1);
+    CHECK(graph->neighbourIdAcross(0, 2) == -1);
+    CHECK(graph->neighbourIdAcross(1, 1) == 0);
+}
+
+TEST_CASE("Raycast should reach an end point lying in the start triangle")
+{
+    auto triangles = std::vector<TriangleSkeleton> {
+            TriangleSkeleton(Vector(1.0, 2.0), Vector(3.0, 2.0), Vector(1.0, 4.0)),
+            TriangleSkeleton(Vector(3.0, 4.0), Vector(3.0, 2.0), Vector(1.0, 4.0)),
+    };
+    auto graph = std::make_shared<TriangleGraph>(triangles);
+
+    auto result = graph->raycast(Vector(1.2, 2.2), Vector(1.5, 2.5));
+
+    CHECK(result.reachedEnd);
+    CHECK(result.lastTriangleId == 0);
+    CHECK(result.visitedTriangleCount == 1);
+    CHECK_FALSE(result.hitEdge.has_value());
+}
+
+TEST_CASE("Raycast should cross the shared edge of a square")
+{
+    auto triangles = std::vector<TriangleSkeleton> {
+            TriangleSkeleton(Vector(1.0, 2.0), Vector(3.0, 2.0), Vector(1.0, 4.0)),
+            TriangleSkeleton(Vector(3.0, 4.0), Vector(3.0, 2.0), Vector(1.0, 4.0)),
+    };
+    auto graph = std::make_shared<TriangleGraph>(triangles);
+
+    auto result = graph->raycast(Vector(1.5, 2.5), Vector(2.5, 3.5));
+
+    CHECK(result.reachedEnd);
+    CHECK(result.lastTriangleId == 1);
+    CHECK(result.visitedTriangleCount == 2);
+}
+
+TEST_CASE("Raycast should report the boundary edge a segment leaves the mesh through")
+{
+    auto triangles = std::vector<TriangleSkeleton> {
+            TriangleSkeleton(Vector(1.0, 2.0), Vector(3.0, 2.0), Vector(1.0, 4.0)),
+            TriangleSkeleton(Vector(3.0, 4.0), Vector(3.0, 2.0), Vector(1.0, 4.0)),
+    };
+    auto graph = std::make_shared<TriangleGraph>(triangles);
+    Edge rightSide(Vector(3.0, 2.0), Vector(3.0, 4.0));
+
+    auto result = graph->raycast(Vector(1.5, 3.0), Vector(5.0, 3.0));
+
+    REQUIRE(result.hitEdge.has_value());
+    REQUIRE(result.hitPoint.has_value());
+    auto hitsRightSide = (*result.hitEdge == rightSide);
+    CHECK_FALSE(result.reachedEnd);
+    CHECK(hitsRightSide);
+    CHECK(result.lastTriangleId == 1);
+    CHECK(result.hitPoint->x() == Approx(3.0));
+    CHECK(result.hitPoint->y() == Approx(3.0));
+}
+
+TEST_CASE("Raycast should walk along a strip of triangles")
+{
+    std::vector<TriangleSkeleton> triangles;
+    for (int i = 0; i < 8; i++) {
+        triangles.emplace_back(Vector(i, 0.0), Vector(i + 1.0, 0.0), Vector(i, 1.0));
+        triangles.emplace_back(Vector(i + 1.0, 1.0), Vector(i + 1.0, 0.0), Vector(i, 1.0));
+    }
+    auto graph = std::make_shared<TriangleGraph>(triangles, TriangleOrdering::HilbertCurve);
+
+    auto result = graph->raycast(Vector(0.2, 0.5), Vector(7.8, 0.5));
+
+    CHECK(result.reachedEnd);
+    CHECK(result.visitedTriangleCount == 16);
+    CHECK(graph->externalIdOf(result.lastTriangleId) == 15);
+}
+
+TEST_CASE("Raycast should not report the end as reached when the walk stalls before it")
+{
+    // the adjacency of the mesh is taken as given, the hypotenuse of the first triangle leads to a triangle far away
+    IndexedMesh mesh;
+    mesh.xs = { 0.0, 1.0, 0.0, 10.0, 11.0, 10.0 };
+    mesh.ys = { 0.0, 0.0, 1.0, 0.0, 0.0, 1.0 };
+    mesh.triangles = { { 0, 1, 2 }, { 3, 4, 5 } };
+    mesh.neighbours = { { -1, 1, -1 }, { -1, 0, -1 } };
+    auto graph = std::make_shared<TriangleGraph>(mesh);
+
+    auto result = graph->raycast(Vector(0.2, 0.2), Vector(0.9, 0.9));
+
+    CHECK_FALSE(result.reachedEnd);
+    CHECK(result.lastTriangleId == 1);
+    CHECK(result.visitedTriangleCount == 2);
+}
+
+TEST_CASE("Raycast should throw exception if it starts from an outlier point")
+{
+    auto triangles = std::vector<TriangleSkeleton> { TriangleSkeleton(Vector(1.0, 2.0), Vector(3.0, 2.0), Vector(1.0, 4.0)) };
+    auto graph = std::make_shared<TriangleGraph>(triangles);
+
+    CHECK_THROWS_WITH(graph->raycast(Vector(0.0, 2.5), Vector(1.5, 2.5)), Catch::Contains("not contained"));
+}
+
+TEST_CASE("Nearest point of a point lying on the mesh should be the point itself")
+{
+    auto triangles = std::vector<TriangleSkeleton> {
+            TriangleSkeleton(Vector(1.0, 2.0), Vector(3.0, 2.0), Vector(1.0, 4.0)),
+            TriangleSkeleton(Vector(3.0, 4.0), Vector(3.0, 2.0), Vector(1.0, 4.0)),
+    };
+    auto graph = std::make_shared<TriangleGraph>(triangles);
+
+    auto nearest = graph->findNearestPoint(Vector(2.5, 3.5), 1.0);
+
+    REQUIRE(nearest.has_value());
+    CHECK(nearest->triangle.id() == 1);
+    CHECK(nearest->point.x() == Approx(2.5));
+    CHECK(nearest->point.y() == Approx(3.5));
+    CHECK(nearest->distance == Approx(0.0));
+}
+
+TEST_CASE("Nearest point of a point slightly off the mesh should lie on the closest boundary edge")
+{
+    auto triangles = std::vector<TriangleSkeleton> {
+            TriangleSkeleton(Vector(1.0, 2.0), Vector(3.0, 2.0), Vector(1.0, 4.0)),
+            TriangleSkeleton(Vector(3.0, 4.0), Vector(3.0, 2.0), Vector(1.0, 4.0)),
+    };
+    auto graph = std::make_shared<TriangleGraph>(triangles);
+    auto testTriangle = TestTriangle(Vector(3.0, 4.0), Vector(3.0, 2.0), Vector(1.0, 4.0));
+
+    auto nearest = graph->findNearestPoint(Vector(3.2, 2.5), 1.0);
+
+    REQUIRE(nearest.has_value());
+    CHECK(testTriangle.matches(nearest->triangle));
+    CHECK(nearest->point.x() == Approx(3.0));
+    CHECK(nearest->point.y() == Approx(2.5));
+    CHECK(nearest->distance == Approx(0.2));
+}
+
+TEST_CASE("Nearest point of a point outside a corner should be the corner")
+{
+    auto triangles = std::vector<TriangleSkeleton> {
+            TriangleSkeleton(Vector(1.0, 2.0), Vector(3.0, 2.0), Vector(1.0, 4.0)),
+            TriangleSkeleton(Vector(3.0, 4.0), Vector(3.0, 2.0), Vector(1.0, 4.0)),
+    };
+    auto graph = std::make_shared<TriangleGraph>(triangles);
+
+    auto nearest = graph->findNearestPoint(Vector(0.0, 1.0), 2.0);
+
+    REQUIRE(nearest.has_value());
+    CHECK(nearest->triangle.id() == 0);
+    CHECK(nearest->point.x() == Approx(1.0));
+    CHECK(nearest->point.y() == Approx(2.0));
+}
+
+TEST_CASE("Nearest point should not be found farther than the specified radius")
+{
+    auto triangles = std::vector<TriangleSkeleton> { TriangleSkeleton(Vector(1.0, 2.0), Vector(3.0, 2.0), Vector(1.0, 4.0)) };
+    auto graph = std::make_shared<TriangleGraph>(triangles);
+
+    auto nearest = graph->findNearestPoint(Vector(0.0, 3.0), 0.5);
+
+    CHECK_FALSE(nearest.has_value());
+}
+
+TEST_CASE("Nearest point should ignore edges shared by neighbouring triangles")
+{
+    std::vector<TriangleSkeleton> triangles;
+    for (int i = 0; i < 8; i++) {
+        triangles.emplace_back(Vector(i, 0.0), Vector(i + 1.0, 0.0), Vector(i, 1.0));
+        triangles.emplace_back(Vector(i + 1.0, 1.0), Vector(i + 1.0, 0.0), Vector(i, 1.0));
+    }
+    auto graph = std::make_shared<TriangleGraph>(triangles);
+
+    auto nearest = graph->findNearestPoint(Vector(3.5, 1.3), 1.0);
+
+    REQUIRE(nearest.has_value());
+    CHECK(nearest->point.x() == Approx(3.5));
+    CHECK(nearest->point.y() == Approx(1.0));
+}
+
+TEST_CASE("Trying to get the triangle under a point should return the triangle under the point")
+{
+    auto triangles = std::vector<TriangleSkeleton> { TriangleSkeleton(Vector(1.0, 2.0), Vector(3.0, 2.0), Vector(1.0, 4.0)) };
+    auto graph = std::make_shared<TriangleGraph>(triangles);
+    auto testTriangle = TestTriangle(Vector(1.0, 4.0), Vector(3.0, 2.0), Vector(1.0, 2.0));
+
+    auto triangle = graph->tryGetTriangleUnder(Vector(1.5, 2.5));
+
+    REQUIRE(triangle.has_value());
+    CHECK(testTriangle.matches(*triangle));
+}
+
+TEST_CASE("Trying to get the triangle under an outlier point should return nothing")
+{
+    auto triangles = std::vector<TriangleSkeleton> { TriangleSkeleton(Vector(1.0, 2.0), Vector(3.0, 2.0), Vector(1.0, 4.0)) };
+    auto graph = std::make_shared<TriangleGraph>(triangles);
+
+    auto triangle = graph->tryGetTriangleUnder(Vector(0.0, 2.5));
+
+    CHECK_FALSE(triangle.has_value());
+    CHECK(graph->findIdOfTriangleUnder(Vector(0.0, 2.5)) == -1);
+}
+
+TEST_CASE("Point on the shared edge of a square should belong to the triangle with the lower id")
+{
+    auto triangles = std::vector<TriangleSkeleton> {
+            TriangleSkeleton(Vector(1.0, 2.0), Vector(3.0, 2.0), Vector(1.0, 4.0)),
+            TriangleSkeleton(Vector(3.0, 4.0), Vector(3.0, 2.0), Vector(1.0, 4.0)),
+    };
+    auto graph = std::make_shared<TriangleGraph>(triangles);
+
+    CHECK(graph->findIdOfTriangleUnder(Vector(2.0, 3.0)) == 0);
+}
+
+TEST_CASE("Trying to get the neighbours of an unknown triangle should return nothing")
+{
+    auto triangles = std::vector<TriangleSkeleton> { TriangleSkeleton(Vector(1.0, 2.0), Vector(3.0, 2.0), Vector(1.0, 4.0)) };
+    auto graph = std::make_shared<TriangleGraph>(triangles);
+    Triangle unknown(1, Vector(1.0, 2.0), Vector(3.0, 2.0), Vector(1.0, 4.0), graph);
+
+    auto neighbours = graph->tryGetNeighbours(unknown);
+
+    CHECK_FALSE(neighbours.has_value());
+    CHECK_THROWS_WITH(graph->getNeighbours(unknown), Catch::Contains("cannot", Catch::CaseSensitive::No));
+}
+
+TEST_CASE("Trying to get the neighbours of a triangle should return its neighbours")
+{
+    auto triangles = std::vector<TriangleSkeleton> {
+            TriangleSkeleton(Vector(1.0, 2.0), Vector(3.0, 2.0), Vector(1.0, 4.0)),
+            TriangleSkeleton(Vector(3.0, 4.0), Vector(3.0, 2.0), Vector(1.0, 4.0)),
+    };
+    auto graph = std::make_shared<TriangleGraph>(triangles);
+    auto startTriangle = graph->getTriangleUnder(Vector(1.5, 2.5));
+
+    auto neighbours = graph->tryGetNeighbours(startTriangle);
+
+    REQUIRE(neighbours.has_value());
+    CHECK(neighbours->size() == 1);
+    CHECK((*neighbours)[0].id() == 1);
+}
+
+TEST_CASE("Cost multipliers should weight the half of the crossing costs inside their triangles")
+{
+    auto triangles = std::vector<TriangleSkeleton> {
+            TriangleSkeleton(Vector(1.0, 2.0), Vector(3.0, 2.0), Vector(1.0, 4.0)),
+            TriangleSkeleton(Vector(3.0, 4.0), Vector(3.0, 2.0), Vector(1.0, 4.0)),
+    };
+    auto graph = std::make_shared<TriangleGraph>(triangles);
+    auto halfCost = graph->crossingCostOf(0, 1) / 2.0;
+
+    graph->setCostMultiplier(0, 3.0);
+
+    CHECK(graph->costMultiplierOf(0) == Approx(3.0));
+    CHECK(graph->crossingCostOf(0, 1) == Approx(4.0 * halfCost));
+    CHECK(graph->crossingCostOf(1, 1) == Approx(4.0 * halfCost));
+    CHECK(graph->costWithin(0, Vector(1.0, 2.0), Vector(2.0, 2.0)) == Approx(3.0));
+    CHECK(graph->minCostMultiplier() == Approx(1.0));
+}
+
+TEST_CASE("The lowest cost multiplier should follow the changes of the multipliers")
+{
+    auto triangles = std::vector<TriangleSkeleton> {
+            TriangleSkeleton(Vector(1.0, 2.0), Vector(3.0, 2.0), Vector(1.0, 4.0)),
+            TriangleSkeleton(Vector(3.0, 4.0), Vector(3.0, 2.0), Vector(1.0, 4.0)),
+    };
+    auto graph = std::make_shared<TriangleGraph>(triangles);
+
+    graph->setCostMultiplier(0, 2.0);
+    graph->setCostMultiplier(1, 4.0);
+    CHECK(graph->minCostMultiplier() == Approx(2.0));
+    graph->setCostMultiplier(0, 0.5);
+    CHECK(graph->minCostMultiplier() == Approx(0.5));
+    graph->setCostMultiplier(0, 8.0);
+    CHECK(graph->minCostMultiplier() == Approx(4.0));
+}
+
+TEST_CASE("Changing a cost multiplier should count as an unblocking")
+{
+    auto triangles = std::vector<TriangleSkeleton> { TriangleSkeleton(Vector(1.0, 2.0), Vector(3.0, 2.0), Vector(1.0, 4.0)) };
+    auto graph = std::make_shared<TriangleGraph>(triangles);
+
+    graph->setCostMultiplier(0, 2.0);
+    CHECK(graph->unblockCount() == 1);
+    graph->setCostMultiplier(0, 1.5);
+    CHECK(graph->unblockCount() == 2);
+    graph->setCostMultiplier(0, 1.5);
+    CHECK(graph->unblockCount() == 2);
+}
+
+TEST_CASE("Setting a cost multiplier that is not positive should throw")
+{
+    auto triangles = std::vector<TriangleSkeleton> { TriangleSkeleton(Vector(1.0, 2.0), Vector(3.0, 2.0), Vector(1.0, 4.0)) };
+    auto graph = std::make_shared<TriangleGraph>(triangles);
+
+    CHECK_THROWS_AS(graph->setCostMultiplier(0, 0.0), std::invalid_argument);
+    CHECK_THROWS_AS(graph->setCostMultiplier(0, -1.0), std::invalid_argument);
+    CHECK_THROWS_AS(graph->setCostMultiplier(0, std::numeric_limits<double>::infinity()), std::invalid_argument);
+    CHECK_THROWS_AS(graph->setCostMultiplier(1, 2.0), std::invalid_argument);
+}
+
+TEST_CASE("Off-mesh links should be visited as steps from their entry triangle and to their exit triangle")
+{
+    auto triangles = std::vector<TriangleSkeleton> {
+            TriangleSkeleton(Vector(0.0, 0.0), Vector(1.0, 0.0), Vector(0.0, 1.0)),
+            TriangleSkeleton(Vector(5.0, 0.0), Vector(6.0, 0.0), Vector(5.0, 1.0)),
+    };
+    auto graph = std::make_shared<TriangleGraph>(triangles);
+
+    auto linkId = graph->addOffMeshLink(Vector(0.2, 0.2), Vector(5.2, 0.2), 2.0);
+
+    auto centroidLeg = Vector(0.2, 0.2).distanceFrom(graph->metadataOf(0).centroid());
+    CHECK(graph->offMeshLinkCount() == 1);
+    CHECK(graph->offMeshLinkOf(linkId).fromId == 0);
+    CHECK(graph->offMeshLinkOf(linkId).toId == 1);
+    CHECK(graph->linkCostOf(linkId) == Approx(2.0 + 2.0 * centroidLeg));
+    CHECK(graph->findOffMeshLink(0, 1) == linkId);
+    CHECK(graph->findOffMeshLink(1, 0) == -1);
+    std::vector<long> stepsFrom;
+    graph->forEachStepFrom(0, [&](long id, double) { stepsFrom.push_back(id); });
+    std::vector<long> stepsTo;
+    graph->forEachStepTo(1, [&](long id, double) { stepsTo.push_back(id); });
+    std::vector<long> stepsBack;
+    graph->forEachStepFrom(1, [&](long id, double) { stepsBack.push_back(id); });
+    CHECK(stepsFrom == std::vector<long> { 1 });
+    CHECK(stepsTo == std::vector<long> { 0 });
+    CHECK(stepsBack.empty());
+}
+
+TEST_CASE("Off-mesh links cheaper than the distance they bridge should lower the cost multiplier of the estimates")
+{
+    auto triangles = std::vector<TriangleSkeleton> {
+            TriangleSkeleton(Vector(0.0, 0.0), Vector(1.0, 0.0), Vector(0.0, 1.0)),
+            TriangleSkeleton(Vector(5.0, 0.0), Vector(6.0, 0.0), Vector(5.0, 1.0)),
+    };
+    auto graph = std::make_shared<TriangleGraph>(triangles);
+
+    graph->addOffMeshLink(Vector(0.2, 0.2), Vector(5.2, 0.2), 10.0);
+    CHECK(graph->minCostMultiplier() == Approx(1.0));
+    graph->addOffMeshLink(Vector(5.2, 0.2), Vector(0.2, 0.2), 1.0);
+    CHECK(graph->minCostMultiplier() == Approx(0.2));
+}
+
+TEST_CASE("Adding an off-mesh link off the mesh or with a negative cost should throw")
+{
+    auto triangles = std::vector<TriangleSkeleton> { TriangleSkeleton(Vector(0.0, 0.0), Vector(1.0, 0.0), Vector(0.0, 1.0)) };
+    auto graph = std::make_shared<TriangleGraph>(triangles);
+
+    CHECK_THROWS_WITH(graph->addOffMeshLink(Vector(2.0, 2.0), Vector(0.2, 0.2), 1.0), Catch::Contains("entry point"));
+    CHECK_THROWS_WITH(graph->addOffMeshLink(Vector(0.2, 0.2), Vector(2.0, 2.0), 1.0), Catch::Contains("exit point"));
+    CHECK_THROWS_AS(graph->addOffMeshLink(Vector(0.2, 0.2), Vector(0.3, 0.3), -1.0), std::invalid_argument);
+}
+
+// two floors of a 10 by 10 room above each other, 3 units apart
+static IndexedMesh twoStoreyMesh()
+{
+    IndexedMesh mesh;
+    mesh.xs = { 0.0, 10.0, 10.0, 0.0, 0.0, 10.0, 10.0, 0.0 };
+    mesh.ys = { 0.0, 0.0, 10.0, 10.0, 0.0, 0.0, 10.0, 10.0 };
+    mesh.heights = { 0.0, 0.0, 0.0, 0.0, 3.0, 3.0, 3.0, 3.0 };
+    mesh.triangles = { { 0, 1, 2 }, { 0, 2, 3 }, { 4, 5, 6 }, { 4, 6, 7 } };
+    mesh.layers = { 0, 0, 1, 1 };
+    return mesh;
+}
+
+TEST_CASE("Point location should pick the floor vertically nearest to the height")
+{
+    for (auto ordering : { TriangleOrdering::InputOrder, TriangleOrdering::HilbertCurve }) {
+        auto graph = std::make_shared<TriangleGraph>(twoStoreyMesh(), ordering);
+        Vector point(7.0, 2.0);
+
+        auto lowerId = graph->findIdOfTriangleUnder(point, 0.2);
+        auto upperId = graph->findIdOfTriangleUnder(point, 2.9);
+
+        CHECK(graph->layerCount() == 2);
+        REQUIRE(lowerId >= 0);
+        REQUIRE(upperId >= 0);
+        CHECK(graph->layerOf(lowerId) == 0);
+        CHECK(graph->layerOf(upperId) == 1);
+        CHECK(graph->heightAt(upperId, point) == Approx(3.0));
+        CHECK(graph->findIdOfTriangleUnderOnLayer(point, 1) == upperId);
+        CHECK(graph->findIdOfTriangleUnderOnLayer(point, 2) == -1);
+        CHECK(graph->findIdOfTriangleUnder(Vector(12.0, 2.0), 0.0) == -1);
+        CHECK(graph->neighbourIdsOf(lowerId).size() == 1);
+        CHECK(graph->layerOf(graph->neighbourIdsOf(lowerId)[0]) == 0);
+    }
+}
+
+TEST_CASE("Off-mesh links should connect the floors above each other they were added between")
+{
+    auto graph = std::make_shared<TriangleGraph>(twoStoreyMesh());
+    Vector entry(1.0, 2.0);
+    Vector exit(9.0, 2.0);
+    auto lowerId = graph->findIdOfTriangleUnder(entry, 0.0);
+    auto upperId = graph->findIdOfTriangleUnder(exit, 3.0);
+
+    auto linkId = graph->addOffMeshLink(lowerId, entry, upperId, exit, 4.0);
+
+    CHECK(graph->offMeshLinkOf(linkId).fromId == lowerId);
+    CHECK(graph->offMeshLinkOf(linkId).toId == upperId);
+    CHECK(graph->layerOf(graph->offMeshLinkOf(linkId).toId) == 1);
+    CHECK(graph->findOffMeshLink(lowerId, upperId) == linkId);
+    CHECK_THROWS_AS(graph->addOffMeshLink(lowerId, exit, upperId, exit, 4.0), std::invalid_argument);
+    CHECK_THROWS_AS(graph->addOffMeshLink(lowerId, entry, graph->triangleCount(), exit, 4.0), std::invalid_argument);
+}
+
+TEST_CASE("Raycasts and nearest points should keep to the specified floor")
+{
+    auto graph = std::make_shared<TriangleGraph>(twoStoreyMesh());
+    auto upperId = graph->findIdOfTriangleUnder(Vector(7.0, 2.0), 3.0);
+
+    auto ray = graph->raycast(upperId, Vector(7.0, 2.0), Vector(2.0, 7.0));
+    auto nearest = graph->findNearestPoint(Vector(12.0, 5.0), 3.0, 1);
+
+    CHECK(ray.reachedEnd);
+    CHECK(graph->layerOf(ray.lastTriangleId) == 1);
+    REQUIRE(nearest);
+    CHECK(graph->layerOf(nearest->triangle.id()) == 1);
+    CHECK(nearest->distance == Approx(2.0));
+    CHECK_THROWS_AS(graph->raycast(upperId, Vector(2.0, 7.0), Vector(7.0, 2.0)), std::invalid_argument);
+    CHECK_THROWS_AS(graph->findNearestPoint(Vector(12.0, 5.0), 3.0, 2), std::invalid_argument);
+}
+
+TEST_CASE("Height sampling should interpolate between the heights of the corners")
+{
+    IndexedMesh mesh;
+    mesh.xs = { 0.0, 4.0, 0.0 };
+    mesh.ys = { 0.0, 0.0, 4.0 };
+    // on the plane of height x + 2y
+    mesh.heights = { 0.0, 4.0, 8.0 };
+    mesh.triangles = { { 0, 1, 2 } };
+    auto graph = std::make_shared<TriangleGraph>(mesh);
+    auto flat = std::make_shared<TriangleGraph>(std::vector<TriangleSkeleton> {
+            TriangleSkeleton(Vector(0.0, 0.0), Vector(4.0, 0.0), Vector(0.0, 4.0)) });
+
+    CHECK(graph->heightAt(0, Vector(1.0, 1.0)) == Approx(3.0));
+    CHECK(graph->heightAt(0, Vector(4.0, 0.0)) == Approx(4.0));
+    CHECK(graph->heightAt(0, Vector(0.5, 2.5)) == Approx(5.5));
+    CHECK(graph->layerCount() == 1);
+    CHECK(flat->heightAt(0, Vector(1.0, 1.0)) == 0.0);
+}
+
+TEST_CASE("Building a graph from a mesh with heights or layers missing for some vertices or triangles should throw")
+{
+    auto fewerHeights = twoStoreyMesh();
+    fewerHeights.heights.pop_back();
+    auto fewerLayers = twoStoreyMesh();
+    fewerLayers.layers.pop_back();
+    auto negativeLayer = twoStoreyMesh();
+    negativeLayer.layers[0] = -1;
+
+    CHECK_THROWS_AS(TriangleGraph(fewerHeights), std::invalid_argument);
+    CHECK_THROWS_AS(TriangleGraph(fewerLayers), std::invalid_argument);
+    CHECK_THROWS_AS(TriangleGraph(negativeLayer), std::invalid_argument);
+}
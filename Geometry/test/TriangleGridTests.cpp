@@ -0,0 +1,89 @@
+/**
+ * Copyright 2019 Márton Gergó
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "catch.hpp"
+#include "TriangleGrid.h"
+#include <set>
+
+using namespace TpaStarCpp::GeometryLibrary;
+
+static std::vector<TriangleMetadata> metadataOfStrip(int squareCount)
+{
+    std::vector<TriangleMetadata> metadata;
+    for (int i = 0; i < squareCount; i++) {
+        metadata.push_back(TriangleMetadata::of(TriangleSkeleton(Vector(i, 0.0), Vector(i + 1.0, 0.0), Vector(i, 1.0))));
+        metadata.push_back(TriangleMetadata::of(TriangleSkeleton(Vector(i + 1.0, 1.0), Vector(i + 1.0, 0.0), Vector(i, 1.0))));
+    }
+    return metadata;
+}
+
+TEST_CASE("Empty triangle grid should not find any triangle")
+{
+    TriangleGrid grid(std::vector<TriangleMetadata> {});
+
+    auto id = grid.findTriangleAt(1.0, 1.0, [](long) { return true; });
+
+    CHECK(id == -1);
+}
+
+TEST_CASE("Triangle grid should list the triangles overlapping the cell of a point")
+{
+    auto metadata = metadataOfStrip(16);
+    TriangleGrid grid(metadata);
+
+    std::set<long> candidates;
+    grid.findTriangleAt(5.5, 0.5, [&](long id) { candidates.insert(id); return false; });
+
+    CHECK(candidates.count(10) == 1);
+    CHECK(candidates.count(11) == 1);
+    CHECK(candidates.count(30) == 0);
+}
+
+TEST_CASE("Triangle grid should return the first triangle accepted by the predicate")
+{
+    auto metadata = metadataOfStrip(16);
+    TriangleGrid grid(metadata);
+
+    auto id = grid.findTriangleAt(5.5, 0.5, [](long id) { return id == 11; });
+
+    CHECK(id == 11);
+}
+
+TEST_CASE("Triangle grid should clamp points outside of its bounds to the border cells")
+{
+    auto metadata = metadataOfStrip(16);
+    TriangleGrid grid(metadata);
+
+    std::set<long> candidates;
+    grid.findTriangleAt(100.0, -100.0, [&](long id) { candidates.insert(id); return false; });
+
+    CHECK(candidates.count(31) == 1);
+}
+
+TEST_CASE("Triangle grid should visit every triangle overlapping a box")
+{
+    auto metadata = metadataOfStrip(16);
+    TriangleGrid grid(metadata);
+
+    std::set<long> visited;
+    grid.forEachTriangleOverlapping(3.5, 0.2, 6.5, 0.8, [&](long id) { visited.insert(id); });
+
+    for (long id = 6; id <= 13; id++) {
+        CHECK(visited.count(id) == 1);
+    }
+    CHECK(visited.count(0) == 0);
+    CHECK(visited.count(31) == 0);
+}
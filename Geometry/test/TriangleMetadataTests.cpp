@@ -0,0 +1,78 @@
+/**
+ * Copyright 2019 Márton Gergó
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "catch.hpp"
+#include "TriangleMetadata.h"
+
+using namespace TpaStarCpp::GeometryLibrary;
+
+TEST_CASE("Triangle metadata should store the centroid of the triangle")
+{
+    TriangleSkeleton triangle(Vector(0.0, 0.0), Vector(3.0, 0.0), Vector(0.0, 3.0));
+
+    auto metadata = TriangleMetadata::of(triangle);
+
+    CHECK(metadata.centroidX == Approx(1.0));
+    CHECK(metadata.centroidY == Approx(1.0));
+}
+
+TEST_CASE("Triangle metadata should store the bounding box of the triangle")
+{
+    TriangleSkeleton triangle(Vector(1.0, 4.0), Vector(3.0, 2.0), Vector(-1.0, 3.0));
+
+    auto metadata = TriangleMetadata::of(triangle);
+
+    CHECK(metadata.minX == Approx(-1.0));
+    CHECK(metadata.minY == Approx(2.0));
+    CHECK(metadata.maxX == Approx(3.0));
+    CHECK(metadata.maxY == Approx(4.0));
+}
+
+TEST_CASE("Triangle metadata area should be independent from corner definition direction")
+{
+    TriangleSkeleton clockwise(Vector(0.0, 0.0), Vector(0.0, 2.0), Vector(4.0, 0.0));
+    TriangleSkeleton counterClockwise(Vector(0.0, 0.0), Vector(4.0, 0.0), Vector(0.0, 2.0));
+
+    CHECK(TriangleMetadata::of(clockwise).area == Approx(4.0));
+    CHECK(TriangleMetadata::of(counterClockwise).area == Approx(4.0));
+}
+
+TEST_CASE("Triangle metadata should store edge lengths and midpoints in corner order")
+{
+    TriangleSkeleton triangle(Vector(0.0, 0.0), Vector(4.0, 0.0), Vector(0.0, 3.0));
+
+    auto metadata = TriangleMetadata::of(triangle);
+
+    CHECK(metadata.edgeLengths[0] == Approx(4.0));
+    CHECK(metadata.edgeLengths[1] == Approx(5.0));
+    CHECK(metadata.edgeLengths[2] == Approx(3.0));
+    CHECK(metadata.edgeMidpoint(0).x() == Approx(2.0));
+    CHECK(metadata.edgeMidpoint(0).y() == Approx(0.0));
+    CHECK(metadata.edgeMidpoint(1).x() == Approx(2.0));
+    CHECK(metadata.edgeMidpoint(1).y() == Approx(1.5));
+    CHECK(metadata.edgeMidpoint(2).x() == Approx(0.0));
+    CHECK(metadata.edgeMidpoint(2).y() == Approx(1.5));
+}
+
+TEST_CASE("Bounding box of triangle metadata should contain points on its border")
+{
+    TriangleSkeleton triangle(Vector(0.0, 0.0), Vector(4.0, 0.0), Vector(0.0, 3.0));
+
+    auto metadata = TriangleMetadata::of(triangle);
+
+    CHECK(metadata.boundingBoxContains(Vector(4.0, 3.0)));
+    CHECK_FALSE(metadata.boundingBoxContains(Vector(4.1, 3.0)));
+}
@@ -0,0 +1,174 @@
+/**
+ * Copyright 2019 Márton Gergó
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "catch.hpp"
+#include "TriangleSearch.h"
+#include "DistanceField.h"
+#include "MeshGenerator.h"
+#include "TriangleSkeleton.h"
+#include "Vector.h"
+
+using namespace TpaStarCpp::GeometryLibrary;
+
+static bool isConnected(std::shared_ptr<TriangleGraph> graph, const std::vector<long>& triangleIds)
+{
+    for (long i = 1; i < triangleIds.size(); i++) {
+        auto& neighbours = graph->neighbourIdsOf(triangleIds[i - 1]);
+        if (std::find(begin(neighbours), end(neighbours), triangleIds[i]) == end(neighbours)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// a wall through the whole grid, only the link leads over it
+static std::shared_ptr<TriangleGraph> buildWalledGrid()
+{
+    auto graph = std::make_shared<TriangleGraph>(MeshGenerator(1).gridWithHoles(10, 10, 0.0));
+    for (int y = 0; y < 10; y++) {
+        graph->setBlocked(graph->findIdOfTriangleUnder(Vector(5.2, y + 0.5)), true);
+        graph->setBlocked(graph->findIdOfTriangleUnder(Vector(5.8, y + 0.5)), true);
+    }
+    graph->addOffMeshLink(Vector(4.5, 8.5), Vector(6.5, 8.5), 1.0);
+    return graph;
+}
+
+TEST_CASE("Triangle search should return the distance of points in the same triangle")
+{
+    auto graph = std::make_shared<TriangleGraph>(MeshGenerator(1).gridWithHoles(4, 4, 0.0));
+    TriangleSearch search(graph);
+
+    auto result = search.findPath(Vector(1.6, 1.2), Vector(1.9, 1.6));
+
+    CHECK(result.isFound);
+    CHECK(result.triangleIds.size() == 1);
+    CHECK(result.cost == Approx(0.5));
+}
+
+TEST_CASE("Triangle search should find a connected path from the start to the goal triangle")
+{
+    auto graph = std::make_shared<TriangleGraph>(MeshGenerator(1).randomDelaunay(20, 20));
+    TriangleSearch search(graph);
+
+    auto result = search.findPath(Vector(0.5, 0.5), Vector(19.5, 19.5));
+
+    REQUIRE(result.isFound);
+    CHECK(result.triangleIds.front() == graph->findIdOfTriangleUnder(Vector(0.5, 0.5)));
+    CHECK(result.triangleIds.back() == graph->findIdOfTriangleUnder(Vector(19.5, 19.5)));
+    CHECK(isConnected(graph, result.triangleIds));
+    CHECK(result.cost >= Vector(0.5, 0.5).distanceFrom(Vector(19.5, 19.5)));
+    CHECK(result.cost < 1.4 * Vector(0.5, 0.5).distanceFrom(Vector(19.5, 19.5)));
+}
+
+TEST_CASE("Triangle search should go around blocked triangles")
+{
+    auto graph = std::make_shared<TriangleGraph>(MeshGenerator(1).gridWithHoles(10, 10, 0.0));
+    TriangleSearch search(graph);
+    auto direct = search.findPath(Vector(0.5, 5.5), Vector(9.5, 5.5));
+    for (int y = 1; y < 10; y++) {
+        graph->setBlocked(graph->findIdOfTriangleUnder(Vector(5.2, y + 0.5)), true);
+        graph->setBlocked(graph->findIdOfTriangleUnder(Vector(5.8, y + 0.5)), true);
+    }
+
+    auto detour = search.findPath(Vector(0.5, 5.5), Vector(9.5, 5.5));
+
+    REQUIRE(detour.isFound);
+    bool avoidsBlocked = true;
+    for (auto id : detour.triangleIds) {
+        avoidsBlocked &= !graph->isBlocked(id);
+    }
+    CHECK(avoidsBlocked);
+    CHECK(detour.cost > direct.cost + 5.0);
+}
+
+TEST_CASE("Triangle search should go around expensive triangles")
+{
+    auto graph = std::make_shared<TriangleGraph>(MeshGenerator(1).gridWithHoles(10, 10, 0.0));
+    TriangleSearch search(graph);
+    auto direct = search.findPath(Vector(0.5, 5.5), Vector(9.5, 5.5));
+    for (int y = 1; y < 10; y++) {
+        graph->setCostMultiplier(graph->findIdOfTriangleUnder(Vector(5.2, y + 0.5)), 20.0);
+        graph->setCostMultiplier(graph->findIdOfTriangleUnder(Vector(5.8, y + 0.5)), 20.0);
+    }
+
+    auto detour = search.findPath(Vector(0.5, 5.5), Vector(9.5, 5.5));
+
+    REQUIRE(detour.isFound);
+    bool avoidsExpensive = true;
+    for (auto id : detour.triangleIds) {
+        avoidsExpensive &= graph->costMultiplierOf(id) == 1.0;
+    }
+    CHECK(avoidsExpensive);
+    CHECK(detour.cost > direct.cost + 5.0);
+}
+
+TEST_CASE("Triangle search should find the cheapest path when every triangle is cheaper than the distance")
+{
+    auto graph = std::make_shared<TriangleGraph>(MeshGenerator(2).randomDelaunay(20, 20));
+    for (long id = 0; id < graph->triangleCount(); id++) {
+        graph->setCostMultiplier(id, (id % 7 == 0) ? 3.0 : 0.5);
+    }
+    TriangleSearch search(graph);
+    Vector start(0.5, 0.5);
+    Vector goal(19.5, 19.5);
+    DistanceField field(graph, start);
+    auto goalId = graph->findIdOfTriangleUnder(goal);
+
+    auto result = search.findPath(start, goal);
+
+    REQUIRE(result.isFound);
+    CHECK(result.cost == Approx(field.distanceOf(goalId) + graph->costWithin(goalId, graph->metadataOf(goalId).centroid(), goal)));
+}
+
+TEST_CASE("Triangle search should take off-mesh links in their direction only")
+{
+    auto graph = buildWalledGrid();
+    TriangleSearch search(graph);
+    Vector start(0.5, 0.5);
+    Vector goal(9.5, 0.5);
+    auto linkId = graph->findOffMeshLink(graph->findIdOfTriangleUnder(Vector(4.5, 8.5)), graph->findIdOfTriangleUnder(Vector(6.5, 8.5)));
+    DistanceField field(graph, goal);
+    auto startId = graph->findIdOfTriangleUnder(start);
+
+    auto result = search.findPath(start, goal);
+    auto back = search.findPath(goal, start);
+
+    REQUIRE(result.isFound);
+    CHECK(result.cost == Approx(graph->costWithin(startId, start, graph->metadataOf(startId).centroid()) + field.distanceOf(startId)));
+    CHECK(result.cost > graph->linkCostOf(linkId) + 10.0);
+    CHECK_FALSE(back.isFound);
+}
+
+TEST_CASE("Triangle search should report goals cut off by blocked triangles as not found")
+{
+    auto graph = std::make_shared<TriangleGraph>(MeshGenerator(1).gridWithHoles(10, 1, 0.0));
+    TriangleSearch search(graph);
+    graph->setBlocked(graph->findIdOfTriangleUnder(Vector(5.2, 0.5)), true);
+    graph->setBlocked(graph->findIdOfTriangleUnder(Vector(5.8, 0.5)), true);
+
+    auto result = search.findPath(Vector(0.5, 0.5), Vector(9.5, 0.5));
+
+    CHECK_FALSE(result.isFound);
+    CHECK(result.expandedCount > 0);
+}
+
+TEST_CASE("Triangle search should not accept a start point off the mesh")
+{
+    auto graph = std::make_shared<TriangleGraph>(MeshGenerator(1).gridWithHoles(4, 4, 0.0));
+    TriangleSearch search(graph);
+
+    CHECK_THROWS_WITH(search.findPath(Vector(-1.0, 1.0), Vector(1.0, 1.0)), Catch::Contains("start point"));
+}